@@ -29,25 +29,52 @@ INCLUDEPATH = ../src/ /usr/include/bullet
 #A list of filenames of header (.h) files used when building the project.
 HEADERS += \
     #3D
+    ../src/3D/assetLoader.h \
+    ../src/3D/bounds.h \
+    ../src/3D/boundsTree.h \
+    ../src/3D/frustum.h \
+    ../src/3D/glState.h \
+    ../src/3D/mesh.h \
+    ../src/3D/meshCache.h \
     ../src/3D/modelLoader.h \
     ../src/3D/renderable.h \
+    ../src/3D/renderQueue.h \
+    ../src/3D/resourceCache.h \
+    ../src/3D/textureCache.h \
     ../src/3D/transform3d.h \
     ../src/3D/colorVertex.h \
     ../src/3D/uvVertex.h \
     #Controls
+    ../src/Controls/benchmark.h \
     ../src/Controls/camera3d.h \
+    ../src/Controls/fixedTimestep.h \
     ../src/Controls/input.h \
+    ../src/Controls/jobSystem.h \
+    ../src/Controls/profiler.h \
     ../src/Controls/time.h \
     #Entity
     ../src/Entity/colorEntity.h \
     ../src/Entity/colorPhysicsEntity.h \
+    ../src/Entity/physicsState.h \
     ../src/Entity/uvEntity.h \
     ../src/Entity/uvPhysicsEntity.h \
     #Maze
     ../src/Maze/cell.h \
+    ../src/Maze/cellBatch.h \
+    ../src/Maze/distanceField.h \
+    ../src/Maze/game.h \
+    ../src/Maze/greedyMesher.h \
+    ../src/Maze/hintPath.h \
     ../src/Maze/labyrinth.h \
+    ../src/Maze/labyrinthCollision.h \
+    ../src/Maze/labyrinthTile.h \
     ../src/Maze/mazeGenerator.h \
+    ../src/Maze/mazeGrid.h \
+    ../src/Maze/potentiallyVisibleSet.h \
+    ../src/Maze/random.h \
+    ../src/Maze/streamingLabyrinth.h \
     ../src/Maze/ball.h \
+    ../src/Maze/ballController.h \
     ../src/Maze/wall.h \
     #UI
     ../src/UI/mainWindow.h \
@@ -58,24 +85,50 @@ HEADERS += \
 #A list of source code files to be used when building the project.
 SOURCES += \
     #3D
+    ../src/3D/assetLoader.cpp \
+    ../src/3D/bounds.cpp \
+    ../src/3D/boundsTree.cpp \
+    ../src/3D/frustum.cpp \
+    ../src/3D/glState.cpp \
+    ../src/3D/meshCache.cpp \
     ../src/3D/modelLoader.cpp \
+    ../src/3D/renderQueue.cpp \
+    ../src/3D/resourceCache.cpp \
+    ../src/3D/textureCache.cpp \
     ../src/3D/transform3d.cpp \
     ../src/3D/colorVertex.cpp \
     ../src/3D/uvVertex.cpp \
     #Controls
+    ../src/Controls/benchmark.cpp \
     ../src/Controls/camera3d.cpp \
+    ../src/Controls/fixedTimestep.cpp \
     ../src/Controls/input.cpp \
+    ../src/Controls/jobSystem.cpp \
+    ../src/Controls/profiler.cpp \
     ../src/Controls/time.cpp \
     #Entity
     ../src/Entity/colorEntity.cpp \
     ../src/Entity/colorPhysicsEntity.cpp \
+    ../src/Entity/physicsState.cpp \
     ../src/Entity/uvEntity.cpp \
     ../src/Entity/uvPhysicsEntity.cpp \
     #Maze
     ../src/Maze/cell.cpp \
+    ../src/Maze/cellBatch.cpp \
+    ../src/Maze/distanceField.cpp \
+    ../src/Maze/game.cpp \
+    ../src/Maze/greedyMesher.cpp \
+    ../src/Maze/hintPath.cpp \
     ../src/Maze/labyrinth.cpp \
+    ../src/Maze/labyrinthCollision.cpp \
+    ../src/Maze/labyrinthTile.cpp \
     ../src/Maze/mazeGenerator.cpp \
-    ../src/Maze/ball.cpp \    
+    ../src/Maze/mazeGrid.cpp \
+    ../src/Maze/potentiallyVisibleSet.cpp \
+    ../src/Maze/random.cpp \
+    ../src/Maze/streamingLabyrinth.cpp \
+    ../src/Maze/ball.cpp \
+    ../src/Maze/ballController.cpp \
     ../src/Maze/wall.cpp \
     #UI
     ../src/UI/mainWindow.cpp \
@@ -0,0 +1,42 @@
+#The type to build (application, library, subdirectories)
+TEMPLATE = app  
+
+#Directory of the executable / binary file
+DESTDIR = ../../bin/
+
+#The name of the app / library
+TARGET = MeshBaker.exe
+
+#QT libraries this project uses
+QT += core gui
+CONFIG += console
+
+#Any external libraries this build uses
+LIBS += -lassimp -lBulletDynamics -lBulletCollision -lLinearMath
+
+#General project configuration options.
+CONFIG += warn_on c++11
+
+#Compiler flags
+QMAKE_CXXFLAGS_WARD_ON += -Wall -pedantic
+
+#Specifies the #include directories which should be searched when compiling the project.
+INCLUDEPATH = ../../src/ /usr/include/bullet
+
+#A list of filenames of header (.h) files used when building the project.
+HEADERS += \
+    ../../src/3D/bounds.h \
+    ../../src/3D/mesh.h \
+    ../../src/3D/meshCache.h \
+    ../../src/3D/modelLoader.h \
+    ../../src/3D/colorVertex.h \
+    ../../src/3D/uvVertex.h
+
+#A list of source code files to be used when building the project.
+SOURCES += \
+    ../../src/3D/bounds.cpp \
+    ../../src/3D/meshCache.cpp \
+    ../../src/3D/modelLoader.cpp \
+    ../../src/3D/colorVertex.cpp \
+    ../../src/3D/uvVertex.cpp \
+    ../../src/Tools/meshBaker.cpp
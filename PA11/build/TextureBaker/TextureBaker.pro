@@ -0,0 +1,30 @@
+#The type to build (application, library, subdirectories)
+TEMPLATE = app  
+
+#Directory of the executable / binary file
+DESTDIR = ../../bin/
+
+#The name of the app / library
+TARGET = TextureBaker.exe
+
+#QT libraries this project uses
+QT += core gui
+CONFIG += console
+
+#General project configuration options.
+CONFIG += warn_on c++11
+
+#Compiler flags
+QMAKE_CXXFLAGS_WARD_ON += -Wall -pedantic
+
+#Specifies the #include directories which should be searched when compiling the project.
+INCLUDEPATH = ../../src/
+
+#A list of filenames of header (.h) files used when building the project.
+HEADERS += \
+    ../../src/3D/textureCache.h
+
+#A list of source code files to be used when building the project.
+SOURCES += \
+    ../../src/3D/textureCache.cpp \
+    ../../src/Tools/textureBaker.cpp
@@ -0,0 +1,63 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+
+#include <functional>
+#include <vector>
+
+#include "3D/resourceCache.h"
+#include "Controls/jobSystem.h"
+
+/**
+ * @brief      Decodes models and textures into the ResourceCache as jobs on
+ * the JobSystem.
+ * @details    Assets are queued with the add functions and decoded in parallel
+ * once start is called. The loader keeps a handle to everything it decoded,
+ * so the cache entries stay alive until the loader is destroyed; by then the
+ * scene should hold its own handles and have uploaded what it needs to the
+ * GPU on the GUI thread.
+ */
+class AssetLoader   :   public QObject
+{
+    Q_OBJECT
+
+public:
+    AssetLoader( QObject* parent = NULL );
+    ~AssetLoader();
+
+    void addUVModel( const QString& modelPath );
+    void addColorModel( const QString& modelPath );
+    void addTexture( const QString& imagePath,
+        const TextureCache::Region& region = TextureCache::Region() );
+
+    void start();
+    int total() const;
+
+signals:
+    void progress( int loaded, int total );
+    void finished();
+
+private slots:
+    void assetLoaded();
+
+private:
+    template <typename T>
+    void keep( const QSharedPointer<T>& asset, QList< QSharedPointer<T> >& list );
+
+    std::vector< std::function<void()> > m_queued;
+    std::vector< JobSystem::Handle > m_jobs;
+    int m_loaded, m_total;
+
+    // Handles to every decoded asset, appended to from the jobs
+    QMutex m_mutex;
+    QList< QSharedPointer<UVMesh> > m_uvMeshes;
+    QList< QSharedPointer<ColorMesh> > m_colorMeshes;
+    QList< QSharedPointer<TextureCache::MipChain> > m_mipChains;
+};
+
+#endif  //  ASSET_LOADER_H
@@ -0,0 +1,163 @@
+#include "boundsTree.h"
+
+#include <algorithm>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for an empty BoundsTree.
+ */
+BoundsTree::BoundsTree()
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Builds the tree over a set of boxes, replacing any it had.
+ *
+ * @param[in]  bounds  The boxes, found again by their index in a query.
+ */
+void BoundsTree::build( const std::vector<Bounds>& bounds )
+{
+    clear();
+    if( bounds.empty() )
+        return;
+
+    m_bounds = bounds;
+    m_items.resize( bounds.size() );
+    for( unsigned i = 0; i < bounds.size(); i++ )
+        m_items[i] = i;
+
+    // A binary tree with leaves of at least one box has fewer than 2n nodes
+    m_nodes.reserve( 2 * bounds.size() );
+    buildNode( bounds, 0, bounds.size() );
+}
+
+/**
+ * @brief      Removes every box from the tree.
+ */
+void BoundsTree::clear()
+{
+    m_nodes.clear();
+    m_items.clear();
+    m_bounds.clear();
+}
+
+/**
+ * @brief      Gets the number of boxes in the tree.
+ *
+ * @return     The number of boxes.
+ */
+int BoundsTree::size() const
+{
+    return m_items.size();
+}
+
+/**
+ * @brief      Finds every box that may be in view.
+ *
+ * @param[in]  frustum  The view volume.
+ * @param      visible  The indices of the boxes in view are added to it.
+ */
+void BoundsTree::query( const Frustum& frustum, std::vector<int>& visible )
+    const
+{
+    if( !m_nodes.empty() )
+        queryNode( 0, frustum, false, visible );
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Builds the node over a range of the items, splitting it at the
+ *             median of the boxes' centers along the longest axis.
+ *
+ * @param[in]  bounds  Every box of the tree.
+ * @param[in]  first   The first item under the node.
+ * @param[in]  count   The number of items under the node.
+ *
+ * @return     The index of the node.
+ */
+int BoundsTree::buildNode( const std::vector<Bounds>& bounds, int first,
+    int count )
+{
+    const int index = m_nodes.size();
+    m_nodes.push_back( Node() );
+
+    Node node;
+    node.Left = -1;
+    node.Right = -1;
+    node.First = first;
+    node.Count = count;
+
+    Bounds centers;
+    for( int i = first; i < first + count; i++ )
+    {
+        node.Box.expand( bounds[ m_items[i] ] );
+        centers.expand( bounds[ m_items[i] ].center() );
+    }
+
+    if( count > LEAF_SIZE )
+    {
+        const QVector3D size = centers.Max - centers.Min;
+        int axis = 0;
+        if( size.y() > size[axis] )
+            axis = 1;
+        if( size.z() > size[axis] )
+            axis = 2;
+
+        const int half = count / 2;
+        std::nth_element( m_items.begin() + first,
+            m_items.begin() + first + half, m_items.begin() + first + count,
+            [&bounds, axis]( int a, int b ){
+                return bounds[a].center()[axis] < bounds[b].center()[axis];
+            } );
+
+        node.Left = buildNode( bounds, first, half );
+        node.Right = buildNode( bounds, first + half, count - half );
+    }
+
+    m_nodes[index] = node;
+    return index;
+}
+
+/**
+ * @brief      Adds the boxes under a node that may be in view.
+ *
+ * @param[in]  node     The node to search.
+ * @param[in]  frustum  The view volume.
+ * @param[in]  inside   True if a parent is already known to be in view.
+ * @param      visible  The indices of the boxes in view are added to it.
+ */
+void BoundsTree::queryNode( int node, const Frustum& frustum, bool inside,
+    std::vector<int>& visible ) const
+{
+    const Node& current = m_nodes[node];
+    if( !inside )
+    {
+        const Frustum::Result result = frustum.classify( current.Box );
+        if( result == Frustum::Outside )
+            return;
+        inside = result == Frustum::Inside;
+    }
+
+    if( current.Left < 0 )
+    {
+        for( int i = current.First; i < current.First + current.Count; i++ )
+        {
+            if( inside || frustum.intersects( m_bounds[ m_items[i] ] ) )
+                visible.push_back( m_items[i] );
+        }
+        return;
+    }
+
+    queryNode( current.Left, frustum, inside, visible );
+    queryNode( current.Right, frustum, inside, visible );
+}
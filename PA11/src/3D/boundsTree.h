@@ -0,0 +1,54 @@
+#ifndef BOUNDS_TREE_H
+#define BOUNDS_TREE_H
+
+#include <vector>
+
+#include "bounds.h"
+#include "frustum.h"
+
+/**
+ * @brief      Bounding volume hierarchy over a set of static boxes.
+ * @details    The boxes are split in half along their longest axis until a few
+ * are left in each leaf. A query walks down from the root, skipping whole
+ * branches outside the frustum and taking whole branches inside it, so only
+ * the boxes near the edges of the view are tested one by one.
+ *
+ * The tree hands back the indices of the boxes it was built with, it is up to
+ * its owner to map them to what they bound.
+ */
+class BoundsTree
+{
+public:
+    BoundsTree();
+
+    void build( const std::vector<Bounds>& bounds );
+    void clear();
+    int size() const;
+
+    void query( const Frustum& frustum, std::vector<int>& visible ) const;
+
+private:
+    struct Node
+    {
+        Bounds Box;
+
+        // Children of a branch, -1 for a leaf
+        int Left, Right;
+
+        // Range of m_items under the node
+        int First, Count;
+    };
+
+    int buildNode( const std::vector<Bounds>& bounds, int first, int count );
+    void queryNode( int node, const Frustum& frustum, bool inside,
+        std::vector<int>& visible ) const;
+
+    // Boxes per leaf, past which a node is split
+    const int LEAF_SIZE = 4;
+
+    std::vector<Node> m_nodes;
+    std::vector<int> m_items;
+    std::vector<Bounds> m_bounds;
+};
+
+#endif  //  BOUNDS_TREE_H
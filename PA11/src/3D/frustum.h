@@ -0,0 +1,35 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <QMatrix4x4>
+#include <QVector4D>
+
+#include "bounds.h"
+
+/**
+ * @brief      The six planes of a camera's view volume, in world space.
+ * @details    The planes are taken straight from the rows of the world to clip
+ * matrix and face inwards, so whatever is behind any one of them is off the
+ * screen.
+ */
+class Frustum
+{
+public:
+    enum Result
+    {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
+    Frustum( const QMatrix4x4& worldToClip );
+
+    Result classify( const Bounds& bounds ) const;
+    bool intersects( const Bounds& bounds ) const;
+
+private:
+    static const int NUM_PLANES = 6;
+    QVector4D m_planes[NUM_PLANES];
+};
+
+#endif  //  FRUSTUM_H
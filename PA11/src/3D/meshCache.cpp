@@ -0,0 +1,217 @@
+#include "meshCache.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <cstring>
+
+//
+// PRIVATE HELPERS /////////////////////////////////////////////////////////////
+//
+
+namespace
+{
+    const char MAGIC[4] = { 'M', 'E', 'S', 'H' };
+
+    struct Header
+    {
+        char magic[4];
+        quint32 version;
+        quint32 vertexType;
+        quint32 vertexStride;
+        qint64 sourceSize;
+        qint64 sourceModified;
+        quint32 numVertices;
+        quint32 numIndices;
+    };
+
+    /**
+     * @brief      Builds the header a cache of the source model should have.
+     *
+     * @param[in]  sourcePath  The path to the model source.
+     * @param[in]  layout      The vertex layout of the mesh.
+     * @param[in]  stride      The size of a single vertex.
+     *
+     * @return     The expected header, with empty vertex and index counts.
+     */
+    Header makeHeader( QString sourcePath, MeshCache::Layout layout,
+        quint32 stride )
+    {
+        QFileInfo source( sourcePath );
+
+        Header header;
+        memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+        header.version = MeshCache::VERSION;
+        header.vertexType = layout;
+        header.vertexStride = stride;
+        header.sourceSize = source.size();
+        header.sourceModified = source.lastModified().toMSecsSinceEpoch();
+        header.numVertices = 0;
+        header.numIndices = 0;
+
+        return header;
+    }
+
+    /**
+     * @brief      Memory maps a cache file and copies out its mesh.
+     *
+     * @param[in]  sourcePath  The path to the model source.
+     * @param[in]  layout      The vertex layout expected in the cache.
+     * @param[out] mesh        The mesh read from the cache.
+     *
+     * @return     True if a valid, up to date cache was read.
+     */
+    template <typename Vertex>
+    bool loadMesh( QString sourcePath, MeshCache::Layout layout,
+        Mesh<Vertex>& mesh )
+    {
+        if( !QFileInfo( sourcePath ).exists() )
+            return false;
+
+        QFile file( MeshCache::cachePath( sourcePath, layout ) );
+        if( !file.open( QIODevice::ReadOnly ) ||
+            file.size() < (qint64)sizeof( Header ) )
+            return false;
+
+        uchar* data = file.map( 0, file.size() );
+        if( data == NULL )
+            return false;
+
+        const Header expected = makeHeader( sourcePath, layout,
+            sizeof( Vertex ) );
+        Header header;
+        memcpy( &header, data, sizeof( Header ) );
+
+        const qint64 vertexBytes =
+            (qint64)header.numVertices * sizeof( Vertex );
+        const qint64 indexBytes = (qint64)header.numIndices * sizeof( GLuint );
+
+        bool valid =
+            memcmp( header.magic, expected.magic, sizeof( MAGIC ) ) == 0 &&
+            header.version == expected.version &&
+            header.vertexType == expected.vertexType &&
+            header.vertexStride == expected.vertexStride &&
+            header.sourceSize == expected.sourceSize &&
+            header.sourceModified == expected.sourceModified &&
+            file.size() == (qint64)sizeof( Header ) + vertexBytes + indexBytes;
+
+        if( valid )
+        {
+            mesh.Vertices.resize( header.numVertices );
+            mesh.Indices.resize( header.numIndices );
+            memcpy( mesh.Vertices.data(), data + sizeof( Header ),
+                vertexBytes );
+            memcpy( mesh.Indices.data(), data + sizeof( Header ) + vertexBytes,
+                indexBytes );
+        }
+
+        file.unmap( data );
+        return valid;
+    }
+
+    /**
+     * @brief      Writes a mesh to the source model's cache file.
+     *
+     * @param[in]  sourcePath  The path to the model source.
+     * @param[in]  layout      The vertex layout of the mesh.
+     * @param[in]  mesh        The mesh to store.
+     *
+     * @return     True if the cache was written.
+     */
+    template <typename Vertex>
+    bool saveMesh( QString sourcePath, MeshCache::Layout layout,
+        const Mesh<Vertex>& mesh )
+    {
+        if( !QFileInfo( sourcePath ).exists() )
+            return false;
+
+        Header header = makeHeader( sourcePath, layout, sizeof( Vertex ) );
+        header.numVertices = mesh.Vertices.size();
+        header.numIndices = mesh.Indices.size();
+
+        // QSaveFile only replaces the old cache once everything is written
+        QSaveFile file( MeshCache::cachePath( sourcePath, layout ) );
+        if( !file.open( QIODevice::WriteOnly ) )
+            return false;
+
+        file.write( reinterpret_cast<const char*>( &header ), sizeof( Header ) );
+        file.write( reinterpret_cast<const char*>( mesh.Vertices.data() ),
+            mesh.Vertices.size() * sizeof( Vertex ) );
+        file.write( reinterpret_cast<const char*>( mesh.Indices.data() ),
+            mesh.Indices.size() * sizeof( GLuint ) );
+
+        return file.commit();
+    }
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the cache file used for a model. A model loaded with both
+ *             layouts gets a cache file for each.
+ *
+ * @param[in]  sourcePath  The path to the model source.
+ * @param[in]  layout      The vertex layout of the mesh.
+ *
+ * @return     The path to the model's cache file.
+ */
+QString MeshCache::cachePath( QString sourcePath, Layout layout )
+{
+    return sourcePath + ( layout == UVLayout ? ".uv.mesh" : ".color.mesh" );
+}
+
+/**
+ * @brief       Loads a cached UV-based mesh.
+ *
+ * @param[in]   sourcePath  The path to the model source.
+ * @param[out]  mesh        The mesh read from the cache.
+ *
+ * @return     True if a valid, up to date cache was read.
+ */
+bool MeshCache::loadUVMesh( QString sourcePath, UVMesh& mesh )
+{
+    return loadMesh( sourcePath, UVLayout, mesh );
+}
+
+/**
+ * @brief       Loads a cached material-based mesh.
+ *
+ * @param[in]   sourcePath  The path to the model source.
+ * @param[out]  mesh        The mesh read from the cache.
+ *
+ * @return     True if a valid, up to date cache was read.
+ */
+bool MeshCache::loadColorMesh( QString sourcePath, ColorMesh& mesh )
+{
+    return loadMesh( sourcePath, ColorLayout, mesh );
+}
+
+/**
+ * @brief      Caches a UV-based mesh next to its model source.
+ *
+ * @param[in]  sourcePath  The path to the model source.
+ * @param[in]  mesh        The mesh to store.
+ *
+ * @return     True if the cache was written.
+ */
+bool MeshCache::saveUVMesh( QString sourcePath, const UVMesh& mesh )
+{
+    return saveMesh( sourcePath, UVLayout, mesh );
+}
+
+/**
+ * @brief      Caches a material-based mesh next to its model source.
+ *
+ * @param[in]  sourcePath  The path to the model source.
+ * @param[in]  mesh        The mesh to store.
+ *
+ * @return     True if the cache was written.
+ */
+bool MeshCache::saveColorMesh( QString sourcePath, const ColorMesh& mesh )
+{
+    return saveMesh( sourcePath, ColorLayout, mesh );
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <QString>
+
+#include "mesh.h"
+
+/**
+ * @brief      Binary cache of meshes already processed by ModelLoader.
+ * @details    Each model gets a sibling "<model>.uv.mesh" or
+ * "<model>.color.mesh" file, one per vertex layout, holding a small header
+ * followed by the packed vertex and index blocks. The header records the
+ * format version, vertex layout and the source model's size and modification
+ * time, so a stale or foreign cache is simply ignored.
+ */
+namespace MeshCache
+{
+    const quint32 VERSION = 1;
+
+    // Vertex layouts a cache file can hold
+    enum Layout
+    {
+        UVLayout,
+        ColorLayout
+    };
+
+    QString cachePath( QString sourcePath, Layout layout );
+
+    bool loadUVMesh( QString sourcePath, UVMesh& mesh );
+    bool loadColorMesh( QString sourcePath, ColorMesh& mesh );
+    bool saveUVMesh( QString sourcePath, const UVMesh& mesh );
+    bool saveColorMesh( QString sourcePath, const ColorMesh& mesh );
+};
+
+#endif  //  MESH_CACHE_H
\ No newline at end of file
@@ -4,15 +4,29 @@
  * @brief       Loads a UV-based model based on a file path.
  *
  * @param[in]   filePath      The full path to the model source.
- * @param[out]  geometry      The geometry data of the uv model loaded.
- * @param[out]  numVertices   The number of vertices within the uv model.
+ * @param[out]  mesh          The indexed geometry and bounds of the uv model.
+ * @param[out]  cached        Set to whether an up to date bake of the model
+ *                            exists afterwards, may be NULL.
  *
  * @return     True of the model loaded successfully, false otherwise.
  */
-bool ModelLoader::loadUVModel( QString filePath, UVVertex*& geometry, 
-    int& numVertices )
+bool ModelLoader::loadUVModel( QString filePath, UVMesh& mesh,
+    bool* cached )
 {
-    numVertices = 0;
+    mesh.Vertices.clear();
+    mesh.Indices.clear();
+    if( cached != NULL )
+        *cached = false;
+
+    // Skip Assimp entirely when an up to date bake exists
+    if( MeshCache::loadUVMesh( filePath, mesh ) )
+    {
+        mesh.computeBounds();
+        mesh.computeCullFace();
+        if( cached != NULL )
+            *cached = true;
+        return true;
+    }
 
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile( filePath.toStdString(), 
@@ -20,6 +34,7 @@ bool ModelLoader::loadUVModel( QString filePath, UVVertex*& geometry,
         aiProcess_CalcTangentSpace |
         aiProcess_Triangulate |
         aiProcess_JoinIdenticalVertices |
+        aiProcess_ImproveCacheLocality |
         aiProcess_SortByPType );
 
     if( scene == NULL )
@@ -28,44 +43,55 @@ bool ModelLoader::loadUVModel( QString filePath, UVVertex*& geometry,
         return false;
     }
 
-    aiMesh** mesh = new aiMesh*[scene->mNumMeshes];
-
+    unsigned int numVertices = 0, numIndices = 0;
     for( unsigned int i = 0; i < scene->mNumMeshes; i++ )
     {
-        mesh[i] = scene->mMeshes[i];
-        for( unsigned int j = 0; j < mesh[i]->mNumFaces; j++ )
-        {
-            numVertices += mesh[i]->mFaces[j].mNumIndices;
-        }
+        numVertices += scene->mMeshes[i]->mNumVertices;
+        numIndices += scene->mMeshes[i]->mNumFaces * 3;
     }
-
-    UVVertex* geo = new UVVertex[ numVertices ];
+    mesh.Vertices.reserve( numVertices );
+    mesh.Indices.reserve( numIndices );
 
     for( unsigned int h = 0; h < scene->mNumMeshes; h++ )
     {
-        for( unsigned int i = 0; i < mesh[h]->mNumFaces; i++ )
+        const aiMesh* subMesh = scene->mMeshes[h];
+        const GLuint baseVertex = mesh.Vertices.size();
+
+        for( unsigned int i = 0; i < subMesh->mNumVertices; i++ )
         {
-            const aiFace& face = mesh[h]->mFaces[i];
+            aiVector3D pos = subMesh->mVertices[i];
+            QVector3D position( pos.x, pos.y, pos.z );
 
-            for( unsigned int j = 0; j < 3; j++ )
+            QVector2D uv_coords;
+            if( subMesh->HasTextureCoords( 0 ) )
             {
-                aiVector3D pos = mesh[h]->mVertices[ face.mIndices[j] ];
-                QVector3D position( pos.x, pos.y, pos.z) ;
-
-                aiVector3D uv = mesh[h]->mTextureCoords[0][face.mIndices[j]];
-                QVector2D uv_coords( uv.x, uv.y );
-                
-                geo->setPosition( position );
-                geo->setUV( uv_coords );
-                
-                geo++;
+                aiVector3D uv = subMesh->mTextureCoords[0][i];
+                uv_coords = QVector2D( uv.x, uv.y );
             }
+
+            mesh.Vertices.push_back( UVVertex( position, uv_coords ) );
+        }
+
+        for( unsigned int i = 0; i < subMesh->mNumFaces; i++ )
+        {
+            const aiFace& face = subMesh->mFaces[i];
+            if( face.mNumIndices != 3 )
+                continue;
+
+            for( unsigned int j = 0; j < 3; j++ )
+                mesh.Indices.push_back( baseVertex + face.mIndices[j] );
         }
     }
 
-    geo -= numVertices;
+    mesh.computeBounds();
+    mesh.computeCullFace();
 
-    geometry = geo;
+    // The mesh is still usable, only the next load pays for Assimp again
+    const bool saved = MeshCache::saveUVMesh( filePath, mesh );
+    if( !saved )
+        qDebug() << "Could not cache" << filePath;
+    if( cached != NULL )
+        *cached = saved;
     return true;
 }
 
@@ -73,15 +99,29 @@ bool ModelLoader::loadUVModel( QString filePath, UVVertex*& geometry,
  * @brief       Loads a material-based model based on a file path.
  *
  * @param[in]   filePath      The full path to the model source.
- * @param[out]  geometry      The geometry data of the color model loaded.
- * @param[out]  numVertices   The number of vertices within the color model.
+ * @param[out]  mesh          The indexed geometry and bounds of the color model.
+ * @param[out]  cached        Set to whether an up to date bake of the model
+ *                            exists afterwards, may be NULL.
  *
  * @return     True of the model loaded successfully, false otherwise.
  */
-bool ModelLoader::loadColorModel( QString filePath, ColorVertex*& geometry, 
-    int& numVertices )
+bool ModelLoader::loadColorModel( QString filePath, ColorMesh& mesh,
+    bool* cached )
 {
-    numVertices = 0;
+    mesh.Vertices.clear();
+    mesh.Indices.clear();
+    if( cached != NULL )
+        *cached = false;
+
+    // Skip Assimp entirely when an up to date bake exists
+    if( MeshCache::loadColorMesh( filePath, mesh ) )
+    {
+        mesh.computeBounds();
+        mesh.computeCullFace();
+        if( cached != NULL )
+            *cached = true;
+        return true;
+    }
 
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile( filePath.toStdString(), 
@@ -89,6 +129,7 @@ bool ModelLoader::loadColorModel( QString filePath, ColorVertex*& geometry,
         aiProcess_CalcTangentSpace |
         aiProcess_Triangulate |
         aiProcess_JoinIdenticalVertices |
+        aiProcess_ImproveCacheLocality |
         aiProcess_SortByPType );
 
     if( scene == NULL )
@@ -97,98 +138,60 @@ bool ModelLoader::loadColorModel( QString filePath, ColorVertex*& geometry,
         return false;
     }
 
-    aiMesh** mesh = new aiMesh*[scene->mNumMeshes];
-
+    unsigned int numVertices = 0, numIndices = 0;
     for( unsigned int i = 0; i < scene->mNumMeshes; i++ )
     {
-        mesh[i] = scene->mMeshes[i];
-        for( unsigned int j = 0; j < mesh[i]->mNumFaces; j++ )
-        {
-            numVertices += mesh[i]->mFaces[j].mNumIndices;
-        }
+        numVertices += scene->mMeshes[i]->mNumVertices;
+        numIndices += scene->mMeshes[i]->mNumFaces * 3;
     }
-
-    ColorVertex* geo = new ColorVertex[ numVertices ];
+    mesh.Vertices.reserve( numVertices );
+    mesh.Indices.reserve( numIndices );
 
     for( unsigned int h = 0; h < scene->mNumMeshes; h++ )
     {
-        for( unsigned int i = 0; i < mesh[h]->mNumFaces; i++ )
+        const aiMesh* subMesh = scene->mMeshes[h];
+        const aiMaterial* mtl = scene->mMaterials[ subMesh->mMaterialIndex ];
+        const GLuint baseVertex = mesh.Vertices.size();
+
+        // Color is per material, and so the same for every vertex in the mesh
+        QVector4D color( 255.0, 165.0, 0.0, 1.0 );
+        aiColor4D diffuse;
+        if( AI_SUCCESS == aiGetMaterialColor(
+            mtl, AI_MATKEY_COLOR_DIFFUSE, &diffuse ) )
         {
-            const aiFace& face = mesh[h]->mFaces[i];
-            const aiMaterial* mtl = scene->mMaterials[ 
-                mesh[h]->mMaterialIndex ];
-
-            for( unsigned int j = 0; j < 3; j++ )
-            {
-                aiVector3D pos = mesh[h]->mVertices[ face.mIndices[j] ];
-                QVector3D position( pos.x, pos.y, pos.z) ;
-
-                QVector4D color( 255.0, 165.0, 0.0, 1.0 );
-                aiColor4D diffuse;
-                if( AI_SUCCESS == aiGetMaterialColor(
-                    mtl, AI_MATKEY_COLOR_DIFFUSE, &diffuse ) )
-                {
-                    color.setW( diffuse.a );
-                    color.setX( diffuse.r );
-                    color.setY( diffuse.g );
-                    color.setZ( diffuse.b );
-                }
-                
-                geo->setPosition( position );
-                geo->setColor( color );
-                geo++;
-            }
+            color.setW( diffuse.a );
+            color.setX( diffuse.r );
+            color.setY( diffuse.g );
+            color.setZ( diffuse.b );
         }
-    }
-
-    geo -= numVertices;
 
-    geometry = geo;
-    return true;
-}
-
-bool ModelLoader::loadTriMesh( QString filePath, btTriangleMesh*& triMesh )
-{
-    Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile( filePath.toStdString(), 
-        aiProcess_GenSmoothNormals |
-        aiProcess_CalcTangentSpace |
-        aiProcess_Triangulate |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_SortByPType );
-
-    if( scene == NULL )
-    {
-        qDebug() << importer.GetErrorString();
-        return false;
-    }
-
-    aiMesh** mesh = new aiMesh*[scene->mNumMeshes];
-
-    for( unsigned int i = 0; i < scene->mNumMeshes; i++ )
-        mesh[i] = scene->mMeshes[i];
+        for( unsigned int i = 0; i < subMesh->mNumVertices; i++ )
+        {
+            aiVector3D pos = subMesh->mVertices[i];
+            QVector3D position( pos.x, pos.y, pos.z );
 
-    btTriangleMesh* tempTriMesh = new btTriangleMesh();
-    btVector3* triMeshVertices = new btVector3[3];
+            mesh.Vertices.push_back( ColorVertex( position, color ) );
+        }
 
-    for( unsigned int h = 0; h < scene->mNumMeshes; h++ )
-    {
-        for( unsigned int i = 0; i < mesh[h]->mNumFaces; i++ )
+        for( unsigned int i = 0; i < subMesh->mNumFaces; i++ )
         {
-            const aiFace& face = mesh[h]->mFaces[i];
+            const aiFace& face = subMesh->mFaces[i];
+            if( face.mNumIndices != 3 )
+                continue;
 
             for( unsigned int j = 0; j < 3; j++ )
-            {
-                aiVector3D pos = mesh[h]->mVertices[ face.mIndices[j] ];
-                triMeshVertices[j] = btVector3( pos.x, pos.y, pos.z );
-            }
-
-            tempTriMesh->addTriangle( triMeshVertices[0], triMeshVertices[1], 
-                triMeshVertices[2] );
+                mesh.Indices.push_back( baseVertex + face.mIndices[j] );
         }
     }
 
-    triMesh = tempTriMesh;
+    mesh.computeBounds();
+    mesh.computeCullFace();
+
+    // The mesh is still usable, only the next load pays for Assimp again
+    const bool saved = MeshCache::saveColorMesh( filePath, mesh );
+    if( !saved )
+        qDebug() << "Could not cache" << filePath;
+    if( cached != NULL )
+        *cached = saved;
     return true;
 }
-
@@ -4,8 +4,8 @@
 #include <QString>
 #include <QDebug>
 
-#include "uvVertex.h"
-#include "colorVertex.h"
+#include "mesh.h"
+#include "meshCache.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -15,10 +15,43 @@
 
 namespace ModelLoader
 {
-    bool loadUVModel( QString filePath, UVVertex*& geometry, int& numVertices );
-    bool loadColorModel( QString filePath, ColorVertex*& geometry, 
-        int& numVertices );
-    bool loadTriMesh( QString filePath, btTriangleMesh*& collisionMesh );
+    bool loadUVModel( QString filePath, UVMesh& mesh, bool* cached = NULL );
+    bool loadColorModel( QString filePath, ColorMesh& mesh,
+        bool* cached = NULL );
+
+    template <typename Vertex>
+    btTriangleIndexVertexArray* createTriMesh( Mesh<Vertex>& mesh );
 };
 
+/**
+ * @brief      Wraps an already loaded mesh as a Bullet collision mesh.
+ * @details    Bullet reads the positions and indices in place, so the model
+ * is only imported once and the mesh must outlive the returned array.
+ *
+ * @param[in]  mesh  The render mesh to collide against.
+ *
+ * @return     A collision mesh sharing the render mesh's data.
+ */
+template <typename Vertex>
+btTriangleIndexVertexArray* ModelLoader::createTriMesh( Mesh<Vertex>& mesh )
+{
+    btIndexedMesh indexedMesh;
+    indexedMesh.m_numTriangles = mesh.Indices.size() / 3;
+    indexedMesh.m_triangleIndexBase =
+        reinterpret_cast<const unsigned char*>( mesh.Indices.data() );
+    indexedMesh.m_triangleIndexStride = 3 * sizeof( GLuint );
+    indexedMesh.m_numVertices = mesh.Vertices.size();
+    indexedMesh.m_vertexBase =
+        reinterpret_cast<const unsigned char*>( mesh.Vertices.data() ) +
+        Vertex::positionOffset();
+    indexedMesh.m_vertexStride = Vertex::stride();
+    indexedMesh.m_indexType = PHY_INTEGER;
+    indexedMesh.m_vertexType = PHY_FLOAT;
+
+    btTriangleIndexVertexArray* triMesh = new btTriangleIndexVertexArray();
+    triMesh->addIndexedMesh( indexedMesh, PHY_INTEGER );
+
+    return triMesh;
+}
+
 #endif  //  MODEL_LOADER_H
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "renderQueue.h"
+
+#include <algorithm>
+
+#include "Controls/profiler.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for an Item, an opaque, untextured triangle draw
+ *             with back faces culled.
+ */
+RenderQueue::Item::Item()
+    :   DrawPass( Opaque ), Program( NULL ), VAO( NULL ), Texture( NULL ),
+        CullFace( GL_BACK ), LineWidth( 1.0f ), ModelClip( -1 ),
+        Mode( GL_TRIANGLES ), Count( 0 ), IndexType( 0 )
+{
+}
+
+/**
+ * @brief      Constructor for RenderQueue.
+ */
+RenderQueue::RenderQueue()
+    :   m_frustum( QMatrix4x4() )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Initializes the GL functions the draws are issued with.
+ */
+void RenderQueue::initializeGL()
+{
+    initializeOpenGLFunctions();
+    m_state.initializeGL();
+}
+
+/**
+ * @brief      Starts a frame, dropping anything submitted since the last one.
+ *
+ * @param      camera      The camera the frame is drawn from.
+ * @param[in]  projection  The projection of the frame.
+ */
+void RenderQueue::begin( Camera3D& camera, const QMatrix4x4& projection )
+{
+    m_worldToClip = projection * camera.toMatrix();
+    m_eye = camera.translation();
+    m_frustum = Frustum( m_worldToClip );
+
+    m_items.clear();
+    m_keys.clear();
+}
+
+/**
+ * @brief      Queues a draw for the end of the frame.
+ *
+ * @param[in]  item  The draw.
+ */
+void RenderQueue::submit( const Item& item )
+{
+    if( item.Count == 0 )
+        return;
+
+    m_keys.push_back( std::make_pair( sortKey( item ), (int)m_items.size() ) );
+    m_items.push_back( item );
+}
+
+/**
+ * @brief      Sorts the frame's draws and issues them, then releases the
+ *             state the last one left bound. The tracked state is forgotten
+ *             first, as the renderables may have uploaded data while
+ *             submitting.
+ */
+void RenderQueue::flush()
+{
+    std::sort( m_keys.begin(), m_keys.end() );
+
+    m_state.invalidate();
+    m_state.setDepthTest( true );
+    m_state.setDepthFunc( GL_LEQUAL );
+    m_state.setDepthMask( true );
+
+    for( const std::pair<quint64, int>& key : m_keys )
+        draw( m_items[key.second] );
+
+    m_state.releaseAll();
+    m_state.setLineWidth( 1.0f );
+
+    Profiler::countStateCalls( m_state.issuedCalls(), m_state.skippedCalls() );
+    m_state.resetCounts();
+}
+
+/**
+ * @brief      Gets the view volume of the frame, for the renderables to cull
+ *             their draws against.
+ *
+ * @return     The frustum of the frame's camera.
+ */
+const Frustum& RenderQueue::frustum() const
+{
+    return m_frustum;
+}
+
+/**
+ * @brief      Gets where the frame is drawn from.
+ *
+ * @return     The position of the camera.
+ */
+const QVector3D& RenderQueue::eye() const
+{
+    return m_eye;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Packs an item's state and depth into a key, most significant
+ *             first: 4 bits of pass, 8 of program, 12 of texture, 12 of VAO
+ *             and 16 of depth. Ids wider than their field only sort less well,
+ *             the draws stay correct.
+ *
+ * @param[in]  item  The draw.
+ *
+ * @return     The key to sort the draw by.
+ */
+quint64 RenderQueue::sortKey( const Item& item ) const
+{
+    const quint64 program = item.Program->programId() & 0xff;
+    const quint64 texture = item.Texture == NULL ? 0 :
+        item.Texture->textureId() & 0xfff;
+    const quint64 vao = item.VAO->objectId() & 0xfff;
+
+    const float distance = ( item.Center - m_eye ).length();
+    const quint64 depth = std::min( distance / MAX_DEPTH, 1.0f ) * 0xffff;
+
+    return (quint64)item.DrawPass << 60 | program << 52 | texture << 40 |
+        vao << 28 | depth << 12;
+}
+
+/**
+ * @brief      Issues a single draw, binding only the state that differs from
+ *             the last one.
+ *
+ * @param[in]  item  The draw.
+ */
+void RenderQueue::draw( const Item& item )
+{
+    m_state.useProgram( item.Program );
+    m_state.bindVAO( item.VAO );
+    m_state.bindTexture( item.Texture );
+    m_state.setCullFace( item.CullFace );
+    m_state.setLineWidth( item.LineWidth );
+
+    item.Program->setUniformValue( item.ModelClip,
+        m_worldToClip * item.Transform );
+
+    if( item.IndexType != 0 )
+        glDrawElements( item.Mode, item.Count, item.IndexType, 0 );
+    else
+        glDrawArrays( item.Mode, 0, item.Count );
+    Profiler::countDrawCall( item.Mode == GL_TRIANGLES ? item.Count / 3 : 0 );
+}
@@ -0,0 +1,100 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QOpenGLVertexArrayObject>
+
+#include <QMatrix4x4>
+#include <QVector3D>
+
+#include <utility>
+#include <vector>
+
+#include "Controls/camera3d.h"
+#include "frustum.h"
+#include "glState.h"
+
+/**
+ * @brief      Collects a frame's draws and issues them in sorted order.
+ * @details    Renderables submit one Item per draw instead of drawing right
+ * away. Each item gets a sort key of its pass, program, texture, VAO and
+ * distance from the eye, in that order, so draws sharing state end up next to
+ * each other, and the state is set through a GLState so a program, texture,
+ * VAO or cull mode is only set when it changes.
+ * Within the same state the opaque pass goes front to back for early depth
+ * rejection, and the background pass, such as a skybox, is drawn last over
+ * whatever is left uncovered.
+ *
+ * Every program is expected to take a model_to_clip uniform. The world to clip
+ * matrix is the same for the whole frame and is multiplied once in begin(), so
+ * each draw costs a single matrix product on the CPU and the vertex shader a
+ * single one per vertex.
+ */
+class RenderQueue   :   protected QOpenGLFunctions
+{
+public:
+    enum Pass
+    {
+        Opaque,
+        Background
+    };
+
+    struct Item
+    {
+        Item();
+
+        Pass DrawPass;
+
+        // State, the texture may be NULL and culling GL_NONE
+        QOpenGLShaderProgram* Program;
+        QOpenGLVertexArrayObject* VAO;
+        QOpenGLTexture* Texture;
+        GLenum CullFace;
+        float LineWidth;
+
+        // Uniform location in the program
+        int ModelClip;
+
+        // Model to world matrix, and where the draw is for depth sorting
+        QMatrix4x4 Transform;
+        QVector3D Center;
+
+        // Indexed when IndexType is set, otherwise straight from the VBO
+        GLenum Mode;
+        GLsizei Count;
+        GLenum IndexType;
+    };
+
+    RenderQueue();
+
+    void initializeGL();
+    void begin( Camera3D& camera, const QMatrix4x4& projection );
+    void submit( const Item& item );
+    void flush();
+
+    const Frustum& frustum() const;
+    const QVector3D& eye() const;
+
+private:
+    quint64 sortKey( const Item& item ) const;
+    void draw( const Item& item );
+
+    // Distance past which every draw sorts as equally far
+    const float MAX_DEPTH = 2048.0f;
+
+    // Frame Information
+    QMatrix4x4 m_worldToClip;
+    QVector3D m_eye;
+    Frustum m_frustum;
+
+    // Submitted items, and their keys to sort
+    std::vector<Item> m_items;
+    std::vector< std::pair<quint64, int> > m_keys;
+
+    // State left by the last draw
+    GLState m_state;
+};
+
+#endif  //  RENDER_QUEUE_H
@@ -3,15 +3,21 @@
 
 #include <QOpenGLFunctions>
 #include <QMatrix4x4>
-#include "Controls/camera3d.h"
+#include "3D/bounds.h"
+#include "3D/renderQueue.h"
 
 class Renderable    :   protected QOpenGLFunctions
 {
 public:
     virtual void initializeGL() = 0;
-    virtual void paintGL( Camera3D& camera, QMatrix4x4& projection ) = 0;
+    virtual void submit( RenderQueue& queue ) = 0;
     virtual void update() = 0;
+    virtual void interpolate( float alpha ) { (void)alpha; }
     virtual void teardownGL() = 0;
+
+    // World space bounds as last drawn, false if the renderable is never
+    // culled as a whole, such as one culling its own parts
+    virtual bool worldBounds( Bounds& bounds ) { (void)bounds; return false; }
 };
 
 #endif  //  RENDERABLE
\ No newline at end of file
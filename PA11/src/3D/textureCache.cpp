@@ -0,0 +1,568 @@
+#include "textureCache.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+//
+// PRIVATE HELPERS /////////////////////////////////////////////////////////////
+//
+
+namespace
+{
+    const char MAGIC[4] = { 'T', 'E', 'X', 'C' };
+
+    // Largest side a cached texture may have, past any GL 2.1 driver's limit
+    const quint32 MAX_SIZE = 1 << 14;
+
+    struct Header
+    {
+        char magic[4];
+        quint32 version;
+        quint32 format;
+        quint32 width;
+        quint32 height;
+        quint32 numLevels;
+        qint64 sourceSize;
+        qint64 sourceModified;
+    };
+
+    /**
+     * @brief      Builds the header a cache of the source image should have.
+     *
+     * @param[in]  sourcePath  The path to the image source.
+     *
+     * @return     The expected header, with an empty format and size.
+     */
+    Header makeHeader( QString sourcePath )
+    {
+        QFileInfo source( sourcePath );
+
+        Header header;
+        memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+        header.version = TextureCache::VERSION;
+        header.format = TextureCache::RGBA8;
+        header.width = 0;
+        header.height = 0;
+        header.numLevels = 0;
+        header.sourceSize = source.size();
+        header.sourceModified = source.lastModified().toMSecsSinceEpoch();
+
+        return header;
+    }
+
+    /**
+     * @brief      Gets the number of bytes a single mip level takes up.
+     *
+     * @param[in]  format  The pixel format of the level.
+     * @param[in]  width   The width of the level.
+     * @param[in]  height  The height of the level.
+     *
+     * @return     The size of the level.
+     */
+    int levelSize( TextureCache::Format format, int width, int height )
+    {
+        if( format == TextureCache::DXT1 )
+            return ( ( width + 3 ) / 4 ) * ( ( height + 3 ) / 4 ) * 8;
+
+        return width * height * 4;
+    }
+
+    /**
+     * @brief      Gets the number of levels in a full mip chain.
+     *
+     * @param[in]  width   The width of the first level.
+     * @param[in]  height  The height of the first level.
+     *
+     * @return     The number of levels down to 1x1.
+     */
+    quint32 countLevels( quint32 width, quint32 height )
+    {
+        quint32 levels = 1;
+        while( width > 1 || height > 1 )
+        {
+            width = std::max( 1u, width / 2 );
+            height = std::max( 1u, height / 2 );
+            levels++;
+        }
+        return levels;
+    }
+
+    /**
+     * @brief      Packs an 8 bit per channel color into RGB565.
+     *
+     * @param[in]  rgb   The color to pack.
+     *
+     * @return     The packed color.
+     */
+    quint16 pack565( const int rgb[3] )
+    {
+        return ( ( rgb[0] >> 3 ) << 11 ) | ( ( rgb[1] >> 2 ) << 5 ) |
+            ( rgb[2] >> 3 );
+    }
+
+    /**
+     * @brief      Expands an RGB565 color back to 8 bits per channel.
+     *
+     * @param[in]  color  The packed color.
+     * @param[out] rgb    The expanded color.
+     */
+    void unpack565( quint16 color, int rgb[3] )
+    {
+        const int r = ( color >> 11 ) & 31;
+        const int g = ( color >> 5 ) & 63;
+        const int b = color & 31;
+
+        rgb[0] = ( r << 3 ) | ( r >> 2 );
+        rgb[1] = ( g << 2 ) | ( g >> 4 );
+        rgb[2] = ( b << 3 ) | ( b >> 2 );
+    }
+
+    /**
+     * @brief      Expands the two endpoints of a block into its palette.
+     *
+     * @param[in]  c0      The first endpoint.
+     * @param[in]  c1      The second endpoint.
+     * @param[out] colors  The four RGBA colors of the block.
+     */
+    void makePalette( quint16 c0, quint16 c1, int colors[4][4] )
+    {
+        unpack565( c0, colors[0] );
+        unpack565( c1, colors[1] );
+
+        for( int channel = 0; channel < 3; channel++ )
+        {
+            const int a = colors[0][channel];
+            const int b = colors[1][channel];
+
+            if( c0 > c1 )
+            {
+                colors[2][channel] = ( 2 * a + b ) / 3;
+                colors[3][channel] = ( a + 2 * b ) / 3;
+            }
+            else
+            {
+                colors[2][channel] = ( a + b ) / 2;
+                colors[3][channel] = 0;
+            }
+        }
+
+        colors[0][3] = colors[1][3] = colors[2][3] = 255;
+        colors[3][3] = c0 > c1 ? 255 : 0;
+    }
+
+    /**
+     * @brief      Compresses a 4x4 block of RGBA pixels. The endpoints are the
+     *             corners of the block's color bounding box.
+     *
+     * @param[in]  pixels  The 16 pixels of the block, row by row.
+     * @param[out] block   The 8 bytes of the compressed block.
+     */
+    void encodeBlock( const uchar pixels[16][4], uchar* block )
+    {
+        int low[3] = { 255, 255, 255 };
+        int high[3] = { 0, 0, 0 };
+        for( int i = 0; i < 16; i++ )
+        {
+            for( int channel = 0; channel < 3; channel++ )
+            {
+                low[channel] = std::min<int>( low[channel], pixels[i][channel] );
+                high[channel] =
+                    std::max<int>( high[channel], pixels[i][channel] );
+            }
+        }
+
+        // c0 > c1 selects the opaque four color mode
+        quint16 c0 = pack565( high );
+        quint16 c1 = pack565( low );
+        if( c0 < c1 )
+            std::swap( c0, c1 );
+
+        quint32 indices = 0;
+        if( c0 != c1 )
+        {
+            int colors[4][4];
+            makePalette( c0, c1, colors );
+
+            for( int i = 0; i < 16; i++ )
+            {
+                int best = 0;
+                int bestDistance = INT_MAX;
+                for( int entry = 0; entry < 4; entry++ )
+                {
+                    int distance = 0;
+                    for( int channel = 0; channel < 3; channel++ )
+                    {
+                        const int delta =
+                            colors[entry][channel] - pixels[i][channel];
+                        distance += delta * delta;
+                    }
+
+                    if( distance < bestDistance )
+                    {
+                        best = entry;
+                        bestDistance = distance;
+                    }
+                }
+
+                indices |= (quint32)best << ( 2 * i );
+            }
+        }
+
+        block[0] = c0 & 0xFF;
+        block[1] = c0 >> 8;
+        block[2] = c1 & 0xFF;
+        block[3] = c1 >> 8;
+        for( int i = 0; i < 4; i++ )
+            block[4 + i] = ( indices >> ( 8 * i ) ) & 0xFF;
+    }
+
+    /**
+     * @brief      Compresses a tightly packed RGBA level. Blocks hanging over
+     *             the edge repeat the last row and column.
+     *
+     * @param[in]  rgba    The RGBA pixels of the level.
+     * @param[in]  width   The width of the level.
+     * @param[in]  height  The height of the level.
+     *
+     * @return     The compressed level.
+     */
+    QByteArray encodeLevel( const uchar* rgba, int width, int height )
+    {
+        QByteArray data( levelSize( TextureCache::DXT1, width, height ), 0 );
+        uchar* block = reinterpret_cast<uchar*>( data.data() );
+
+        uchar pixels[16][4];
+        for( int by = 0; by < height; by += 4 )
+        {
+            for( int bx = 0; bx < width; bx += 4 )
+            {
+                for( int i = 0; i < 16; i++ )
+                {
+                    const int x = std::min( bx + i % 4, width - 1 );
+                    const int y = std::min( by + i / 4, height - 1 );
+                    memcpy( pixels[i], rgba + ( y * width + x ) * 4, 4 );
+                }
+
+                encodeBlock( pixels, block );
+                block += 8;
+            }
+        }
+
+        return data;
+    }
+
+    /**
+     * @brief      Decompresses a DXT1 level into tightly packed RGBA.
+     *
+     * @param[in]  data    The compressed level.
+     * @param[in]  width   The width of the level.
+     * @param[in]  height  The height of the level.
+     *
+     * @return     The RGBA pixels of the level.
+     */
+    QByteArray decodeLevel( const QByteArray& data, int width, int height )
+    {
+        QByteArray rgba( levelSize( TextureCache::RGBA8, width, height ), 0 );
+        uchar* pixels = reinterpret_cast<uchar*>( rgba.data() );
+        const uchar* block = reinterpret_cast<const uchar*>( data.constData() );
+
+        for( int by = 0; by < height; by += 4 )
+        {
+            for( int bx = 0; bx < width; bx += 4 )
+            {
+                const quint16 c0 = block[0] | ( block[1] << 8 );
+                const quint16 c1 = block[2] | ( block[3] << 8 );
+                const quint32 indices = block[4] | ( block[5] << 8 ) |
+                    ( block[6] << 16 ) | ( (quint32)block[7] << 24 );
+
+                int colors[4][4];
+                makePalette( c0, c1, colors );
+
+                for( int i = 0; i < 16; i++ )
+                {
+                    const int x = bx + i % 4;
+                    const int y = by + i / 4;
+                    if( x >= width || y >= height )
+                        continue;
+
+                    const int* color = colors[( indices >> ( 2 * i ) ) & 3];
+                    uchar* pixel = pixels + ( y * width + x ) * 4;
+                    for( int channel = 0; channel < 4; channel++ )
+                        pixel[channel] = color[channel];
+                }
+
+                block += 8;
+            }
+        }
+
+        return rgba;
+    }
+}
+
+//
+// REGION //////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor for Region, covering the whole image.
+ */
+TextureCache::Region::Region()
+    :   Column( 0 ), Row( 0 ), Columns( 1 ), Rows( 1 )
+{
+}
+
+/**
+ * @brief      Constructor for Region.
+ *
+ * @param[in]  column   The column of the cell, from the left.
+ * @param[in]  row      The row of the cell, from the bottom.
+ * @param[in]  columns  The number of columns the image is cut into.
+ * @param[in]  rows     The number of rows the image is cut into.
+ */
+TextureCache::Region::Region( int column, int row, int columns, int rows )
+    :   Column( column ), Row( row ), Columns( columns ), Rows( rows )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the cache file used for an image, or a region of it.
+ *
+ * @param[in]  sourcePath  The path to the image source.
+ * @param[in]  region      The region of the image.
+ * @param[in]  variant     Which of the image's caches to use.
+ *
+ * @return     The path to the cache file.
+ */
+QString TextureCache::cachePath( QString sourcePath, const Region& region,
+    Variant variant )
+{
+    const QString suffix = variant == Uncompressed ? ".rgba.tex" : ".tex";
+    if( region.Columns == 1 && region.Rows == 1 )
+        return sourcePath + suffix;
+
+    return sourcePath + QString( ".%1x%2_%3_%4" ).arg( region.Columns )
+        .arg( region.Rows ).arg( region.Column ).arg( region.Row ) + suffix;
+}
+
+/**
+ * @brief       Loads a cached mip chain.
+ *
+ * @param[in]   sourcePath  The path to the image source.
+ * @param[out]  chain       The mip chain read from the cache.
+ * @param[in]   region      The region of the image the chain was built from.
+ * @param[in]   variant     Which of the image's caches to read.
+ *
+ * @return     True if a valid, up to date cache was read.
+ */
+bool TextureCache::load( QString sourcePath, MipChain& chain,
+    const Region& region, Variant variant )
+{
+    if( !QFileInfo( sourcePath ).exists() )
+        return false;
+
+    QFile file( cachePath( sourcePath, region, variant ) );
+    if( !file.open( QIODevice::ReadOnly ) ||
+        file.size() < (qint64)sizeof( Header ) )
+        return false;
+
+    uchar* data = file.map( 0, file.size() );
+    if( data == NULL )
+        return false;
+
+    const Header expected = makeHeader( sourcePath );
+    Header header;
+    memcpy( &header, data, sizeof( Header ) );
+
+    bool valid =
+        memcmp( header.magic, expected.magic, sizeof( MAGIC ) ) == 0 &&
+        header.version == expected.version &&
+        header.sourceSize == expected.sourceSize &&
+        header.sourceModified == expected.sourceModified &&
+        ( header.format == RGBA8 || header.format == DXT1 ) &&
+        header.width > 0 && header.height > 0 &&
+        header.width <= MAX_SIZE && header.height <= MAX_SIZE &&
+        header.numLevels == countLevels( header.width, header.height );
+
+    // Every level must be present, and nothing more, before any is allocated
+    if( valid )
+    {
+        qint64 size = sizeof( Header );
+        int width = header.width;
+        int height = header.height;
+        for( quint32 i = 0; i < header.numLevels; i++ )
+        {
+            size += levelSize( (Format)header.format, width, height );
+            width = std::max( 1, width / 2 );
+            height = std::max( 1, height / 2 );
+        }
+
+        valid = size == file.size();
+    }
+
+    if( valid )
+    {
+        const Format format = (Format)header.format;
+        int width = header.width;
+        int height = header.height;
+        qint64 offset = sizeof( Header );
+
+        chain.PixelFormat = format;
+        chain.Levels.resize( header.numLevels );
+        for( MipLevel& level : chain.Levels )
+        {
+            const int size = levelSize( format, width, height );
+            level.Width = width;
+            level.Height = height;
+            level.Data = QByteArray(
+                reinterpret_cast<const char*>( data + offset ), size );
+
+            offset += size;
+            width = std::max( 1, width / 2 );
+            height = std::max( 1, height / 2 );
+        }
+    }
+
+    if( !valid )
+        chain.Levels.clear();
+
+    file.unmap( data );
+    return valid;
+}
+
+/**
+ * @brief      Writes a mip chain to the source image's cache file.
+ *
+ * @param[in]  sourcePath  The path to the image source.
+ * @param[in]  chain       The mip chain to store.
+ * @param[in]  region      The region of the image the chain was built from.
+ * @param[in]  variant     Which of the image's caches to write.
+ *
+ * @return     True if the cache was written.
+ */
+bool TextureCache::save( QString sourcePath, const MipChain& chain,
+    const Region& region, Variant variant )
+{
+    if( !QFileInfo( sourcePath ).exists() || chain.Levels.empty() )
+        return false;
+
+    Header header = makeHeader( sourcePath );
+    header.format = chain.PixelFormat;
+    header.width = chain.Levels[0].Width;
+    header.height = chain.Levels[0].Height;
+    header.numLevels = chain.Levels.size();
+
+    // QSaveFile only replaces the old cache once everything is written
+    QSaveFile file( cachePath( sourcePath, region, variant ) );
+    if( !file.open( QIODevice::WriteOnly ) )
+        return false;
+
+    file.write( reinterpret_cast<const char*>( &header ), sizeof( Header ) );
+    for( const MipLevel& level : chain.Levels )
+        file.write( level.Data );
+
+    return file.commit();
+}
+
+/**
+ * @brief      Cuts a region out of an image.
+ *
+ * @param[in]  image   The decoded image.
+ * @param[in]  region  The region to cut out.
+ *
+ * @return     The region, or a null image if the image is empty or does not
+ *             divide into the region's grid.
+ */
+QImage TextureCache::crop( const QImage& image, const Region& region )
+{
+    if( image.isNull() || region.Columns < 1 || region.Rows < 1 ||
+        region.Column < 0 || region.Column >= region.Columns ||
+        region.Row < 0 || region.Row >= region.Rows ||
+        image.width() % region.Columns != 0 ||
+        image.height() % region.Rows != 0 )
+        return QImage();
+
+    // Images are stored top down, regions count rows from the bottom
+    const int width = image.width() / region.Columns;
+    const int height = image.height() / region.Rows;
+    return image.copy( region.Column * width,
+        ( region.Rows - 1 - region.Row ) * height, width, height );
+}
+
+/**
+ * @brief       Builds the full mip chain of an image, flipped for OpenGL.
+ *
+ * @param[in]   image   The decoded image.
+ * @param[in]   format  The pixel format to store the chain in.
+ * @param[out]  chain   The built mip chain.
+ *
+ * @return     False if the image is empty.
+ */
+bool TextureCache::build( const QImage& image, Format format, MipChain& chain )
+{
+    chain.PixelFormat = format;
+    chain.Levels.clear();
+
+    if( image.isNull() )
+        return false;
+
+    QImage level = image.mirrored().convertToFormat( QImage::Format_RGBA8888 );
+    while( true )
+    {
+        const int width = level.width();
+        const int height = level.height();
+
+        // Scan lines may be padded, so pack the rows tightly first
+        QByteArray rgba( levelSize( RGBA8, width, height ), 0 );
+        for( int y = 0; y < height; y++ )
+        {
+            memcpy( rgba.data() + y * width * 4, level.constScanLine( y ),
+                width * 4 );
+        }
+
+        MipLevel mip;
+        mip.Width = width;
+        mip.Height = height;
+        mip.Data = format == DXT1 ? encodeLevel(
+            reinterpret_cast<const uchar*>( rgba.constData() ), width, height )
+            : rgba;
+        chain.Levels.push_back( mip );
+
+        if( width == 1 && height == 1 )
+            break;
+
+        level = level.scaled( std::max( 1, width / 2 ),
+            std::max( 1, height / 2 ), Qt::IgnoreAspectRatio,
+            Qt::SmoothTransformation );
+    }
+
+    return true;
+}
+
+/**
+ * @brief       Converts a mip chain to raw RGBA, for contexts that cannot
+ *              sample compressed textures.
+ *
+ * @param[in]   chain  The mip chain to convert.
+ * @param[out]  rgba   The RGBA copy of the chain.
+ */
+void TextureCache::decompress( const MipChain& chain, MipChain& rgba )
+{
+    rgba.PixelFormat = RGBA8;
+    rgba.Levels = chain.Levels;
+
+    if( chain.PixelFormat == RGBA8 )
+        return;
+
+    for( MipLevel& level : rgba.Levels )
+        level.Data = decodeLevel( level.Data, level.Width, level.Height );
+}
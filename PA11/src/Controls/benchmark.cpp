@@ -0,0 +1,264 @@
+#include "benchmark.h"
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QElapsedTimer>
+#include <QOpenGLFunctions>
+#include <QSurfaceFormat>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "Controls/jobSystem.h"
+#include "Maze/distanceField.h"
+#include "Maze/mazeGenerator.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Benchmark.
+ *
+ * @param[in]  numFrames  The number of frames to run.
+ * @param[in]  seed       The seed of the labyrinth and its textures.
+ * @param[in]  tickRate   The number of physics ticks per second.
+ * @param[in]  infinite   True to run an endless, streamed labyrinth.
+ * @param[in]  width      The width of the offscreen framebuffer.
+ * @param[in]  height     The height of the offscreen framebuffer.
+ */
+Benchmark::Benchmark( int numFrames, int seed, float tickRate, bool infinite,
+    int width, int height )
+    :   m_numFrames( numFrames ), m_seed( seed ), m_tickRate( tickRate ),
+        m_infinite( infinite ), m_width( width ), m_height( height )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Loads the game, runs every frame and prints the results.
+ *
+ * @return     The exit code of the program.
+ */
+int Benchmark::run()
+{
+    QTextStream out( stdout );
+
+    // Same context the game window asks for
+    QSurfaceFormat format;
+    format.setDepthBufferSize( 24 );
+    format.setRenderableType( QSurfaceFormat::OpenGL );
+    format.setProfile( QSurfaceFormat::NoProfile );
+    format.setVersion( 2,1 );
+
+    QOpenGLContext context;
+    context.setFormat( format );
+    if( !context.create() )
+    {
+        out << "Could not create an OpenGL context" << endl;
+        return 1;
+    }
+
+    QOffscreenSurface surface;
+    surface.setFormat( context.format() );
+    surface.create();
+    if( !context.makeCurrent( &surface ) )
+    {
+        out << "Could not make the OpenGL context current" << endl;
+        return 1;
+    }
+
+    QOpenGLFramebufferObject framebuffer( m_width, m_height,
+        QOpenGLFramebufferObject::Depth );
+    framebuffer.bind();
+
+    out << "OpenGL " << reinterpret_cast<const char*>(
+        context.functions()->glGetString( GL_RENDERER ) ) << ", "
+        << m_numFrames << " frames at " << m_width << "x" << m_height
+        << ", seed " << m_seed << ", " << m_tickRate << " ticks per second"
+        << endl;
+
+    // Everything is loaded up front, loading is not part of the run
+    srand( m_seed );
+    Game* game = new Game( m_seed, m_infinite );
+    game->timestep().setTickRate( m_tickRate );
+    game->initializeGL();
+    while( !game->initializeNextRenderable() )
+        continue;
+    game->resizeGL( m_width, m_height );
+
+    Profiler& profiler = game->profiler();
+    profiler.setHistorySize( m_numFrames + 1 );
+    const int profileFinish = profiler.addSection( "Finish" );
+
+    // Fixed frame time, so every run simulates the same ticks and frames
+    const float dt = 1.0f / 60.0f;
+    for( int frame = 0; frame < m_numFrames; frame++ )
+    {
+        profiler.nextFrame();
+
+        tiltScript( *game, frame );
+        game->update( dt );
+        game->paintGL();
+
+        // Wait for the GPU, so the frame time includes the draw itself
+        Profiler::Scope scope( profiler, profileFinish );
+        context.functions()->glFinish();
+    }
+    profiler.nextFrame();
+
+    out << qSetFieldWidth( 10 ) << left << "" << right << "mean" << "p50"
+        << "p99" << "max" << qSetFieldWidth( 0 ) << "  (ms)" << endl;
+    report( out, "Frame", profiler.frameTimes() );
+    for( int i = 0; i < profiler.sections().size(); i++ )
+        report( out, profiler.sections()[i], profiler.sectionTimes( i ) );
+    report( out, "GPU", profiler.gpuTimes() );
+
+    out << qSetFieldWidth( 10 ) << left << "" << right << "mean" << "p50"
+        << "p99" << "max" << qSetFieldWidth( 0 ) << endl;
+    report( out, "Draws", profiler.drawCalls() );
+    report( out, "Triangles", profiler.triangles() );
+    report( out, "Drawn", profiler.objectsDrawn() );
+    report( out, "Culled", profiler.objectsCulled() );
+    report( out, "State", profiler.stateCalls() );
+    report( out, "Skipped", profiler.stateSkipped() );
+
+    game->teardownGL();
+    delete game;
+
+    framebuffer.release();
+    context.doneCurrent();
+    return 0;
+}
+
+/**
+ * @brief      Generates a single maze and prints how long it took and how much
+ *             memory it needed. No window or context is created.
+ *
+ * @param[in]  size  The number of cells along each side of the maze.
+ * @param[in]  seed  The seed of the maze.
+ *
+ * @return     The exit code of the program.
+ */
+int Benchmark::runMaze( int size, int seed )
+{
+    QTextStream out( stdout );
+
+    QElapsedTimer timer;
+    timer.start();
+    std::size_t workerBytes = 0;
+    MazeGrid maze = MazeGenerator::makeMaze( seed, size, size, &workerBytes );
+    const qint64 elapsed = timer.elapsed();
+
+    out << size << "x" << size << " maze, seed " << seed << endl
+        << "Generated in " << elapsed << " ms" << endl
+        << "Grid: " << maze.memoryUsage() / 1024 << " KB" << endl
+        << "Generator: " << workerBytes / 1024 << " KB" << endl;
+
+    // The hole is on a diagonal, so searching for it is not part of the run
+    int goalX = size / 2, goalZ = size / 2;
+    for( int i = 0; i < size; i++ )
+    {
+        if( maze.at( i, i ) == MazeGenerator::END )
+            goalX = goalZ = i;
+        else if( maze.at( size - i - 1, i ) == MazeGenerator::END )
+            goalX = size - i - 1, goalZ = i;
+        else if( maze.at( i, size - i - 1 ) == MazeGenerator::END )
+            goalX = i, goalZ = size - i - 1;
+        else if( i > 0 && maze.at( size - i, size - i ) == MazeGenerator::END )
+            goalX = goalZ = size - i;
+    }
+
+    timer.restart();
+    DistanceField field;
+    field.build( maze, goalX, goalZ );
+    out << "Distance field in " << timer.elapsed() << " ms on "
+        << JobSystem::instance().numThreads() << " threads, "
+        << field.memoryUsage() / 1024 << " KB, "
+        << field.distance( size / 2, size / 2 ) << " steps from the start"
+        << endl;
+
+    // Again the way a game builds it, a slice every tick
+    field.start( maze, goalX, goalZ );
+    int ticks = 0;
+    qint64 longest = 0;
+    bool settled = false;
+    while( !settled )
+    {
+        timer.restart();
+        settled = field.advance( maze, DistanceField::CELLS_PER_TICK );
+        longest = std::max( longest, timer.nsecsElapsed() );
+        ticks++;
+    }
+    out << "Spread over " << ticks << " ticks, longest "
+        << longest / 1000000.0 << " ms" << endl;
+    return 0;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Stands in for the player, tilting the board left, up, right and
+ *             down for a second and a half each.
+ *
+ * @param      game   The game to control.
+ * @param[in]  frame  The frame being run.
+ */
+void Benchmark::tiltScript( Game& game, int frame )
+{
+    switch( ( frame / 90 ) % 4 )
+    {
+        case 0:
+            game.setTilt( -1, 0 );
+            break;
+        case 1:
+            game.setTilt( 0, -1 );
+            break;
+        case 2:
+            game.setTilt( 1, 0 );
+            break;
+        default:
+            game.setTilt( 0, 1 );
+            break;
+    }
+}
+
+/**
+ * @brief      Prints the mean, median, 99th percentile and worst of a series.
+ *
+ * @param      out     The stream to print to.
+ * @param[in]  name    The name of the series.
+ * @param[in]  values  The series.
+ */
+void Benchmark::report( QTextStream& out, const QString& name,
+    std::vector<double> values )
+{
+    out << qSetFieldWidth( 10 ) << left << name << right
+        << qSetRealNumberPrecision( 3 ) << fixed;
+
+    if( values.empty() )
+    {
+        out << "n/a" << qSetFieldWidth( 0 ) << endl;
+        return;
+    }
+
+    std::sort( values.begin(), values.end() );
+
+    double sum = 0.0;
+    for( double value : values )
+        sum += value;
+
+    const int n = values.size();
+    const int p50 = std::max( 0, (int)std::ceil( 0.50 * n ) - 1 );
+    const int p99 = std::max( 0, (int)std::ceil( 0.99 * n ) - 1 );
+
+    out << sum / n << values[p50] << values[p99] << values[n - 1]
+        << qSetFieldWidth( 0 ) << endl;
+}
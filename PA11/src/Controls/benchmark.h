@@ -0,0 +1,39 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QString>
+#include <QTextStream>
+
+#include <vector>
+
+#include "Maze/game.h"
+
+/**
+ * @brief      Runs the game without a window and reports its frame timings.
+ * @details    The game is drawn into a framebuffer object on an offscreen
+ * surface at a fixed 60 frames per second, while a scripted input tilts the
+ * board in a fixed pattern. With the same seed every run simulates and draws
+ * exactly the same frames, so runs can be compared against each other.
+ */
+class Benchmark
+{
+public:
+    Benchmark( int numFrames, int seed, float tickRate = 60.0f,
+        bool infinite = false, int width = 1280, int height = 720 );
+
+    int run();
+    static int runMaze( int size, int seed );
+
+private:
+    void tiltScript( Game& game, int frame );
+    void report( QTextStream& out, const QString& name,
+        std::vector<double> values );
+
+    int m_numFrames;
+    int m_seed;
+    float m_tickRate;
+    bool m_infinite;
+    int m_width, m_height;
+};
+
+#endif  //  BENCHMARK_H
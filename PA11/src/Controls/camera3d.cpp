@@ -15,6 +15,7 @@ const QVector3D Camera3D::LocalRight( 10.0f, 0.0f, 0.0f );
  * @brief      Default constructor.
  */
 Camera3D::Camera3D()
+    :   m_dirty( true )
 {
 }
 
@@ -30,6 +31,7 @@ Camera3D::Camera3D()
 void Camera3D::translate( const QVector3D& dt )
 {
     m_translation += dt;
+    m_dirty = true;
 }
 
 /**
@@ -53,6 +55,7 @@ void Camera3D::translate( float dx, float dy, float dz )
 void Camera3D::rotate( const QQuaternion& dr )
 {
     m_rotation = dr * m_rotation;
+    m_dirty = true;
 }
 
 /**
@@ -93,6 +96,7 @@ void Camera3D::rotate( float angle, float ax, float ay, float az )
 void Camera3D::setTranslation( const QVector3D& t )
 {
     m_translation = t;
+    m_dirty = true;
 }
 
 /**
@@ -116,6 +120,7 @@ void Camera3D::setTranslation( float x, float y, float z )
 void Camera3D::setRotation( const QQuaternion& r )
 {
     m_rotation = r;
+    m_dirty = true;
 }
 
 /**
@@ -169,15 +174,20 @@ const QQuaternion& Camera3D::rotation() const
 }
 
 /**
- * @brief      Getter function for m_world.
+ * @brief      Getter function for m_world. The matrix is only rebuilt after
+ *             the camera has moved.
  *
  * @return     The full matrix with current translations.
  */
 const QMatrix4x4& Camera3D::toMatrix()
 {
-    m_world.setToIdentity();
-    m_world.rotate( m_rotation.conjugate() );
-    m_world.translate( -m_translation );
+    if( m_dirty )
+    {
+        m_world.setToIdentity();
+        m_world.rotate( m_rotation.conjugate() );
+        m_world.translate( -m_translation );
+        m_dirty = false;
+    }
 
     return m_world;
 }
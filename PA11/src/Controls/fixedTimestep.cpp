@@ -0,0 +1,91 @@
+#include "fixedTimestep.h"
+
+#include <cmath>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for FixedTimestep.
+ * @details    Splits the time between frames into fixed ticks, carrying the
+ * remainder over to the next frame. At most maxTicks are run per frame; past
+ * that the backlog is dropped, so a slow frame slows the simulation down
+ * rather than making every following frame slower too.
+ *
+ * @param[in]  tickRate  The number of ticks per second.
+ * @param[in]  maxTicks  The most ticks to catch up on in a single frame.
+ */
+FixedTimestep::FixedTimestep( float tickRate, int maxTicks )
+    :   m_step( 1.0 / tickRate ), m_accumulator( 0.0 ), m_maxTicks( maxTicks )
+{
+}
+
+/**
+ * @brief      Changes the number of ticks per second.
+ *
+ * @param[in]  tickRate  The number of ticks per second.
+ */
+void FixedTimestep::setTickRate( float tickRate )
+{
+    m_step = 1.0 / tickRate;
+    m_accumulator = 0.0;
+}
+
+/**
+ * @brief      Changes the most ticks run in a single frame.
+ *
+ * @param[in]  maxTicks  The most ticks to catch up on in a single frame.
+ */
+void FixedTimestep::setMaxTicks( int maxTicks )
+{
+    m_maxTicks = maxTicks;
+}
+
+//
+// TIMESTEP FUNCTIONS //////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Adds a frame's worth of time.
+ *
+ * @param[in]  dt    The time since the last frame, in seconds.
+ *
+ * @return     The number of ticks to run this frame.
+ */
+int FixedTimestep::advance( float dt )
+{
+    m_accumulator += dt;
+
+    int ticks = std::floor( m_accumulator / m_step );
+    if( ticks > m_maxTicks )
+    {
+        ticks = m_maxTicks;
+        m_accumulator = std::fmod( m_accumulator, m_step );
+    }
+    else
+        m_accumulator -= ticks * m_step;
+
+    return ticks;
+}
+
+/**
+ * @brief      Gets the length of a single tick.
+ *
+ * @return     The tick length, in seconds.
+ */
+float FixedTimestep::step() const
+{
+    return m_step;
+}
+
+/**
+ * @brief      Gets how far the current frame is into the next tick, to blend
+ *             the last two ticks with.
+ *
+ * @return     The fraction of a tick left over, between 0 and 1.
+ */
+float FixedTimestep::alpha() const
+{
+    return m_accumulator / m_step;
+}
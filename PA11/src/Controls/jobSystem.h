@@ -0,0 +1,158 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <QMutex>
+#include <QSharedPointer>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief      Runs jobs on one pool of work-stealing threads shared by the
+ *             whole game.
+ * @details    A job is a function, or a loop cut into tasks of about its grain
+ * size. Jobs can depend on other jobs and only start once all of them are
+ * done, so a batch of work can be submitted as a graph up front, such as
+ * decoding every asset before the loading screen reports it is finished.
+ *
+ * Every thread, any thread waiting on a job included, has a deque of tasks.
+ * A job's tasks are dealt out across the deques of the active threads. Each
+ * thread takes the newest task of its own deque and, once that is empty,
+ * steals the oldest task of another one, so a thread stuck on a slow tile or
+ * asset hands the rest of its share to the idle ones. A thread waiting on a
+ * job runs tasks until the job is done instead of blocking, so jobs can wait
+ * on other jobs from inside the pool. Workers spin briefly between jobs
+ * before sleeping, so short loops back to back do not pay for a wake each.
+ *
+ * Threads outside the pool, such as the GUI thread, share the first deque and
+ * only run tasks of the job they wait on, yielding otherwise. A loop waited
+ * on in the middle of a frame so never picks up a background job, which is
+ * left to the workers.
+ *
+ * At least one worker always runs, so jobs submitted without waiting on them,
+ * such as background loads, make progress even on a single core.
+ *
+ * The workers are created once and never restarted. setNumThreads only
+ * changes how many of them take part.
+ */
+class JobSystem
+{
+public:
+    typedef std::function<void( int begin, int end )> RangeFunction;
+
+    class Job;
+    typedef QSharedPointer<Job> Handle;
+
+    // The waiting thread and one worker, which is never put to sleep
+    enum { MIN_THREADS = 2 };
+
+    static JobSystem& instance();
+
+    JobSystem( int maxThreads );
+    ~JobSystem();
+
+    int maxThreads() const;
+    int numThreads() const;
+    void setNumThreads( int numThreads );
+
+    // Task graphs, dependencies are added before the job is submitted
+    Handle create( const std::function<void()>& function );
+    Handle createFor( int begin, int end, int grainSize,
+        const RangeFunction& function );
+    void addDependency( const Handle& job, const Handle& dependency );
+    void submit( const Handle& job );
+    void wait( const Handle& job );
+
+    // Single jobs
+    Handle run( const std::function<void()>& function );
+    void parallelFor( int begin, int end, int grainSize,
+        const RangeFunction& function );
+
+    class Job
+    {
+    public:
+        bool isDone() const;
+
+    private:
+        friend class JobSystem;
+
+        Job( const RangeFunction& function, int begin, int end,
+            int grainSize );
+
+        RangeFunction m_function;
+        int m_begin, m_end, m_grainSize;
+
+        // Dependencies not done yet, plus one until submitted
+        std::atomic<int> m_blockers;
+
+        // Tasks not finished yet, once scheduled
+        std::atomic<int> m_remaining;
+
+        // Jobs waiting on this one, taken when it is done
+        QMutex m_mutex;
+        std::atomic<bool> m_done;
+        std::vector<Handle> m_dependents;
+    };
+
+private:
+    // A range of a job
+    struct Task
+    {
+        Handle Owner;
+        int Begin, End;
+    };
+
+    struct Deque
+    {
+        QMutex Mutex;
+        std::deque<Task> Tasks;
+    };
+
+    class Worker    :   public QThread
+    {
+    public:
+        Worker( JobSystem* jobs, int slot );
+
+    protected:
+        void run();
+
+    private:
+        JobSystem* m_jobs;
+        int m_slot;
+    };
+
+    void schedule( const Handle& job );
+    void finish( const Handle& job );
+    void work( int slot );
+    int currentSlot() const;
+    bool pop( int slot, Task& task );
+    bool steal( int slot, Task& task );
+    bool take( const Handle& job, Task& task );
+    void execute( const Task& task );
+
+    // Bullet keeps per-thread data for at most 64 threads, should it ever run
+    // its loops here, and the GUI thread takes one of them
+    enum { MAX_THREADS = 63 };
+
+    // Loops a worker waits for before sleeping
+    const int SPIN_COUNT = 2000;
+
+    // Slot 0 is shared by the threads outside the pool, the workers have the
+    // rest
+    std::vector<Deque*> m_deques;
+    std::vector<Worker*> m_workers;
+
+    std::atomic<int> m_numThreads;
+    std::atomic<int> m_queued;
+    std::atomic<bool> m_stop;
+
+    // Idle workers sleep on m_wake until tasks are queued
+    QMutex m_sleepMutex;
+    QWaitCondition m_wake;
+};
+
+#endif  //  JOB_SYSTEM_H
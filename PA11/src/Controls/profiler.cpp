@@ -0,0 +1,708 @@
+#include "profiler.h"
+
+#include <QFont>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <algorithm>
+
+std::atomic<int> Profiler::s_drawCalls( 0 );
+std::atomic<int> Profiler::s_triangles( 0 );
+std::atomic<int> Profiler::s_objectsDrawn( 0 );
+std::atomic<int> Profiler::s_objectsCulled( 0 );
+std::atomic<int> Profiler::s_stateCalls( 0 );
+std::atomic<int> Profiler::s_stateSkipped( 0 );
+
+//
+// SCOPE ///////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Starts timing a section until the scope ends.
+ *
+ * @param      profiler  The profiler to record to.
+ * @param[in]  section   The section being timed.
+ */
+Profiler::Scope::Scope( Profiler& profiler, int section )
+    :   m_profiler( profiler ), m_section( section )
+{
+    m_profiler.begin( m_section );
+}
+
+/**
+ * @brief      Stops timing the scope's section.
+ */
+Profiler::Scope::~Scope()
+{
+    m_profiler.end( m_section );
+}
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Profiler.
+ * @details    Keeps the timings of the last historySize frames, which is what
+ * the overlay and the exports report on.
+ *
+ * @param[in]  historySize  The number of frames to keep.
+ */
+Profiler::Profiler( int historySize )
+    :   OverlayVisible( false ), m_history( std::max( historySize, 2 ) ),
+        m_current( 0 ), m_numFrames( 0 ), m_recording( false ),
+        m_activeQuery( -1 )
+{
+    for( int i = 0; i < NUM_QUERIES; i++ )
+    {
+        m_queries[i] = NULL;
+        m_queryFrames[i] = -1;
+    }
+
+    m_clock.start();
+}
+
+/**
+ * @brief      Destructor for Profiler.
+ */
+Profiler::~Profiler()
+{
+    teardownGL();
+}
+
+/**
+ * @brief      Changes how many frames are kept, dropping the recorded ones.
+ *
+ * @param[in]  historySize  The number of frames to keep.
+ */
+void Profiler::setHistorySize( int historySize )
+{
+    m_history.assign( std::max( historySize, 2 ), Frame() );
+    m_current = 0;
+    m_numFrames = 0;
+    m_recording = false;
+
+    for( int i = 0; i < NUM_QUERIES; i++ )
+        m_queryFrames[i] = -1;
+}
+
+/**
+ * @brief      Registers a section to be timed.
+ *
+ * @param[in]  name  The name shown in the overlay and the exports.
+ *
+ * @return     The id to time the section with.
+ */
+int Profiler::addSection( const QString& name )
+{
+    m_sections.append( name );
+    m_openSince.push_back( -1 );
+    return m_sections.size() - 1;
+}
+
+//
+// CPU TIMING //////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Closes the frame being recorded and starts the next one. Called
+ *             once per frame, at the same point each frame.
+ */
+void Profiler::nextFrame()
+{
+    const qint64 now = m_clock.nsecsElapsed();
+
+    if( m_recording )
+    {
+        m_history[m_current].Duration = now - m_history[m_current].Start;
+        m_history[m_current].DrawCalls = s_drawCalls;
+        m_history[m_current].Triangles = s_triangles;
+        m_history[m_current].ObjectsDrawn = s_objectsDrawn;
+        m_history[m_current].ObjectsCulled = s_objectsCulled;
+        m_history[m_current].StateCalls = s_stateCalls;
+        m_history[m_current].StateSkipped = s_stateSkipped;
+        m_current = ( m_current + 1 ) % m_history.size();
+        m_numFrames = std::min<int>( m_numFrames + 1, m_history.size() - 1 );
+    }
+
+    collectGPUTimes();
+
+    // The oldest frame is reused, drop any query still pointing at it
+    for( int i = 0; i < NUM_QUERIES; i++ )
+    {
+        if( m_queryFrames[i] == m_current )
+            m_queryFrames[i] = -1;
+    }
+
+    Frame& frame = m_history[m_current];
+    frame.Start = now;
+    frame.Duration = 0;
+    frame.GPUTime = -1;
+    frame.DrawCalls = 0;
+    frame.Triangles = 0;
+    frame.ObjectsDrawn = 0;
+    frame.ObjectsCulled = 0;
+    frame.StateCalls = 0;
+    frame.StateSkipped = 0;
+    frame.SectionTimes.assign( m_sections.size(), 0 );
+    frame.Events.clear();
+
+    m_recording = true;
+    s_drawCalls = 0;
+    s_triangles = 0;
+    s_objectsDrawn = 0;
+    s_objectsCulled = 0;
+    s_stateCalls = 0;
+    s_stateSkipped = 0;
+}
+
+/**
+ * @brief      Starts timing a section of the current frame.
+ *
+ * @param[in]  section  The section to time.
+ */
+void Profiler::begin( int section )
+{
+    m_openSince[section] = m_clock.nsecsElapsed();
+}
+
+/**
+ * @brief      Stops timing a section and adds it to the current frame. A
+ *             section timed several times in a frame adds up.
+ *
+ * @param[in]  section  The section to stop timing.
+ */
+void Profiler::end( int section )
+{
+    if( !m_recording || m_openSince[section] < 0 )
+        return;
+
+    Event event;
+    event.Section = section;
+    event.Start = m_openSince[section];
+    event.Duration = m_clock.nsecsElapsed() - event.Start;
+    m_openSince[section] = -1;
+
+    Frame& frame = m_history[m_current];
+    frame.SectionTimes[section] += event.Duration;
+    frame.Events.push_back( event );
+}
+
+/**
+ * @brief      Counts a draw call towards the current frame.
+ *
+ * @param[in]  numTriangles  The number of triangles drawn.
+ */
+void Profiler::countDrawCall( int numTriangles )
+{
+    s_drawCalls++;
+    s_triangles += numTriangles;
+}
+
+/**
+ * @brief      Counts the objects a culling pass kept and skipped towards the
+ *             current frame.
+ *
+ * @param[in]  numDrawn   The number of objects found in view.
+ * @param[in]  numCulled  The number of objects skipped.
+ */
+void Profiler::countCulling( int numDrawn, int numCulled )
+{
+    s_objectsDrawn += numDrawn;
+    s_objectsCulled += numCulled;
+}
+
+/**
+ * @brief      Counts the GL state calls made and skipped as redundant towards
+ *             the current frame.
+ *
+ * @param[in]  numIssued   The number of state calls made.
+ * @param[in]  numSkipped  The number of state calls skipped.
+ */
+void Profiler::countStateCalls( int numIssued, int numSkipped )
+{
+    s_stateCalls += numIssued;
+    s_stateSkipped += numSkipped;
+}
+
+//
+// GPU TIMING //////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Creates the GPU timer queries. GPU timing is silently left off
+ *             when the context has no timer query support.
+ */
+void Profiler::initializeGL()
+{
+    for( int i = 0; i < NUM_QUERIES; i++ )
+    {
+        m_queries[i] = new QOpenGLTimerQuery();
+        if( !m_queries[i]->create() )
+        {
+            teardownGL();
+            return;
+        }
+    }
+}
+
+/**
+ * @brief      Starts timing the GPU work of the current frame.
+ */
+void Profiler::beginGPU()
+{
+    if( !m_recording || m_queries[0] == NULL )
+        return;
+
+    for( int i = 0; i < NUM_QUERIES; i++ )
+    {
+        if( m_queryFrames[i] < 0 )
+        {
+            m_activeQuery = i;
+            m_queryFrames[i] = m_current;
+            m_queries[i]->begin();
+            return;
+        }
+    }
+}
+
+/**
+ * @brief      Stops timing the GPU work of the current frame. The result is
+ *             read back once the GPU catches up.
+ */
+void Profiler::endGPU()
+{
+    if( m_activeQuery < 0 )
+        return;
+
+    m_queries[m_activeQuery]->end();
+    m_activeQuery = -1;
+}
+
+/**
+ * @brief      Destroys the GPU timer queries.
+ */
+void Profiler::teardownGL()
+{
+    for( int i = 0; i < NUM_QUERIES; i++ )
+    {
+        delete m_queries[i];
+        m_queries[i] = NULL;
+        m_queryFrames[i] = -1;
+    }
+
+    m_activeQuery = -1;
+}
+
+//
+// REPORTING ///////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Draws the last frames' timings in the corner of an area: the
+ *             average and worst time of each section, and a stacked graph of
+ *             each frame's sections.
+ *
+ * @param      painter  The painter to draw with.
+ * @param[in]  area     The area to draw in.
+ */
+void Profiler::paintOverlay( QPainter& painter, const QRect& area ) const
+{
+    if( !OverlayVisible )
+        return;
+
+    const int GRAPH_FRAMES = 120;
+    const int LINE_HEIGHT = 16;
+    const int GRAPH_HEIGHT = 100;
+    const double GRAPH_MS = 1000.0 / 30.0;
+    const int numSections = m_sections.size();
+    const int numFrames = std::min( GRAPH_FRAMES, m_numFrames );
+
+    // Average and worst times over the graphed frames
+    double frameTotal = 0.0, frameWorst = 0.0, gpuTotal = 0.0;
+    int gpuFrames = 0;
+    std::vector<double> sectionTotal( numSections, 0.0 );
+    std::vector<double> sectionWorst( numSections, 0.0 );
+    for( int age = 0; age < numFrames; age++ )
+    {
+        const Frame& frame = m_history[frameIndex( age )];
+        frameTotal += frame.Duration / 1e6;
+        frameWorst = std::max( frameWorst, frame.Duration / 1e6 );
+
+        if( frame.GPUTime >= 0 )
+        {
+            gpuTotal += frame.GPUTime / 1e6;
+            gpuFrames++;
+        }
+
+        for( unsigned i = 0; i < frame.SectionTimes.size(); i++ )
+        {
+            sectionTotal[i] += frame.SectionTimes[i] / 1e6;
+            sectionWorst[i] = std::max( sectionWorst[i],
+                frame.SectionTimes[i] / 1e6 );
+        }
+    }
+
+    const double frames = std::max( numFrames, 1 );
+    const QRect box( area.left() + 10, area.top() + 10, 360,
+        ( numSections + 6 ) * LINE_HEIGHT + GRAPH_HEIGHT );
+
+    painter.save();
+    painter.fillRect( box, QColor( 0, 0, 0, 160 ) );
+    painter.setFont( QFont( "Consolas", 9 ) );
+    painter.setPen( Qt::white );
+
+    int y = box.top() + LINE_HEIGHT;
+    const int x = box.left() + 8;
+    painter.drawText( x, y, QString( "Frame    %1 ms avg  %2 ms max  %3 fps" )
+        .arg( frameTotal / frames, 6, 'f', 2 )
+        .arg( frameWorst, 6, 'f', 2 )
+        .arg( frameTotal > 0.0 ? 1000.0 * frames / frameTotal : 0.0, 0, 'f', 0 ) );
+    y += LINE_HEIGHT;
+
+    if( gpuFrames > 0 )
+        painter.drawText( x, y, QString( "GPU      %1 ms avg" )
+            .arg( gpuTotal / gpuFrames, 6, 'f', 2 ) );
+    else
+        painter.drawText( x, y, "GPU      n/a" );
+    y += LINE_HEIGHT;
+
+    if( numFrames > 0 )
+    {
+        const Frame& last = m_history[frameIndex( 0 )];
+        painter.drawText( x, y, QString( "Draws    %1 calls  %2 triangles" )
+            .arg( last.DrawCalls ).arg( last.Triangles ) );
+        painter.drawText( x, y + LINE_HEIGHT,
+            QString( "Objects  %1 drawn  %2 culled" )
+            .arg( last.ObjectsDrawn ).arg( last.ObjectsCulled ) );
+        painter.drawText( x, y + 2 * LINE_HEIGHT,
+            QString( "State    %1 calls  %2 skipped" )
+            .arg( last.StateCalls ).arg( last.StateSkipped ) );
+    }
+    y += 3 * LINE_HEIGHT;
+
+    for( int i = 0; i < numSections; i++ )
+    {
+        const QColor color = QColor::fromHsv( ( i * 67 ) % 360, 200, 255 );
+        painter.fillRect( x, y - 9, 9, 9, color );
+        painter.drawText( x + 14, y, QString( "%1 %2 ms avg  %3 ms max" )
+            .arg( m_sections[i], -8 )
+            .arg( sectionTotal[i] / frames, 6, 'f', 2 )
+            .arg( sectionWorst[i], 6, 'f', 2 ) );
+        y += LINE_HEIGHT;
+    }
+
+    // Stacked graph, oldest frame on the left
+    const int graphBottom = box.bottom() - 4;
+    const double barWidth = ( box.width() - 16 ) / double( GRAPH_FRAMES );
+    for( int age = numFrames - 1; age >= 0; age-- )
+    {
+        const Frame& frame = m_history[frameIndex( age )];
+        const double left = box.right() - 8 - ( age + 1 ) * barWidth;
+        double top = graphBottom;
+
+        qint64 other = frame.Duration;
+        for( unsigned i = 0; i < frame.SectionTimes.size(); i++ )
+        {
+            const double height =
+                frame.SectionTimes[i] / 1e6 / GRAPH_MS * GRAPH_HEIGHT;
+            top -= height;
+            painter.fillRect( QRectF( left, top, barWidth, height ),
+                QColor::fromHsv( ( i * 67 ) % 360, 200, 255 ) );
+            other -= frame.SectionTimes[i];
+        }
+
+        const double height = std::max<qint64>( other, 0 ) / 1e6 / GRAPH_MS *
+            GRAPH_HEIGHT;
+        painter.fillRect( QRectF( left, top - height, barWidth, height ),
+            QColor( 128, 128, 128 ) );
+    }
+
+    // 60 fps budget
+    const int budget = graphBottom - GRAPH_HEIGHT / 2;
+    painter.setPen( QColor( 255, 255, 255, 128 ) );
+    painter.drawLine( box.left() + 8, budget, box.right() - 8, budget );
+
+    painter.restore();
+}
+
+/**
+ * @brief      Writes one row per recorded frame, with the time of each section
+ *             in milliseconds.
+ *
+ * @param[in]  path  The path to the CSV file.
+ *
+ * @return     True if the file was written.
+ */
+bool Profiler::exportCSV( const QString& path ) const
+{
+    QSaveFile file( path );
+    if( !file.open( QIODevice::WriteOnly | QIODevice::Text ) )
+        return false;
+
+    QTextStream out( &file );
+    out << "frame,start_ms,frame_ms,gpu_ms,draw_calls,triangles,"
+        << "objects_drawn,objects_culled,state_calls,state_skipped";
+    for( const QString& section : m_sections )
+        out << "," << section;
+    out << "\n";
+
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+    {
+        const Frame& frame = m_history[frameIndex( age )];
+        out << m_numFrames - 1 - age << "," << frame.Start / 1e6 << ","
+            << frame.Duration / 1e6 << ",";
+        if( frame.GPUTime >= 0 )
+            out << frame.GPUTime / 1e6;
+        out << "," << frame.DrawCalls << "," << frame.Triangles << ","
+            << frame.ObjectsDrawn << "," << frame.ObjectsCulled << ","
+            << frame.StateCalls << "," << frame.StateSkipped;
+
+        for( int i = 0; i < m_sections.size(); i++ )
+        {
+            out << ",";
+            if( i < (int)frame.SectionTimes.size() )
+                out << frame.SectionTimes[i] / 1e6;
+        }
+        out << "\n";
+    }
+
+    out.flush();
+    return file.commit();
+}
+
+/**
+ * @brief      Writes the recorded frames in the Chrome trace event format, to
+ *             be opened in chrome://tracing. GPU times are shown on their own
+ *             track, aligned to the start of their frame.
+ *
+ * @param[in]  path  The path to the JSON file.
+ *
+ * @return     True if the file was written.
+ */
+bool Profiler::exportTrace( const QString& path ) const
+{
+    QJsonArray events;
+    auto addEvent = [&events]( const QString& name, int track, qint64 start,
+        qint64 duration ){
+        QJsonObject event;
+        event.insert( "name", name );
+        event.insert( "ph", QString( "X" ) );
+        event.insert( "pid", 0 );
+        event.insert( "tid", track );
+        event.insert( "ts", start / 1e3 );
+        event.insert( "dur", duration / 1e3 );
+        events.append( event );
+    };
+
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+    {
+        const Frame& frame = m_history[frameIndex( age )];
+        addEvent( "Frame", 0, frame.Start, frame.Duration );
+
+        for( const Event& event : frame.Events )
+            addEvent( m_sections[event.Section], 0, event.Start,
+                event.Duration );
+
+        if( frame.GPUTime >= 0 )
+            addEvent( "GPU", 1, frame.Start, frame.GPUTime );
+    }
+
+    QJsonObject trace;
+    trace.insert( "traceEvents", events );
+    trace.insert( "displayTimeUnit", QString( "ms" ) );
+
+    QSaveFile file( path );
+    if( !file.open( QIODevice::WriteOnly ) )
+        return false;
+
+    file.write( QJsonDocument( trace ).toJson( QJsonDocument::Compact ) );
+    return file.commit();
+}
+
+/**
+ * @brief      Gets the number of complete frames recorded.
+ *
+ * @return     The number of frames.
+ */
+int Profiler::numFrames() const
+{
+    return m_numFrames;
+}
+
+/**
+ * @brief      Gets the names of the timed sections, in the order of their ids.
+ *
+ * @return     The section names.
+ */
+const QStringList& Profiler::sections() const
+{
+    return m_sections;
+}
+
+/**
+ * @brief      Gets the duration of each recorded frame.
+ *
+ * @return     The frame times, oldest first.
+ */
+std::vector<double> Profiler::frameTimes() const
+{
+    std::vector<double> times;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+        times.push_back( m_history[frameIndex( age )].Duration / 1e6 );
+    return times;
+}
+
+/**
+ * @brief      Gets the GPU time of each recorded frame that has one.
+ *
+ * @return     The GPU times, oldest first.
+ */
+std::vector<double> Profiler::gpuTimes() const
+{
+    std::vector<double> times;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+    {
+        const Frame& frame = m_history[frameIndex( age )];
+        if( frame.GPUTime >= 0 )
+            times.push_back( frame.GPUTime / 1e6 );
+    }
+    return times;
+}
+
+/**
+ * @brief      Gets the time spent in a section in each recorded frame.
+ *
+ * @param[in]  section  The section.
+ *
+ * @return     The section times, oldest first.
+ */
+std::vector<double> Profiler::sectionTimes( int section ) const
+{
+    std::vector<double> times;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+    {
+        const Frame& frame = m_history[frameIndex( age )];
+        times.push_back( section < (int)frame.SectionTimes.size() ?
+            frame.SectionTimes[section] / 1e6 : 0.0 );
+    }
+    return times;
+}
+
+/**
+ * @brief      Gets the number of draw calls of each recorded frame.
+ *
+ * @return     The draw calls, oldest first.
+ */
+std::vector<double> Profiler::drawCalls() const
+{
+    std::vector<double> calls;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+        calls.push_back( m_history[frameIndex( age )].DrawCalls );
+    return calls;
+}
+
+/**
+ * @brief      Gets the number of triangles drawn in each recorded frame.
+ *
+ * @return     The triangle counts, oldest first.
+ */
+std::vector<double> Profiler::triangles() const
+{
+    std::vector<double> counts;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+        counts.push_back( m_history[frameIndex( age )].Triangles );
+    return counts;
+}
+
+/**
+ * @brief      Gets the number of objects the culling passes kept in each
+ *             recorded frame.
+ *
+ * @return     The objects drawn, oldest first.
+ */
+std::vector<double> Profiler::objectsDrawn() const
+{
+    std::vector<double> counts;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+        counts.push_back( m_history[frameIndex( age )].ObjectsDrawn );
+    return counts;
+}
+
+/**
+ * @brief      Gets the number of objects the culling passes skipped in each
+ *             recorded frame.
+ *
+ * @return     The objects culled, oldest first.
+ */
+std::vector<double> Profiler::objectsCulled() const
+{
+    std::vector<double> counts;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+        counts.push_back( m_history[frameIndex( age )].ObjectsCulled );
+    return counts;
+}
+
+/**
+ * @brief      Gets the number of GL state calls made in each recorded frame.
+ *
+ * @return     The state calls, oldest first.
+ */
+std::vector<double> Profiler::stateCalls() const
+{
+    std::vector<double> counts;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+        counts.push_back( m_history[frameIndex( age )].StateCalls );
+    return counts;
+}
+
+/**
+ * @brief      Gets the number of redundant GL state calls skipped in each
+ *             recorded frame.
+ *
+ * @return     The state calls skipped, oldest first.
+ */
+std::vector<double> Profiler::stateSkipped() const
+{
+    std::vector<double> counts;
+    for( int age = m_numFrames - 1; age >= 0; age-- )
+        counts.push_back( m_history[frameIndex( age )].StateSkipped );
+    return counts;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets where a recorded frame is kept in the history.
+ *
+ * @param[in]  age   How many frames ago it was recorded, 0 being the last
+ *                   complete frame.
+ *
+ * @return     The frame's index in the history.
+ */
+int Profiler::frameIndex( int age ) const
+{
+    const int size = m_history.size();
+    return ( ( m_current - 1 - age ) % size + size ) % size;
+}
+
+/**
+ * @brief      Reads back every timer query the GPU has finished.
+ */
+void Profiler::collectGPUTimes()
+{
+    for( int i = 0; i < NUM_QUERIES; i++ )
+    {
+        if( m_queryFrames[i] < 0 || i == m_activeQuery ||
+            !m_queries[i]->isResultAvailable() )
+            continue;
+
+        m_history[m_queryFrames[i]].GPUTime = m_queries[i]->waitForResult();
+        m_queryFrames[i] = -1;
+    }
+}
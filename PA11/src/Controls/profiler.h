@@ -0,0 +1,124 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QElapsedTimer>
+#include <QOpenGLTimerQuery>
+#include <QPainter>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <vector>
+
+class Profiler
+{
+public:
+    // Times a section for as long as the scope is alive
+    class Scope
+    {
+    public:
+        Scope( Profiler& profiler, int section );
+        ~Scope();
+
+    private:
+        Profiler& m_profiler;
+        int m_section;
+    };
+
+    Profiler( int historySize = 600 );
+    ~Profiler();
+
+    int addSection( const QString& name );
+    void setHistorySize( int historySize );
+
+    // CPU timing
+    void nextFrame();
+    void begin( int section );
+    void end( int section );
+
+    // Called by renderables after each draw, by the culling passes, and by
+    // the render queue once it has set the frame's GL state
+    static void countDrawCall( int numTriangles );
+    static void countCulling( int numDrawn, int numCulled );
+    static void countStateCalls( int numIssued, int numSkipped );
+
+    // GPU timing, requires a current context
+    void initializeGL();
+    void beginGPU();
+    void endGPU();
+    void teardownGL();
+
+    // Reporting
+    void paintOverlay( QPainter& painter, const QRect& area ) const;
+    bool exportCSV( const QString& path ) const;
+    bool exportTrace( const QString& path ) const;
+
+    // Recorded frames, oldest first, in milliseconds
+    int numFrames() const;
+    const QStringList& sections() const;
+    std::vector<double> frameTimes() const;
+    std::vector<double> gpuTimes() const;
+    std::vector<double> sectionTimes( int section ) const;
+    std::vector<double> drawCalls() const;
+    std::vector<double> triangles() const;
+    std::vector<double> objectsDrawn() const;
+    std::vector<double> objectsCulled() const;
+    std::vector<double> stateCalls() const;
+    std::vector<double> stateSkipped() const;
+
+    bool OverlayVisible;
+
+private:
+    struct Event
+    {
+        int Section;
+        qint64 Start;
+        qint64 Duration;
+    };
+
+    struct Frame
+    {
+        qint64 Start;
+        qint64 Duration;
+        qint64 GPUTime;
+        int DrawCalls;
+        int Triangles;
+        int ObjectsDrawn;
+        int ObjectsCulled;
+        int StateCalls;
+        int StateSkipped;
+        std::vector<qint64> SectionTimes;
+        std::vector<Event> Events;
+    };
+
+    int frameIndex( int age ) const;
+    void collectGPUTimes();
+
+    QElapsedTimer m_clock;
+    QStringList m_sections;
+    std::vector<qint64> m_openSince;
+
+    // Ring buffer of recorded frames, m_current is still being recorded
+    std::vector<Frame> m_history;
+    int m_current;
+    int m_numFrames;
+    bool m_recording;
+
+    // Timer queries are read back a few frames late to avoid stalling
+    static const int NUM_QUERIES = 4;
+    QOpenGLTimerQuery* m_queries[NUM_QUERIES];
+    int m_queryFrames[NUM_QUERIES];
+    int m_activeQuery;
+
+    // Draws since the last frame started, shared by every renderable and
+    // atomic as they may be drawn on another thread
+    static std::atomic<int> s_drawCalls;
+    static std::atomic<int> s_triangles;
+    static std::atomic<int> s_objectsDrawn;
+    static std::atomic<int> s_objectsCulled;
+    static std::atomic<int> s_stateCalls;
+    static std::atomic<int> s_stateSkipped;
+};
+
+#endif  //  PROFILER_H
@@ -9,6 +9,7 @@
 
 #include "3D/renderable.h"
 #include "3D/modelLoader.h"
+#include "3D/resourceCache.h"
 #include "3D/transform3d.h"
 #include "3D/colorVertex.h"
 
@@ -23,26 +24,32 @@ protected:
 
     // Renderable Functions
     void initializeGL();
-    void paintGL( Camera3D& camera, QMatrix4x4& projection );
+    void submit( RenderQueue& queue );
     virtual void update();
     void teardownGL();
+    bool worldBounds( Bounds& bounds );
+
+    RenderQueue::Item drawItem( const QMatrix4x4& modelToWorld ) const;
 
     // OpenGL State Data
-    QOpenGLBuffer* m_vbo;
+    QSharedPointer<ResourceCache::MeshBuffers> m_buffers;
     QOpenGLVertexArrayObject* m_vao;
-    QOpenGLShaderProgram* m_program;
+    QSharedPointer<QOpenGLShaderProgram> m_program;
 
     // Model Information
     QString m_pathToModel;
-    ColorVertex* m_model;
-    int m_numVertices;
+    QSharedPointer<ColorMesh> m_mesh;
+    bool m_keepMesh;
+
+    // Bounds of the mesh in model space and the faces it culls, kept after
+    // the mesh is released
+    Bounds m_bounds;
+    GLenum m_cullFace;
 
     // Shader Information
     const QString PATH_TO_V_SHADER = ":/shader/colorShader.vs";
     const QString PATH_TO_F_SHADER = ":/shader/colorShader.fs";
-    int m_modelWorld;
-    int m_worldEye;
-    int m_eyeClip;
+    int m_modelClip;
 };
 
 #endif  //  ColorEntity
\ No newline at end of file
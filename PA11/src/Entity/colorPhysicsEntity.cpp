@@ -13,9 +13,12 @@
  */
 ColorPhysicsEntity::ColorPhysicsEntity( btTransform startingState, 
     btScalar mass, QString pathToModel )
-    : ColorEntity( pathToModel ), m_mass( mass )
+    : ColorEntity( pathToModel ), m_mass( mass ),
+        m_state( startingState )
 {
-    ModelLoader::loadTriMesh( pathToModel, m_triMesh );
+    // Collide against the mesh ColorEntity already loaded instead of reimporting
+    m_keepMesh = true;
+    m_triMesh = ModelLoader::createTriMesh( *m_mesh );
 
     // The object is static, so use BvhTriMesh
     if( mass == 0 )
@@ -58,39 +61,46 @@ ColorPhysicsEntity::~ColorPhysicsEntity()
 }
 
 /**
- * @brief      Overloaded paintGL function.
+ * @brief      Overloaded submit function.
  * @details    Draws using a BTransform instead of a GTransform.
  *
- * @param      camera      The camera of the world.
- * @param      projection  The projection of the world.
+ * @param      queue  The queue of the frame.
  */
-void ColorPhysicsEntity::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void ColorPhysicsEntity::submit( RenderQueue& queue )
 {
-    m_program->bind();
-
-    m_program->setUniformValue( m_worldEye, camera.toMatrix() );
-    m_program->setUniformValue( m_eyeClip, projection );
-
-    m_vao->bind();
-
-    m_program->setUniformValue( m_modelWorld, BTransform );
-
-    glDrawArrays( GL_TRIANGLES, 0, m_numVertices );
-
-
-    m_vao->release();
-    m_program->release();
+    queue.submit( drawItem( BTransform ) );
 }
 
 /**
- * @brief      Updates the RigidBody based on the dynamics world it is in.
+ * @brief      Records the RigidBody's state after a step of the dynamics world
+ *             it is in.
  */
 void ColorPhysicsEntity::update()
 {
-    btScalar rawMatrix[16];
-    RigidBody->getWorldTransform().getOpenGLMatrix( rawMatrix );
+    m_state.record( RigidBody->getWorldTransform() );
+    BTransform = m_state.current();
+}
 
-    QMatrix4x4 newMatrix = QMatrix4x4( rawMatrix ).transposed();
+/**
+ * @brief      Places the object between its last two recorded states.
+ *
+ * @param[in]  alpha  How far the frame is between the two states, from 0 to 1.
+ */
+void ColorPhysicsEntity::interpolate( float alpha )
+{
+    BTransform = m_state.interpolate( alpha );
+}
 
-    BTransform = newMatrix;
-}
\ No newline at end of file
+/**
+ * @brief      Overloaded worldBounds function.
+ * @details    Places the bounds with the BTransform rather than the GTransform.
+ *
+ * @param[out] bounds  The world space bounds.
+ *
+ * @return     True, the object can always be culled.
+ */
+bool ColorPhysicsEntity::worldBounds( Bounds& bounds )
+{
+    bounds = m_bounds.transformed( BTransform );
+    return true;
+}
@@ -4,6 +4,8 @@
 #include "colorEntity.h"
 #include <btBulletDynamicsCommon.h>
 
+#include "physicsState.h"
+
 class ColorPhysicsEntity     :   public ColorEntity
 {
 public:
@@ -16,18 +18,23 @@ protected:
     ~ColorPhysicsEntity();
 
     // Renderable Functions
-    void paintGL( Camera3D& camera, QMatrix4x4& projection );
+    void submit( RenderQueue& queue );
     void update();
+    void interpolate( float alpha );
+    bool worldBounds( Bounds& bounds );
 
 private:
     // Bullet Information
-    btTriangleMesh* m_triMesh;
+    btTriangleIndexVertexArray* m_triMesh;
     btCollisionShape* m_collisionShape;
 
     btDefaultMotionState* m_motionState;
     btVector3 m_inertia;
     btScalar m_mass;
     btRigidBody::btRigidBodyConstructionInfo* m_rigidBodyCI;
+
+    // Last two fixed step states, blended when drawing
+    PhysicsState m_state;
 };
 
 #endif  //  COLOR_PHYSICS_ENTITY
\ No newline at end of file
@@ -11,9 +11,12 @@
  * @param[in]  pathToTexture  The path to this object's texture.
  */
 UVEntity::UVEntity( QString pathToModel, QString pathToTexture )
-    :   m_pathToModel( pathToModel ), m_pathToTexture( pathToTexture )
+    :   m_vao( NULL ), m_pathToModel( pathToModel ), m_keepMesh( false ),
+        m_pathToTexture( pathToTexture )
 {
-    ModelLoader::loadUVModel( m_pathToModel, m_model, m_numVertices );
+    m_mesh = ResourceCache::uvMesh( m_pathToModel );
+    m_bounds = m_mesh->Box;
+    m_cullFace = m_mesh->CullFace;
 }
 
 /**
@@ -35,36 +38,26 @@ void UVEntity::initializeGL()
 {
     initializeOpenGLFunctions();
 
-    // Create the shader this entity will use
-    m_program = new QOpenGLShaderProgram();
-    m_program->addShaderFromSourceFile( QOpenGLShader::Vertex, 
-        PATH_TO_V_SHADER );
-    m_program->addShaderFromSourceFile( QOpenGLShader::Fragment, 
-        PATH_TO_F_SHADER );
-    m_program->link();
+    // Get the shader this entity will use
+    m_program = ResourceCache::program( PATH_TO_V_SHADER, PATH_TO_F_SHADER );
     m_program->bind();
 
-    // Cache the Uniform Locations
-    m_modelWorld = m_program->uniformLocation( "model_to_world" );
-    m_worldEye = m_program->uniformLocation( "world_to_eye" );
-    m_eyeClip = m_program->uniformLocation( "eye_to_clip" );
+    // Cache the Uniform Location
+    m_modelClip = m_program->uniformLocation( "model_to_clip" );
 
-    // Create the Texture Buffer Object
-    m_texture = new QOpenGLTexture( QImage( m_pathToTexture ).mirrored() );
-    m_texture->setMinificationFilter( QOpenGLTexture::LinearMipMapLinear );
-    m_texture->setMagnificationFilter( QOpenGLTexture::Linear );
+    // Get the Texture Buffer Object
+    m_texture = ResourceCache::texture( m_pathToTexture );
 
-    // Create the Vertex Buffer Object
-    m_vbo = new QOpenGLBuffer();
-    m_vbo->create();
-    m_vbo->bind();
-    m_vbo->setUsagePattern( QOpenGLBuffer::StaticDraw );
-    m_vbo->allocate( m_model, m_numVertices * sizeof( m_model[0] ) );
+    // Get the Vertex and Index Buffer Objects
+    m_buffers = ResourceCache::uvBuffers( m_pathToModel );
+    m_buffers->Vertices.bind();
 
-    // Create the Vertex Array Object
+    // Create the Vertex Array Object, bound while it records the buffers
     m_vao = new QOpenGLVertexArrayObject();
     m_vao->create();
     m_vao->bind();
+    m_buffers->Indices.bind();
+
     m_program->enableAttributeArray( 0 );
     m_program->enableAttributeArray( 1 );
     m_program->setAttributeBuffer(  0,
@@ -80,39 +73,47 @@ void UVEntity::initializeGL()
 
     // Release all in order
     m_vao->release();
-    m_vbo->release();
+    m_buffers->Indices.release();
+    m_buffers->Vertices.release();
     m_texture->release();
     m_program->release();
+
+    // The GPU owns the geometry now, unless a collision mesh still reads it
+    if( !m_keepMesh )
+        m_mesh.clear();
 }
 
 /**
- * @brief      Draws the object to the screen.
+ * @brief      Queues the object to be drawn where it is.
  *
- * @param      camera      The camera of the world.
- * @param      projection  The projection of the world.
+ * @param      queue  The queue of the frame.
  */
-void UVEntity::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void UVEntity::submit( RenderQueue& queue )
 {
-    glEnable( GL_DEPTH_TEST );
-    glDepthFunc( GL_LEQUAL );
-    glDepthMask( GL_TRUE );
-    glDisable( GL_CULL_FACE );
-
-    m_program->bind();
-
-    m_program->setUniformValue( m_worldEye, camera.toMatrix() );
-    m_program->setUniformValue( m_eyeClip, projection );
-
-    m_vao->bind();
-    m_texture->bind();
-
-    m_program->setUniformValue( m_modelWorld, GTransform.toMatrix() );
-
-    glDrawArrays( GL_TRIANGLES, 0, m_numVertices );
+    queue.submit( drawItem( GTransform.toMatrix() ) );
+}
 
-    m_texture->release();
-    m_vao->release();
-    m_program->release();
+/**
+ * @brief      Describes a draw of the object's mesh.
+ *
+ * @param[in]  modelToWorld  Where to draw the object.
+ *
+ * @return     The draw to queue.
+ */
+RenderQueue::Item UVEntity::drawItem( const QMatrix4x4& modelToWorld ) const
+{
+    RenderQueue::Item item;
+    item.Program = m_program.data();
+    item.VAO = m_vao;
+    item.Texture = m_texture.data();
+    item.CullFace = m_cullFace;
+    item.ModelClip = m_modelClip;
+    item.Transform = modelToWorld;
+    item.Center = modelToWorld.map( m_bounds.center() );
+    item.Count = m_buffers->NumIndices;
+    item.IndexType = m_buffers->IndexType;
+
+    return item;
 }
 
 /**
@@ -127,9 +128,24 @@ void UVEntity::update()
  */
 void UVEntity::teardownGL()
 {
-    delete m_vbo;
     delete m_vao;
-    delete m_program;
-    delete m_model;
-    delete m_texture;
-}
\ No newline at end of file
+    m_vao = NULL;
+
+    // Shared resources are freed once their last user lets go of them
+    m_buffers.clear();
+    m_program.clear();
+    m_texture.clear();
+}
+
+/**
+ * @brief      Gets the bounds of the object where it is drawn.
+ *
+ * @param[out] bounds  The world space bounds.
+ *
+ * @return     True, the object can always be culled.
+ */
+bool UVEntity::worldBounds( Bounds& bounds )
+{
+    bounds = m_bounds.transformed( GTransform.toMatrix() );
+    return true;
+}
@@ -14,21 +14,28 @@
  */
 UVPhysicsEntity::UVPhysicsEntity( btTransform startingState, btScalar mass,
     QString pathToModel, QString pathToTexture )
-    : UVEntity( pathToModel, pathToTexture ), m_mass( mass )
+    : UVEntity( pathToModel, pathToTexture ), m_mass( mass ),
+        m_state( startingState )
 {
-    ModelLoader::loadTriMesh( pathToModel, m_triMesh );
-
-    // The object is static, so use BvhTriMesh
+    // The object is static, so use BvhTriMesh over the mesh UVEntity already
+    // loaded rather than importing the model a second time
     if( mass == 0 )
+    {
+        m_keepMesh = true;
+        m_triMesh = ModelLoader::createTriMesh( *m_mesh );
         m_collisionShape = new btBvhTriangleMeshShape( m_triMesh, true );
+    }
 
     // The object is dynamic, so use ConvexTriMesh
     else
+    {
         // sphere is being used instead of convex triangle for more optimized collision calculations
         // set radius of the sphere to 0.5, the model that's being used is actually 0.5 scaled too
+        m_triMesh = NULL;
         m_collisionShape = new btSphereShape( 0.5 );
         // todo: Have a way to do this still:
         // m_collisionShape = new btConvexTriangleMeshShape( m_triMesh );
+    }
 
     m_motionState = new btDefaultMotionState( startingState );
 
@@ -67,40 +74,46 @@ UVPhysicsEntity::~UVPhysicsEntity()
 }
 
 /**
- * @brief      Overloaded paintGL function.
- * @details    Draws using a BTransform rather than a GTrasform.
+ * @brief      Overloaded submit function.
+ * @details    Draws using a BTransform rather than a GTransform.
  *
- * @param      camera      The camera of the world.
- * @param      projection  The projection of the world.
+ * @param      queue  The queue of the frame.
  */
-void UVPhysicsEntity::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void UVPhysicsEntity::submit( RenderQueue& queue )
 {
-    m_program->bind();
-
-    m_program->setUniformValue( m_worldEye, camera.toMatrix() );
-    m_program->setUniformValue( m_eyeClip, projection );
-
-    m_vao->bind();
-    m_texture->bind();
-
-    m_program->setUniformValue( m_modelWorld, BTransform );
-
-    glDrawArrays( GL_TRIANGLES, 0, m_numVertices );
-
-    m_texture->release();
-    m_vao->release();
-    m_program->release();
+    queue.submit( drawItem( BTransform ) );
 }
 
 /**
- * @brief      Updates the RigidBody based on the dynamics world it is in.
+ * @brief      Records the RigidBody's state after a step of the dynamics world
+ *             it is in.
  */
 void UVPhysicsEntity::update()
 {
-    btScalar rawMatrix[16];
-    RigidBody->getWorldTransform().getOpenGLMatrix( rawMatrix );
+    m_state.record( RigidBody->getWorldTransform() );
+    BTransform = m_state.current();
+}
 
-    QMatrix4x4 newMatrix = QMatrix4x4( rawMatrix ).transposed();
+/**
+ * @brief      Places the object between its last two recorded states.
+ *
+ * @param[in]  alpha  How far the frame is between the two states, from 0 to 1.
+ */
+void UVPhysicsEntity::interpolate( float alpha )
+{
+    BTransform = m_state.interpolate( alpha );
+}
 
-    BTransform = newMatrix;
-}
\ No newline at end of file
+/**
+ * @brief      Overloaded worldBounds function.
+ * @details    Places the bounds with the BTransform rather than the GTransform.
+ *
+ * @param[out] bounds  The world space bounds.
+ *
+ * @return     True, the object can always be culled.
+ */
+bool UVPhysicsEntity::worldBounds( Bounds& bounds )
+{
+    bounds = m_bounds.transformed( BTransform );
+    return true;
+}
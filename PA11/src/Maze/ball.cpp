@@ -14,3 +14,16 @@ Ball::Ball( const float x, const float y, const float z, bool isBoulder )
         )
 {
 }
+
+
+/**
+ * @brief      Queues the model and both textures a ball may use.
+ *
+ * @param      loader  The loader to queue the assets on.
+ */
+void Ball::queueAssets( AssetLoader& loader )
+{
+    loader.addUVModel( "models/UVSphere50.obj" );
+    loader.addTexture( "textures/Sphere_Boulder.jpg" );
+    loader.addTexture( "textures/Sphere_Snowball.jpg" );
+}
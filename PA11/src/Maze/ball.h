@@ -1,12 +1,15 @@
 #ifndef BALL_H
 #define BALL_H
 
+#include "3D/assetLoader.h"
 #include "Entity/uvPhysicsEntity.h"
 
 class Ball    :   public UVPhysicsEntity
 {
 public:
     Ball( const float x = 2.0f, const float y = 5.0f, const float z = 10.0f, bool isBoulder = true );
+
+    static void queueAssets( AssetLoader& loader );
 };
 
 #endif  //  BALL_H
\ No newline at end of file
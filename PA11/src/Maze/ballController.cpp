@@ -0,0 +1,59 @@
+#include "ballController.h"
+
+#include <cmath>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for a disabled BallController.
+ *
+ * @param      body      The ball to steer.
+ * @param[in]  cellSize  The distance between two cells of the maze.
+ */
+BallController::BallController( btRigidBody* body, float cellSize )
+    :   Enabled( false ), m_body( body ), m_cellSize( cellSize )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Pushes the ball one tick's worth towards the goal. Called before
+ *             every step of the dynamics world, which clears the force.
+ *
+ * @param[in]  field    The distances to the goal.
+ * @param[in]  originX  The x cell of the maze the field starts at.
+ * @param[in]  originZ  The z cell of the maze the field starts at.
+ */
+void BallController::steer( const DistanceField& field, int originX,
+    int originZ )
+{
+    if( !Enabled )
+        return;
+
+    const btVector3 position = m_body->getCenterOfMassPosition();
+    const int x = std::floor( position.x() / m_cellSize + 0.5f ) - originX;
+    const int z = std::floor( position.z() / m_cellSize + 0.5f ) - originZ;
+    if( field.distance( x, z ) == DistanceField::UNREACHABLE )
+        return;
+
+    // Head for the goal's own center once there, so the ball drops in
+    DistanceField::Step next( x, z );
+    field.nextStep( x, z, next );
+
+    const btVector3 target( ( next.first + originX ) * m_cellSize,
+        position.y(), ( next.second + originZ ) * m_cellSize );
+    btVector3 velocity = m_body->getLinearVelocity();
+    velocity.setY( 0 );
+
+    btVector3 force = ( target - position ) * STIFFNESS - velocity * DAMPING;
+    if( force.length() > MAX_FORCE )
+        force *= MAX_FORCE / force.length();
+
+    m_body->activate();
+    m_body->applyCentralForce( force );
+}
@@ -0,0 +1,34 @@
+#ifndef BALL_CONTROLLER_H
+#define BALL_CONTROLLER_H
+
+#include <btBulletDynamicsCommon.h>
+
+#include "Maze/distanceField.h"
+
+/**
+ * @brief      Rolls a ball to the goal of a DistanceField on its own.
+ * @details    Every tick the ball is pushed towards the center of the next
+ * cell on its way, with some damping so it slows down for the corners rather
+ * than bouncing off them.
+ */
+class BallController
+{
+public:
+    BallController( btRigidBody* body, float cellSize );
+
+    void steer( const DistanceField& field, int originX, int originZ );
+
+    bool Enabled;
+
+private:
+    // Pull towards the next cell per unit of distance, and the damping of
+    // the ball's own velocity
+    const float STIFFNESS = 4.0f;
+    const float DAMPING = 2.0f;
+    const float MAX_FORCE = 12.0f;
+
+    btRigidBody* m_body;
+    float m_cellSize;
+};
+
+#endif  //  BALL_CONTROLLER_H
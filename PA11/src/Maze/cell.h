@@ -1,22 +1,8 @@
 #ifndef CELL_H
 #define CELL_H
 
-#include <QOpenGLFunctions>
-#include <QOpenGLBuffer>
-#include <QOpenGLVertexArrayObject>
-#include <QOpenGLTexture>
-#include <QOpenGLShaderProgram>
-
-#include <QMatrix4x4>
-#include <QString>
-
 #include <btBulletDynamicsCommon.h>
 
-#include "3D/renderable.h"
-#include "3D/modelLoader.h"
-#include "3D/uvVertex.h"
-#include "Controls/camera3d.h"
-
 enum Texture
 {
     RockWall1,
@@ -30,59 +16,29 @@ enum Texture
     IceWall3,
     IceWall4,
     IceWall5,
-    SnowFloor
+    SnowFloor,
+    TextureCount
 };
 
-class Cell  :   public Renderable
+/**
+ * @brief      A single cube of the labyrinth. It is drawn by GreedyMesher and
+ *             collided with by LabyrinthCollision, along with every other cube.
+ */
+class Cell
 {
 public:
-    Cell( btTransform startingState, Texture selectedTexture );
-    ~Cell();
+    Cell( btVector3 location, Texture selectedTexture );
 
-    void initializeGL();
-    void paintGL( Camera3D& camera, QMatrix4x4& projection );
-    void update();
-    void teardownGL();
+    Texture selectedTexture() const;
 
     static Texture getRandomRockWall();
     static Texture getRandomIceWall();
 
-    btRigidBody* RigidBody;
-    QMatrix4x4 Transform;
+    btVector3 Location;
 
 private:
-    // OpenGL State Data
-    static QOpenGLBuffer* m_vbo;
-    static QOpenGLVertexArrayObject* m_vao;
-    static QOpenGLShaderProgram* m_program;
-
-    // Model Information
-    const QString PATH_TO_MODEL = "models/UVCube.obj";
-    static UVVertex* m_model;
-    static int m_numVertices;
-
     // Texture Information
     Texture m_selectedTexture;
-    static QOpenGLTexture* m_rockWallTexture[5];
-    static QOpenGLTexture* m_dirtFloorTexture;
-    static QOpenGLTexture* m_iceWallTexture[5];
-    static QOpenGLTexture* m_snowFloorTexture;
-
-    // Shader Information
-    const QString PATH_TO_V_SHADER = ":/shader/uvShader.vs";
-    const QString PATH_TO_F_SHADER = ":/shader/uvShader.fs";
-    static int m_modelWorld;
-    static int m_worldEye;
-    static int m_eyeClip;
-
-    // Bullet Information
-    static btTriangleMesh* m_triMesh;
-    static btCollisionShape* m_collisionShape;
-
-    btDefaultMotionState* m_motionState;
-    btVector3 m_inertia;
-    const btScalar MASS = 0;
-    btRigidBody::btRigidBodyConstructionInfo* m_rigidBodyCI;
 };
 
 #endif  //  CELL_H
\ No newline at end of file
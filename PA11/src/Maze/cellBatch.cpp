@@ -0,0 +1,249 @@
+#include "cellBatch.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for CellBatch.
+ *
+ * @param[in]  texture  The texture shared by every cell in this batch.
+ * @param[in]  face     The direction every quad in this batch faces.
+ */
+CellBatch::CellBatch( Texture texture, GreedyMesher::Face face )
+    :   m_vbo( NULL ), m_ibo( NULL ), m_vao( NULL ), m_numQuads( 0 ),
+        m_numIndices( 0 ), m_indexType( GL_UNSIGNED_SHORT ),
+        m_selectedTexture( texture ), m_face( face )
+{
+}
+
+/**
+ * @brief      Destructor for CellBatch.
+ */
+CellBatch::~CellBatch()
+{
+    teardownGL();
+}
+
+//
+// BATCH FUNCTIONS /////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Bakes a merged labyrinth face into the batch. Must be called
+ *             before initializeGL, with a quad of the batch's texture and
+ *             direction.
+ *
+ * @param[in]  quad  The face to add.
+ */
+void CellBatch::addQuad( const GreedyMesher::Quad& quad )
+{
+    // The texture repeats once per cell covered
+    const GLuint baseVertex = m_batch.Vertices.size();
+    const QVector2D tiles[4] = { QVector2D( 0, 0 ),
+        QVector2D( quad.Tiles.x(), 0 ), quad.Tiles,
+        QVector2D( 0, quad.Tiles.y() ) };
+
+    for( int i = 0; i < 4; i++ )
+    {
+        m_batch.Vertices.push_back( UVVertex( quad.Corners[i], tiles[i] ) );
+        m_bounds.expand( quad.Corners[i] );
+    }
+
+    const GLuint indices[6] = { 0, 1, 2, 0, 2, 3 };
+    for( GLuint index : indices )
+        m_batch.Indices.push_back( baseVertex + index );
+
+    m_numQuads++;
+}
+
+/**
+ * @brief      Gets the number of quads baked into this batch.
+ *
+ * @return     The number of quads.
+ */
+int CellBatch::numQuads() const
+{
+    return m_numQuads;
+}
+
+/**
+ * @brief      Gets the box around every quad of the batch. The quads are baked
+ *             in world space, so it is the batch's world bounds.
+ *
+ * @return     The bounds of the batch.
+ */
+const Bounds& CellBatch::bounds() const
+{
+    return m_bounds;
+}
+
+//
+// RENDERABLE FUNCTIONS ////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Uploads the baked geometry and loads the batch's texture.
+ */
+void CellBatch::initializeGL()
+{
+    initializeOpenGLFunctions();
+
+    // Get the shader every batch shares
+    m_program = ResourceCache::program( PATH_TO_V_SHADER, PATH_TO_F_SHADER );
+    m_program->bind();
+
+    // Cache the Uniform Location
+    m_modelClip = m_program->uniformLocation( "model_to_clip" );
+
+    // Get the Texture Buffer Object of the batch's face
+    m_texture = ResourceCache::texture( texturePath( m_selectedTexture ),
+        GreedyMesher::atlasRegion( m_face ) );
+
+    // Create the Vertex Buffer Object
+    m_vbo = new QOpenGLBuffer();
+    m_vbo->create();
+    m_vbo->bind();
+    m_vbo->setUsagePattern( QOpenGLBuffer::StaticDraw );
+    m_vbo->allocate( m_batch.Vertices.data(),
+        m_batch.Vertices.size() * sizeof( UVVertex ) );
+
+    // Create the Vertex Array Object
+    m_vao = new QOpenGLVertexArrayObject();
+    m_vao->create();
+    m_vao->bind();
+
+    // Create the Index Buffer Object, bound while the VAO records it
+    m_numIndices = m_batch.Indices.size();
+    m_indexType = m_batch.indexType();
+    m_ibo = new QOpenGLBuffer( QOpenGLBuffer::IndexBuffer );
+    m_ibo->create();
+    m_ibo->bind();
+    m_ibo->setUsagePattern( QOpenGLBuffer::StaticDraw );
+    m_ibo->allocate( m_batch.packedIndices().constData(),
+        m_numIndices * m_batch.indexSize() );
+
+    m_program->enableAttributeArray( "position" );
+    m_program->enableAttributeArray( "texture" );
+    m_program->setAttributeBuffer(  "position",
+                                    GL_FLOAT,
+                                    UVVertex::positionOffset(),
+                                    UVVertex::PositionTupleSize,
+                                    UVVertex::stride() );
+    m_program->setAttributeBuffer(  "texture",
+                                    GL_FLOAT,
+                                    UVVertex::uvOffset(),
+                                    UVVertex::UVTupleSize,
+                                    UVVertex::stride() );
+
+    // Release all in order
+    m_vao->release();
+    m_ibo->release();
+    m_vbo->release();
+    m_texture->release();
+    m_program->release();
+
+    // The GPU owns the geometry now
+    m_batch.clear();
+}
+
+/**
+ * @brief      Queues every cell in the batch as a single draw. The quads wind
+ *             outwards, so their back faces are culled.
+ *
+ * @param      queue  The queue of the frame.
+ */
+void CellBatch::submit( RenderQueue& queue )
+{
+    RenderQueue::Item item;
+    item.Program = m_program.data();
+    item.VAO = m_vao;
+    item.Texture = m_texture.data();
+    item.ModelClip = m_modelClip;
+    item.Center = m_bounds.center();
+    item.Count = m_numIndices;
+    item.IndexType = m_indexType;
+    queue.submit( item );
+}
+
+/**
+ * @brief      Cells are static, there is nothing to update.
+ */
+void CellBatch::update()
+{
+}
+
+/**
+ * @brief      Helper function to delete OpenGL data.
+ */
+void CellBatch::teardownGL()
+{
+    delete m_vbo;
+    delete m_ibo;
+    delete m_vao;
+
+    m_vbo = NULL;
+    m_ibo = NULL;
+    m_vao = NULL;
+
+    // Shared resources are freed once their last user lets go of them
+    m_program.clear();
+    m_texture.clear();
+}
+
+//
+// STATIC HELPERS //////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the image file backing a cell texture.
+ *
+ * @param[in]  texture  The cell texture.
+ *
+ * @return     The path to the texture's image.
+ */
+QString CellBatch::texturePath( Texture texture )
+{
+    switch( texture )
+    {
+        case Texture::RockWall1:
+            return "textures/Cube_RockWall1.jpg";
+        case Texture::RockWall2:
+            return "textures/Cube_RockWall2.jpg";
+        case Texture::RockWall3:
+            return "textures/Cube_RockWall3.jpg";
+        case Texture::RockWall4:
+            return "textures/Cube_RockWall4.jpg";
+        case Texture::RockWall5:
+            return "textures/Cube_RockWall5.jpg";
+        case Texture::DirtFloor:
+            return "textures/Cube_DirtFloor.jpg";
+        case Texture::IceWall1:
+            return "textures/Cube_IceWall1.jpg";
+        case Texture::IceWall2:
+            return "textures/Cube_IceWall2.jpg";
+        case Texture::IceWall3:
+            return "textures/Cube_IceWall3.jpg";
+        case Texture::IceWall4:
+            return "textures/Cube_IceWall4.jpg";
+        case Texture::IceWall5:
+            return "textures/Cube_IceWall5.jpg";
+        case Texture::SnowFloor:
+        default:
+            return "textures/Cube_SnowFloor.jpg";
+    }
+}
+
+/**
+ * @brief      Gets where the batch of a texture and direction goes in a list of
+ *             batches with room for every pair.
+ *
+ * @param[in]  texture  The cell texture.
+ * @param[in]  face     The direction of the quads.
+ *
+ * @return     The index of the batch.
+ */
+int CellBatch::index( Texture texture, GreedyMesher::Face face )
+{
+    return texture * GreedyMesher::FaceCount + face;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef CELL_BATCH_H
+#define CELL_BATCH_H
+
+#include <QOpenGLFunctions>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QOpenGLTexture>
+#include <QOpenGLShaderProgram>
+
+#include <QMatrix4x4>
+#include <QString>
+
+#include "3D/bounds.h"
+#include "3D/renderable.h"
+#include "3D/resourceCache.h"
+#include "3D/mesh.h"
+#include "Controls/camera3d.h"
+#include "Maze/cell.h"
+#include "Maze/greedyMesher.h"
+
+/**
+ * @brief      Draws every quad sharing a Texture and facing the same way with a
+ *             single draw call.
+ * @details    Cells are static, so the labyrinth's merged faces are baked into
+ * one world space vertex and index buffer at load time. The target context is
+ * OpenGL 2.1, which has no instanced drawing, so this batch stands in for it.
+ *
+ * Each face of a cube texture is its own repeating texture, so a quad covering
+ * several cells tiles it with GL_REPEAT. Sampling one region of the whole
+ * cross instead breaks the mip selection at every cell edge and bleeds the
+ * neighbouring faces in.
+ */
+class CellBatch     :   public Renderable
+{
+public:
+    CellBatch( Texture texture, GreedyMesher::Face face );
+    ~CellBatch();
+
+    void addQuad( const GreedyMesher::Quad& quad );
+    int numQuads() const;
+    const Bounds& bounds() const;
+
+    // Renderable Functions
+    void initializeGL();
+    void submit( RenderQueue& queue );
+    void update();
+    void teardownGL();
+
+    static QString texturePath( Texture texture );
+    static int index( Texture texture, GreedyMesher::Face face );
+
+private:
+    // OpenGL State Data
+    QOpenGLBuffer* m_vbo;
+    QOpenGLBuffer* m_ibo;
+    QOpenGLVertexArrayObject* m_vao;
+    QSharedPointer<QOpenGLShaderProgram> m_program;
+
+    // Batch Information
+    UVMesh m_batch;
+    int m_numQuads;
+    Bounds m_bounds;
+    int m_numIndices;
+    GLenum m_indexType;
+
+    // Texture Information
+    Texture m_selectedTexture;
+    GreedyMesher::Face m_face;
+    QSharedPointer<QOpenGLTexture> m_texture;
+
+    // Shader Information
+    const QString PATH_TO_V_SHADER = ":/shader/uvShader.vs";
+    const QString PATH_TO_F_SHADER = ":/shader/uvShader.fs";
+    int m_modelClip;
+};
+
+#endif  //  CELL_BATCH_H
\ No newline at end of file
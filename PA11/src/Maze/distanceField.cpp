@@ -0,0 +1,382 @@
+#include "distanceField.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Controls/jobSystem.h"
+#include "Maze/mazeGenerator.h"
+
+//
+// PRIVATE HELPERS /////////////////////////////////////////////////////////////
+//
+
+namespace
+{
+    // Mazes smaller than this are expanded as a single band
+    const std::size_t MIN_CELLS_PER_BAND = 1 << 16;
+
+    // Most cells a band expands in a round before handing cells over
+    const std::size_t ROUND_CELLS = 1 << 14;
+
+    /**
+     * @brief      Lowers a distance if the new one is shorter.
+     *
+     * @param      distance  The distance to lower.
+     * @param[in]  value     The new distance.
+     *
+     * @return     True if the distance was lowered.
+     */
+    bool lower( std::atomic<uint32_t>& distance, uint32_t value )
+    {
+        uint32_t current = distance.load( std::memory_order_relaxed );
+        while( value < current )
+        {
+            if( distance.compare_exchange_weak( current, value,
+                std::memory_order_relaxed ) )
+                return true;
+        }
+        return false;
+    }
+}
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for an empty DistanceField.
+ */
+DistanceField::DistanceField()
+    :   m_width( 0 ), m_height( 0 ), m_rowsPerBand( 1 ), m_queued( 0 )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Computes the distance of every cell of a maze to a goal, before
+ *             returning.
+ *
+ * @param[in]  maze      The maze.
+ * @param[in]  goalX     The x cell of the goal.
+ * @param[in]  goalZ     The z cell of the goal.
+ * @param[in]  numBands  The number of bands to expand side by side, or 0 to
+ *                       pick one per job system thread for large mazes.
+ */
+void DistanceField::build( const MazeGrid& maze, int goalX, int goalZ,
+    int numBands )
+{
+    start( maze, goalX, goalZ, numBands );
+    advance( maze, std::numeric_limits<std::size_t>::max() );
+}
+
+/**
+ * @brief      Clears the field and places the goal, without expanding from it.
+ *             Every cell but the goal is UNREACHABLE until advance has settled
+ *             the field.
+ *
+ * @param[in]  maze      The maze, which must outlive the expansion.
+ * @param[in]  goalX     The x cell of the goal.
+ * @param[in]  goalZ     The z cell of the goal.
+ * @param[in]  numBands  The number of bands to expand side by side, or 0 to
+ *                       pick one per job system thread for large mazes.
+ */
+void DistanceField::start( const MazeGrid& maze, int goalX, int goalZ,
+    int numBands )
+{
+    m_width = maze.width();
+    m_height = maze.height();
+
+    std::vector< std::atomic<uint32_t> > distances(
+        (std::size_t)m_width * m_height );
+    for( std::atomic<uint32_t>& distance : distances )
+        distance.store( UNREACHABLE, std::memory_order_relaxed );
+    m_distances.swap( distances );
+
+    if( numBands <= 0 )
+        numBands = JobSystem::instance().numThreads();
+    numBands = std::max<int>( 1, std::min<std::size_t>( numBands,
+        m_distances.size() / MIN_CELLS_PER_BAND ) );
+    m_rowsPerBand = std::max( 1, ( m_width + numBands - 1 ) / numBands );
+
+    m_bands.assign( numBands, Band() );
+    for( Band& band : m_bands )
+    {
+        band.Outbox.resize( numBands );
+        band.Expanded = 0;
+    }
+    m_queued = 0;
+
+    if( !contains( goalX, goalZ ) )
+        return;
+
+    // The goal counts even while it is a wall, so it can be streamed in later
+    const uint32_t goal = goalX * m_height + goalZ;
+    m_distances[goal].store( 0, std::memory_order_relaxed );
+    seed( goal );
+}
+
+/**
+ * @brief      Expands the field by about a given number of cells.
+ * @details    Every round expands each band on the job system, then hands the
+ * cells that crossed into another band over to it. The round ends once
+ * parallelFor has joined every band, so no band is left waiting on the others
+ * and the hand over needs no locks.
+ *
+ * @param[in]  maze      The maze the field was started with.
+ * @param[in]  maxCells  The most cells to expand before returning.
+ *
+ * @return     True once the field has settled.
+ */
+bool DistanceField::advance( const MazeGrid& maze, std::size_t maxCells )
+{
+    const int numBands = m_bands.size();
+    std::size_t expanded = 0;
+    while( m_queued > 0 && expanded < maxCells )
+    {
+        const std::size_t share = std::max<std::size_t>( 1, std::min(
+            ROUND_CELLS, ( maxCells - expanded ) / numBands ) );
+        JobSystem::instance().parallelFor( 0, numBands, 1,
+            [&]( int begin, int end ){
+                for( int band = begin; band < end; band++ )
+                    expandBand( maze, band, share );
+            } );
+
+        m_queued = 0;
+        for( Band& band : m_bands )
+        {
+            expanded += band.Expanded;
+            for( int owner = 0; owner < numBands; owner++ )
+            {
+                std::vector<uint32_t>& cells = band.Outbox[owner];
+                m_bands[owner].Queue.insert( m_bands[owner].Queue.end(),
+                    cells.begin(), cells.end() );
+                cells.clear();
+            }
+        }
+        for( const Band& band : m_bands )
+            m_queued += band.Queue.size();
+    }
+
+    return m_queued == 0;
+}
+
+/**
+ * @brief      Checks if every cell has its final distance.
+ *
+ * @return     False while start has been called and advance has not finished.
+ */
+bool DistanceField::isSettled() const
+{
+    return m_queued == 0;
+}
+
+/**
+ * @brief      Joins cells that have been opened up in a maze to the field.
+ * @details    Opening cells can only shorten distances, so the wavefront is
+ * restarted from every reached cell in and around the changed rectangle, and
+ * spreads only as far as distances keep getting shorter. An expansion still
+ * in progress is finished along with it.
+ *
+ * @param[in]  maze  The maze, with the same size the field was built with.
+ * @param[in]  minX  The first x cell that changed.
+ * @param[in]  minZ  The first z cell that changed.
+ * @param[in]  maxX  The last x cell that changed.
+ * @param[in]  maxZ  The last z cell that changed.
+ */
+void DistanceField::update( const MazeGrid& maze, int minX, int minZ,
+    int maxX, int maxZ )
+{
+    for( int x = std::max( 0, minX - 1 ); x <= std::min( m_width - 1,
+        maxX + 1 ); x++ )
+    {
+        for( int z = std::max( 0, minZ - 1 ); z <= std::min( m_height - 1,
+            maxZ + 1 ); z++ )
+        {
+            if( distance( x, z ) != UNREACHABLE )
+                seed( x * m_height + z );
+        }
+    }
+
+    advance( maze, std::numeric_limits<std::size_t>::max() );
+}
+
+/**
+ * @brief      Gets the number of cells along x.
+ *
+ * @return     The width of the field.
+ */
+int DistanceField::width() const
+{
+    return m_width;
+}
+
+/**
+ * @brief      Gets the number of cells along z.
+ *
+ * @return     The height of the field.
+ */
+int DistanceField::height() const
+{
+    return m_height;
+}
+
+/**
+ * @brief      Checks if a cell is inside the field.
+ *
+ * @param[in]  x     The x cell.
+ * @param[in]  z     The z cell.
+ *
+ * @return     True if the cell is inside the field.
+ */
+bool DistanceField::contains( int x, int z ) const
+{
+    return x >= 0 && z >= 0 && x < m_width && z < m_height;
+}
+
+/**
+ * @brief      Gets the number of steps from a cell to the goal.
+ *
+ * @param[in]  x     The x cell.
+ * @param[in]  z     The z cell.
+ *
+ * @return     The distance, or UNREACHABLE.
+ */
+uint32_t DistanceField::distance( int x, int z ) const
+{
+    if( !contains( x, z ) )
+        return UNREACHABLE;
+
+    return m_distances[ (std::size_t)x * m_height + z ].load(
+        std::memory_order_relaxed );
+}
+
+/**
+ * @brief      Gets the neighbour of a cell that is one step closer to the
+ *             goal.
+ *
+ * @param[in]  x     The x cell.
+ * @param[in]  z     The z cell.
+ * @param[out] next  The next cell.
+ *
+ * @return     False if the cell is the goal or cannot reach it.
+ */
+bool DistanceField::nextStep( int x, int z, Step& next ) const
+{
+    const uint32_t current = distance( x, z );
+    if( current == 0 || current == UNREACHABLE )
+        return false;
+
+    const int offsets[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    for( const int* offset : offsets )
+    {
+        if( distance( x + offset[0], z + offset[1] ) == current - 1 )
+        {
+            next = Step( x + offset[0], z + offset[1] );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief      Follows the field from a cell towards the goal.
+ *
+ * @param[in]  x          The x cell to start from.
+ * @param[in]  z          The z cell to start from.
+ * @param[in]  maxLength  The most cells to return.
+ *
+ * @return     The cells of the path, starting with the given one.
+ */
+std::vector<DistanceField::Step> DistanceField::path( int x, int z,
+    int maxLength ) const
+{
+    std::vector<Step> steps;
+    if( distance( x, z ) == UNREACHABLE )
+        return steps;
+
+    Step step( x, z );
+    steps.push_back( step );
+    while( (int)steps.size() < maxLength &&
+        nextStep( step.first, step.second, step ) )
+    {
+        steps.push_back( step );
+    }
+
+    return steps;
+}
+
+/**
+ * @brief      Gets the memory used by the distances.
+ *
+ * @return     The size of the field, in bytes.
+ */
+std::size_t DistanceField::memoryUsage() const
+{
+    return m_distances.size() * sizeof( uint32_t );
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Queues a cell that already has its distance in its band.
+ *
+ * @param[in]  cell  The index of the cell.
+ */
+void DistanceField::seed( uint32_t cell )
+{
+    m_bands[ cell / m_height / m_rowsPerBand ].Queue.push_back( cell );
+    m_queued++;
+}
+
+/**
+ * @brief      Expands the cells of one band in breadth first order, for one
+ *             round. A shortened cell in another band is put in the outbox for
+ *             that band instead.
+ *
+ * @param[in]  maze      The maze.
+ * @param[in]  self      The band to expand.
+ * @param[in]  maxCells  The most cells to expand.
+ */
+void DistanceField::expandBand( const MazeGrid& maze, int self,
+    std::size_t maxCells )
+{
+    Band& band = m_bands[self];
+    band.Expanded = 0;
+    while( !band.Queue.empty() && band.Expanded < maxCells )
+    {
+        const uint32_t cell = band.Queue.front();
+        band.Queue.pop_front();
+        band.Expanded++;
+
+        const int x = cell / m_height;
+        const int z = cell % m_height;
+        const uint32_t next = m_distances[cell].load(
+            std::memory_order_relaxed ) + 1;
+
+        const int offsets[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        for( const int* offset : offsets )
+        {
+            const int neighbourX = x + offset[0];
+            const int neighbourZ = z + offset[1];
+            if( !contains( neighbourX, neighbourZ ) || maze.at( neighbourX,
+                neighbourZ ) == MazeGenerator::WALL )
+                continue;
+
+            const uint32_t neighbour = neighbourX * m_height + neighbourZ;
+            if( !lower( m_distances[neighbour], next ) )
+                continue;
+
+            const int owner = neighbourX / m_rowsPerBand;
+            if( owner == self )
+                band.Queue.push_back( neighbour );
+            else
+                band.Outbox[owner].push_back( neighbour );
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef DISTANCE_FIELD_H
+#define DISTANCE_FIELD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "Maze/mazeGrid.h"
+
+/**
+ * @brief      Number of steps from every cell of a maze to a goal cell.
+ * @details    The field is built once per maze by a breadth first wavefront
+ * from the goal. Large mazes are split into bands of rows, expanded side by
+ * side on the job system in rounds. Cells crossing into another band are
+ * handed over between rounds. The rounds can be run all at once with build, or
+ * a few per frame with start and advance, so a large maze never stalls a
+ * frame. Cells opened up later, such as streamed tiles, are joined with update,
+ * which only expands from around the new cells.
+ *
+ * Once built, the next step towards the goal from any cell is a lookup of its
+ * four neighbours.
+ */
+class DistanceField
+{
+public:
+    typedef std::pair<int, int> Step;
+
+    DistanceField();
+
+    void build( const MazeGrid& maze, int goalX, int goalZ,
+        int numBands = 0 );
+    void start( const MazeGrid& maze, int goalX, int goalZ,
+        int numBands = 0 );
+    bool advance( const MazeGrid& maze, std::size_t maxCells );
+    bool isSettled() const;
+    void update( const MazeGrid& maze, int minX, int minZ, int maxX,
+        int maxZ );
+
+    int width() const;
+    int height() const;
+    bool contains( int x, int z ) const;
+    uint32_t distance( int x, int z ) const;
+    bool nextStep( int x, int z, Step& next ) const;
+    std::vector<Step> path( int x, int z, int maxLength ) const;
+
+    std::size_t memoryUsage() const;
+
+    // Distance of walls and of cells with no way to the goal
+    static const uint32_t UNREACHABLE = 0xffffffffu;
+
+    // Cells a game tick expands while a field is built over several frames
+    static const std::size_t CELLS_PER_TICK = 1 << 16;
+
+private:
+    /**
+     * @brief      Cells waiting to be expanded in one band of rows.
+     */
+    struct Band
+    {
+        std::deque<uint32_t> Queue;
+
+        // Cells for each other band, handed over at the end of a round
+        std::vector< std::vector<uint32_t> > Outbox;
+
+        // Cells expanded in the last round
+        std::size_t Expanded;
+    };
+
+    void seed( uint32_t cell );
+    void expandBand( const MazeGrid& maze, int self, std::size_t maxCells );
+
+    int m_width, m_height;
+    std::vector< std::atomic<uint32_t> > m_distances;
+    std::vector<Band> m_bands;
+    int m_rowsPerBand;
+    std::size_t m_queued;
+};
+
+#endif  //  DISTANCE_FIELD_H
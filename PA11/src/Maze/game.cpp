@@ -0,0 +1,577 @@
+#include "game.h"
+
+#include <climits>
+#include <cmath>
+
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Game. Builds the labyrinth, the balls and the
+ *             dynamics world; nothing is added to the world until every
+ *             renderable has been initialized.
+ *
+ * @param[in]  seed      The seed of the generated labyrinth.
+ * @param[in]  infinite  True to stream an endless labyrinth around the balls
+ *                       instead of a fixed 30 by 30 one.
+ */
+Game::Game( int seed, bool infinite )
+    :   m_loading( true ), m_streaming( NULL ), m_score( 0.0f ),
+        m_tiltHorizontal( 0 ), m_tiltVertical( 0 ), m_dynamicsWorld( NULL )
+{
+    m_profilePhysics = m_profiler.addSection( "Physics" );
+    m_profileUpdate = m_profiler.addSection( "Update" );
+    m_profileDraw = m_profiler.addSection( "Draw" );
+
+    initializeBullet();
+
+    Environment selectedEnvironment = Labyrinth::getRandomEnvironment();
+
+    std::pair<float, float> startingLocation;
+    if( infinite )
+    {
+        m_streaming = new StreamingLabyrinth( selectedEnvironment, seed,
+            m_dynamicsWorld );
+        m_renderables["Labyrinth"] = m_streaming;
+        startingLocation = m_streaming->getStartingLocation();
+    }
+    else
+    {
+        Labyrinth* labyrinth = new Labyrinth( selectedEnvironment, seed, 30,
+            30 );
+        m_renderables["Labyrinth"] = labyrinth;
+        startingLocation = labyrinth->getStartingLocation();
+    }
+
+    const bool isBoulder = selectedEnvironment != Environment::Ice;
+
+    m_renderables["Ball"] = new Ball( startingLocation.first, 1.5f, startingLocation.second, isBoulder );
+    m_renderables["Ball2"] = new Ball( startingLocation.first+0.5, 1.5f, startingLocation.second+0.5f, isBoulder );
+
+    m_hintPath = new HintPath();
+    m_renderables["HintPath"] = m_hintPath;
+    m_hintCell = std::pair<int, int>( INT_MIN, INT_MIN );
+    m_controller = new BallController(
+        ((Ball*)m_renderables["Ball2"])->RigidBody, 2.0f );
+
+    m_followed = QVector3D( startingLocation.first + 0.25f, 0.0f,
+        startingLocation.second + 0.25f );
+    resetBoard();
+
+    // An endless labyrinth needs a lid further than the balls can roll
+    const float lidExtent = infinite ? 1.0e6f : 100.0f;
+    const btVector3 wallSize = btVector3(lidExtent, 50, lidExtent);
+    const btVector3 location = btVector3(0, 52.5, 0 );
+    m_invisibleWall = new Wall( wallSize, location );
+}
+
+/**
+ * @brief      Destructor for Game. The GL data must already be torn down.
+ */
+Game::~Game()
+{
+    // Its tiles have to leave the world before the world goes
+    delete m_streaming;
+    delete m_controller;
+    teardownBullet();
+}
+
+//
+// OPENGL FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Prepares the renderables for initialization, which is spread
+ *             over several frames by initializeNextRenderable.
+ */
+void Game::initializeGL()
+{
+    initializeOpenGLFunctions();
+    m_profiler.initializeGL();
+    m_renderQueue.initializeGL();
+
+    m_pendingGL = m_renderables.values();
+}
+
+/**
+ * @brief      Uploads the next pending renderable, then adds the scene to the
+ *             dynamics world once the last one is done.
+ *
+ * @return     True once every renderable has been initialized.
+ */
+bool Game::initializeNextRenderable()
+{
+    if( !m_loading )
+        return true;
+
+    if( !m_pendingGL.isEmpty() )
+        m_pendingGL.takeFirst()->initializeGL();
+
+    if( !m_pendingGL.isEmpty() )
+        return false;
+
+    // Wait for the tiles around the start before dropping the balls in
+    if( m_streaming != NULL )
+    {
+        m_streaming->stream( ballPositions() );
+        m_streaming->uploadTiles();
+        if( !m_streaming->isReady() )
+            return false;
+    }
+    else
+        ((Labyrinth*)m_renderables["Labyrinth"])->addRigidBodies( m_dynamicsWorld );
+    m_dynamicsWorld->addRigidBody( ((Ball*)m_renderables["Ball"])->RigidBody );
+    m_dynamicsWorld->addRigidBody( ((Ball*)m_renderables["Ball2"])->RigidBody );
+    m_dynamicsWorld->addRigidBody( m_invisibleWall->RigidBody );
+
+    m_loading = false;
+    return true;
+}
+
+/**
+ * @brief      Sets the prespective whenever the surface is resized.
+ *
+ * @param[in]  width   The width of the new surface.
+ * @param[in]  height  The height of the new surface.
+ */
+void Game::resizeGL( int width, int height )
+{
+    m_projection.setToIdentity();
+    m_projection.perspective( 55.0f,  // Field of view angle
+                            float( width ) / float( height ),   // Aspect Ratio
+                            0.001f,  // Near Plane (MUST BE GREATER THAN 0)
+                            1500.0f );  // Far Plane
+}
+
+/**
+ * @brief      Draws the scene to the bound surface, skipping the renderables
+ *             outside the view. The labyrinth culls its own batches. The rest
+ *             are queued and drawn in the order that changes the least state.
+ */
+void Game::paintGL()
+{
+    // Set the default OpenGL states
+    glEnable( GL_DEPTH_TEST );
+    glDepthFunc( GL_LEQUAL );
+    glDepthMask( GL_TRUE );
+    glEnable( GL_CULL_FACE );
+    glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
+
+    // Clear the screen
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+    m_profiler.beginGPU();
+    m_profiler.begin( m_profileDraw );
+    m_renderQueue.begin( m_camera, m_projection );
+    const Frustum& frustum = m_renderQueue.frustum();
+    int drawn = 0, culled = 0;
+    for( QMap<QString, Renderable*>::iterator iter = m_renderables.begin();
+        iter != m_renderables.end(); iter++ )
+    {
+        Bounds bounds;
+        if( (*iter)->worldBounds( bounds ) )
+        {
+            if( !frustum.intersects( bounds ) )
+            {
+                culled++;
+                continue;
+            }
+            drawn++;
+        }
+
+        (*iter)->submit( m_renderQueue );
+    }
+    Profiler::countCulling( drawn, culled );
+    m_renderQueue.flush();
+    m_profiler.end( m_profileDraw );
+    m_profiler.endGPU();
+}
+
+/**
+ * @brief      Destroys any OpenGL data.
+ */
+void Game::teardownGL()
+{
+    m_profiler.teardownGL();
+
+    for( QMap<QString, Renderable*>::iterator iter = m_renderables.begin();
+        iter != m_renderables.end(); iter++ )
+    {
+        (*iter)->teardownGL();
+    }
+}
+
+//
+// SIMULATION FUNCTIONS ////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Advances the dynamics world in fixed ticks, then places the
+ *             renderables between the last two ticks.
+ * @details    Every tick steps the world by exactly one FixedTimestep step, so
+ * the simulation plays out the same regardless of the frame rate. The time
+ * left over is carried to the next frame and used to blend the drawn state.
+ *
+ * @param[in]  dt    The time since the last update, in seconds.
+ */
+void Game::update( float dt )
+{
+    if( m_loading )
+        return;
+
+    const int ticks = m_timestep.advance( dt );
+    const float step = m_timestep.step();
+
+    for( int tick = 0; tick < ticks; tick++ )
+    {
+        tiltBoard( m_tiltHorizontal, m_tiltVertical );
+        m_controller->steer( distanceField(), fieldOrigin().first,
+            fieldOrigin().second );
+
+        {
+            Profiler::Scope scope( m_profiler, m_profilePhysics );
+            m_dynamicsWorld->stepSimulation( step, 0 );
+        }
+
+        Profiler::Scope scope( m_profiler, m_profileUpdate );
+        for( QMap<QString, Renderable*>::iterator iter = m_renderables.begin();
+            iter != m_renderables.end(); iter++ )
+        {
+            (*iter)->update();
+        }
+
+        m_score += step * 100;
+    }
+
+    const float alpha = m_timestep.alpha();
+    for( QMap<QString, Renderable*>::iterator iter = m_renderables.begin();
+        iter != m_renderables.end(); iter++ )
+    {
+        (*iter)->interpolate( alpha );
+    }
+
+    if( m_streaming != NULL )
+    {
+        followBalls();
+        m_streaming->stream( ballPositions() );
+    }
+
+    updateHint();
+}
+
+/**
+ * @brief      Sets how the player is tilting the board, applied every tick
+ *             until it is changed.
+ *
+ * @param[in]  horizontal  -1 to tilt left, 1 to tilt right, 0 to hold.
+ * @param[in]  vertical    -1 to tilt up, 1 to tilt down, 0 to hold.
+ */
+void Game::setTilt( int horizontal, int vertical )
+{
+    m_tiltHorizontal = horizontal;
+    m_tiltVertical = vertical;
+}
+
+/**
+ * @brief      Tilts the board, rolling the balls with the camera following.
+ *
+ * @param[in]  horizontal  -1 to tilt left, 1 to tilt right, 0 to hold.
+ * @param[in]  vertical    -1 to tilt up, 1 to tilt down, 0 to hold.
+ */
+void Game::tiltBoard( int horizontal, int vertical )
+{
+    const float rotationSpeed = 0.7f;
+    const float rollingSpeed = 0.5f;
+    btVector3 gravity = m_dynamicsWorld->getGravity();
+
+    // Update horizontal rotation
+    if( horizontal < 0 )
+    {
+        m_camera.rotate( -rotationSpeed, QVector3D(0, 0, 1) );
+        m_camera.translate( 0.70f, 0, 0);
+        gravity -= btVector3( rollingSpeed, 0, 0 );
+    }
+    else if( horizontal > 0 )
+    {
+        m_camera.rotate( rotationSpeed, QVector3D(0, 0, 1) );
+        m_camera.translate( -0.70f, 0, 0);
+        gravity += btVector3( rollingSpeed, 0, 0 );
+    }
+
+    // Update vertical rotation
+    if( vertical < 0 )
+    {
+        m_camera.rotate( rotationSpeed, QVector3D(1, 0, 0) );
+        m_camera.translate( 0, 0, 0.70f );
+        gravity -= btVector3( 0, 0, rollingSpeed );
+    }
+    else if( vertical > 0 )
+    {
+        m_camera.rotate( -rotationSpeed, QVector3D(1, 0, 0) );
+        m_camera.translate( 0, 0, -0.70f );
+        gravity += btVector3( 0, 0, rollingSpeed );
+    }
+
+    // Update gravity
+    m_dynamicsWorld->setGravity( gravity );
+}
+
+/**
+ * @brief      Levels the board and moves the camera back above it, or above
+ *             the balls in an endless labyrinth.
+ */
+void Game::resetBoard()
+{
+    m_camera.setRotation( -90.0f, 1.0f, 0.0f, 0.0f );
+    if( m_streaming != NULL )
+        m_camera.setTranslation( m_followed.x(), 75.0f, m_followed.z() );
+    else
+        m_camera.setTranslation( 30.0f, 75.0f, 30.0f );
+
+    if( m_dynamicsWorld != NULL )
+        m_dynamicsWorld->setGravity( btVector3( 0, -9.8, 0 ) );
+}
+
+/**
+ * @brief      Shows or hides the way to the goal from the first ball.
+ */
+void Game::toggleHint()
+{
+    m_hintPath->Visible = !m_hintPath->Visible;
+    m_hintCell = std::pair<int, int>( INT_MIN, INT_MIN );
+}
+
+/**
+ * @brief      Hands the second ball over to the AI, or takes it back.
+ */
+void Game::toggleAI()
+{
+    m_controller->Enabled = !m_controller->Enabled;
+}
+
+/**
+ * @brief      Checks if both balls have gone through the hole. An endless
+ *             labyrinth has no hole and is never won.
+ *
+ * @return     True if the game has been won.
+ */
+bool Game::hasWon()
+{
+    if( m_streaming != NULL )
+        return false;
+
+    btTransform firstObject;
+    (((Ball*)m_renderables["Ball"])->RigidBody->getMotionState())->getWorldTransform(firstObject);
+
+    btTransform secondObject;
+    (((Ball*)m_renderables["Ball2"])->RigidBody->getMotionState())->getWorldTransform(secondObject);
+
+    return firstObject.getOrigin().y() < 0 && secondObject.getOrigin().y() < 0;
+}
+
+//
+// ACCESSORS ///////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Checks if renderables are still waiting to be initialized.
+ *
+ * @return     True while the game is loading.
+ */
+bool Game::isLoading() const
+{
+    return m_loading;
+}
+
+/**
+ * @brief      Gets the number of renderables in the game.
+ *
+ * @return     The number of renderables.
+ */
+int Game::numRenderables() const
+{
+    return m_renderables.size();
+}
+
+/**
+ * @brief      Gets the number of renderables initialized so far.
+ *
+ * @return     The number of initialized renderables.
+ */
+int Game::numInitialized() const
+{
+    return m_renderables.size() - m_pendingGL.size();
+}
+
+/**
+ * @brief      Gets the current score.
+ *
+ * @return     The score.
+ */
+int Game::score() const
+{
+    return m_score;
+}
+
+/**
+ * @brief      Gets the camera the game is drawn with.
+ *
+ * @return     The camera.
+ */
+Camera3D& Game::camera()
+{
+    return m_camera;
+}
+
+/**
+ * @brief      Gets the profiler the game records its frames to.
+ *
+ * @return     The profiler.
+ */
+Profiler& Game::profiler()
+{
+    return m_profiler;
+}
+
+/**
+ * @brief      Gets the fixed timestep the dynamics world is advanced with.
+ *
+ * @return     The timestep.
+ */
+FixedTimestep& Game::timestep()
+{
+    return m_timestep;
+}
+
+/**
+ * @brief      Queues every asset the game needs, so they can be decoded in the
+ *             background before the game is created.
+ *
+ * @param      loader  The loader to queue the assets on.
+ */
+void Game::queueAssets( AssetLoader& loader )
+{
+    Labyrinth::queueAssets( loader );
+    Ball::queueAssets( loader );
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Moves the camera along with the point between the balls, keeping
+ *             any offset the board tilt has given it.
+ */
+void Game::followBalls()
+{
+    const QVector3D followed = ( ((Ball*)m_renderables["Ball"])->BTransform.
+        column( 3 ).toVector3D() + ((Ball*)m_renderables["Ball2"])->
+        BTransform.column( 3 ).toVector3D() ) * 0.5f;
+
+    m_camera.translate( followed.x() - m_followed.x(), 0.0f,
+        followed.z() - m_followed.z() );
+    m_followed = QVector3D( followed.x(), 0.0f, followed.z() );
+}
+
+/**
+ * @brief      Lays the hint path from the first ball's cell, whenever it rolls
+ *             into another one.
+ */
+void Game::updateHint()
+{
+    if( !m_hintPath->Visible )
+        return;
+
+    const float CELL_SIZE = 2.0f;
+    const float HEIGHT = 1.05f;
+    const int MAX_LENGTH = 500;
+
+    const btVector3 position = ballPositions()[0];
+    const std::pair<int, int> origin = fieldOrigin();
+    const std::pair<int, int> cell(
+        std::floor( position.x() / CELL_SIZE + 0.5f ) - origin.first,
+        std::floor( position.z() / CELL_SIZE + 0.5f ) - origin.second );
+    if( cell == m_hintCell || !distanceField().isSettled() )
+        return;
+    m_hintCell = cell;
+
+    std::vector<QVector3D> points;
+    for( const DistanceField::Step& step :
+        distanceField().path( cell.first, cell.second, MAX_LENGTH ) )
+    {
+        points.push_back( QVector3D( ( step.first + origin.first ) * CELL_SIZE,
+            HEIGHT, ( step.second + origin.second ) * CELL_SIZE ) );
+    }
+    m_hintPath->setPath( points );
+}
+
+/**
+ * @brief      Gets the distance of every cell to the goal, the hole of a fixed
+ *             labyrinth or the start of an endless one.
+ *
+ * @return     The distance field of the labyrinth.
+ */
+const DistanceField& Game::distanceField()
+{
+    if( m_streaming != NULL )
+        return m_streaming->distanceField();
+
+    return ((Labyrinth*)m_renderables["Labyrinth"])->distanceField();
+}
+
+/**
+ * @brief      Gets the cell the labyrinth's distance field starts at.
+ *
+ * @return     The x and z cell of the field's first cell.
+ */
+std::pair<int, int> Game::fieldOrigin()
+{
+    if( m_streaming != NULL )
+        return m_streaming->fieldOrigin();
+
+    return ((Labyrinth*)m_renderables["Labyrinth"])->fieldOrigin();
+}
+
+/**
+ * @brief      Gets where the balls are in the dynamics world.
+ *
+ * @return     The position of every ball.
+ */
+std::vector<btVector3> Game::ballPositions()
+{
+    std::vector<btVector3> positions;
+    positions.push_back( ((Ball*)m_renderables["Ball"])->RigidBody->
+        getCenterOfMassPosition() );
+    positions.push_back( ((Ball*)m_renderables["Ball2"])->RigidBody->
+        getCenterOfMassPosition() );
+    return positions;
+}
+
+/**
+ * @brief      Helper function to initialize bullet data.
+ */
+void Game::initializeBullet()
+{
+    m_broadphase = new btDbvtBroadphase();
+    m_collisionConfig = new btDefaultCollisionConfiguration();
+    m_dispatcher = new btCollisionDispatcher( m_collisionConfig );
+    m_solver = new btSequentialImpulseConstraintSolver();
+    m_dynamicsWorld = new btDiscreteDynamicsWorld( m_dispatcher, m_broadphase,
+        m_solver, m_collisionConfig );
+    m_dynamicsWorld->setGravity( btVector3( 0, -9.8, 0 ) );
+}
+
+/**
+ * @brief      Helper function to delete bullet allocations.
+ */
+void Game::teardownBullet()
+{
+    delete m_dynamicsWorld;
+    delete m_solver;
+    delete m_dispatcher;
+    delete m_collisionConfig;
+    delete m_broadphase;
+}
@@ -0,0 +1,114 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <QList>
+#include <QMap>
+#include <QMatrix4x4>
+#include <QOpenGLFunctions>
+#include <QString>
+#include <QVector3D>
+
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "3D/assetLoader.h"
+#include "3D/renderQueue.h"
+#include "3D/renderable.h"
+#include "Controls/camera3d.h"
+#include "Controls/fixedTimestep.h"
+#include "Controls/profiler.h"
+#include "Maze/ball.h"
+#include "Maze/ballController.h"
+#include "Maze/distanceField.h"
+#include "Maze/hintPath.h"
+#include "Maze/labyrinth.h"
+#include "Maze/streamingLabyrinth.h"
+#include "Maze/wall.h"
+
+class Game  :   protected QOpenGLFunctions
+{
+public:
+    Game( int seed, bool infinite = false );
+    ~Game();
+
+    // OpenGL Functions
+    void initializeGL();
+    bool initializeNextRenderable();
+    void resizeGL( int width, int height );
+    void paintGL();
+    void teardownGL();
+
+    // Simulation Functions
+    void update( float dt );
+    void setTilt( int horizontal, int vertical );
+    void resetBoard();
+    void toggleHint();
+    void toggleAI();
+    bool hasWon();
+
+    bool isLoading() const;
+    int numRenderables() const;
+    int numInitialized() const;
+    int score() const;
+
+    Camera3D& camera();
+    Profiler& profiler();
+    FixedTimestep& timestep();
+
+    static void queueAssets( AssetLoader& loader );
+
+private:
+    void initializeBullet();
+    void teardownBullet();
+    void tiltBoard( int horizontal, int vertical );
+    void followBalls();
+    void updateHint();
+    const DistanceField& distanceField();
+    std::pair<int, int> fieldOrigin();
+    std::vector<btVector3> ballPositions();
+
+    // OpenGL Objects
+    QMap<QString, Renderable*> m_renderables;
+
+    // Renderables still waiting for their GL uploads
+    QList<Renderable*> m_pendingGL;
+    bool m_loading;
+
+    // Endless labyrinth, NULL when playing a fixed one
+    StreamingLabyrinth* m_streaming;
+
+    // Point between the balls the camera follows in an endless labyrinth
+    QVector3D m_followed;
+
+    // Way to the goal from the first ball, and the AI rolling the second
+    HintPath* m_hintPath;
+    std::pair<int, int> m_hintCell;
+    BallController* m_controller;
+
+    // Invisible Bullet object
+    Wall* m_invisibleWall;
+    float m_score;
+
+    // Board tilt held by the player, applied once per tick
+    int m_tiltHorizontal, m_tiltVertical;
+
+    // 3D data
+    QMatrix4x4 m_projection;
+    Camera3D m_camera;
+    RenderQueue m_renderQueue;
+
+    // Bullet data
+    btBroadphaseInterface* m_broadphase;
+    btDefaultCollisionConfiguration* m_collisionConfig;
+    btCollisionDispatcher* m_dispatcher;
+    btSequentialImpulseConstraintSolver* m_solver;
+    btDiscreteDynamicsWorld* m_dynamicsWorld;
+    FixedTimestep m_timestep;
+
+    // Frame timings
+    Profiler m_profiler;
+    int m_profilePhysics, m_profileUpdate, m_profileDraw;
+};
+
+#endif  //  GAME_H
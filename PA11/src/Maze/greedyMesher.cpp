@@ -0,0 +1,233 @@
+#include "greedyMesher.h"
+
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <utility>
+
+//
+// PRIVATE HELPERS /////////////////////////////////////////////////////////////
+//
+
+namespace
+{
+    typedef std::tuple<int, int, int> Coordinate;
+
+    // Faces of one plane, keyed by ( v, u ) so rows are contiguous
+    typedef std::map< std::pair<int, int>, Texture > Slice;
+
+    struct Direction
+    {
+        QVector3D Normal;
+        QVector3D U;
+        QVector3D V;
+    };
+
+    // U x V is the normal, so corners listed along U then V wind outwards
+    const Direction DIRECTIONS[GreedyMesher::FaceCount] =
+    {
+        { QVector3D(  1,  0,  0 ), QVector3D(  0,  0, -1 ), QVector3D( 0, 1,  0 ) },
+        { QVector3D( -1,  0,  0 ), QVector3D(  0,  0,  1 ), QVector3D( 0, 1,  0 ) },
+        { QVector3D(  0,  1,  0 ), QVector3D(  1,  0,  0 ), QVector3D( 0, 0, -1 ) },
+        { QVector3D(  0, -1,  0 ), QVector3D(  1,  0,  0 ), QVector3D( 0, 0,  1 ) },
+        { QVector3D(  0,  0,  1 ), QVector3D(  1,  0,  0 ), QVector3D( 0, 1,  0 ) },
+        { QVector3D(  0,  0, -1 ), QVector3D( -1,  0,  0 ), QVector3D( 0, 1,  0 ) }
+    };
+
+    /**
+     * @brief      Projects a grid coordinate onto an axis.
+     *
+     * @param[in]  coordinate  The grid coordinate.
+     * @param[in]  axis        The unit axis, possibly pointing backwards.
+     *
+     * @return     The coordinate along the axis.
+     */
+    int project( const Coordinate& coordinate, const QVector3D& axis )
+    {
+        return std::get<0>( coordinate ) * axis.x() +
+            std::get<1>( coordinate ) * axis.y() +
+            std::get<2>( coordinate ) * axis.z();
+    }
+
+    /**
+     * @brief      Gets the chunk of a grid coordinate along one axis.
+     *
+     * @param[in]  coordinate  The grid coordinate.
+     * @param[in]  chunkSize   The number of cells along a chunk's side.
+     *
+     * @return     The chunk coordinate, rounded towards negative infinity.
+     */
+    int chunkOf( int coordinate, int chunkSize )
+    {
+        return ( coordinate < 0 ? coordinate - chunkSize + 1 : coordinate ) /
+            chunkSize;
+    }
+
+    /**
+     * @brief      Covers a plane of faces with rectangles of one texture.
+     *
+     * @param      slice      The faces of the plane, emptied as they are used.
+     * @param[in]  face       The direction the faces point in.
+     * @param[in]  plane      The coordinate of the cubes along the normal.
+     * @param[in]  chunk      The chunk of the faces.
+     * @param[in]  cellSize   The edge length of a single cube.
+     * @param      quads      The list to add the rectangles to.
+     */
+    void mergeSlice( Slice& slice, GreedyMesher::Face face, int plane,
+        std::pair<int, int> chunk, float cellSize,
+        std::vector<GreedyMesher::Quad>& quads )
+    {
+        const Direction& direction = DIRECTIONS[face];
+
+        // Cells are taken in row order, so every quad starts at its corner
+        while( !slice.empty() )
+        {
+            const int v = slice.begin()->first.first;
+            const int u = slice.begin()->first.second;
+            const Texture texture = slice.begin()->second;
+
+            int width = 1;
+            Slice::iterator next;
+            while( ( next = slice.find( std::make_pair( v, u + width ) ) ) !=
+                slice.end() && next->second == texture )
+            {
+                width++;
+            }
+
+            int height = 1;
+            bool rowMatches = true;
+            while( rowMatches )
+            {
+                for( int i = 0; i < width && rowMatches; i++ )
+                {
+                    next = slice.find( std::make_pair( v + height, u + i ) );
+                    rowMatches = next != slice.end() && next->second == texture;
+                }
+                if( rowMatches )
+                    height++;
+            }
+
+            for( int j = 0; j < height; j++ )
+                for( int i = 0; i < width; i++ )
+                    slice.erase( std::make_pair( v + j, u + i ) );
+
+            // Cubes are centered on the grid, so faces sit half a cell out
+            const QVector3D origin = ( direction.Normal * ( plane + 0.5f ) +
+                direction.U * ( u - 0.5f ) + direction.V * ( v - 0.5f ) ) *
+                cellSize;
+            const QVector3D right = direction.U * ( width * cellSize );
+            const QVector3D up = direction.V * ( height * cellSize );
+
+            GreedyMesher::Quad quad;
+            quad.SelectedTexture = texture;
+            quad.Direction = face;
+            quad.Chunk = chunk;
+            quad.Corners[0] = origin;
+            quad.Corners[1] = origin + right;
+            quad.Corners[2] = origin + right + up;
+            quad.Corners[3] = origin + up;
+            quad.Tiles = QVector2D( width, height );
+            quads.push_back( quad );
+        }
+    }
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Builds the visible, merged faces of a set of grid aligned cubes.
+ *
+ * @param[in]  cells      The cubes, centered on a grid of cellSize spacing.
+ * @param[in]  cellSize   The edge length of a single cube.
+ * @param[in]  chunkSize  The number of cells along each side of a chunk.
+ *
+ * @return     The merged quads.
+ */
+std::vector<GreedyMesher::Quad> GreedyMesher::mesh(
+    const std::vector<Cell*>& cells, float cellSize, int chunkSize )
+{
+    std::map<Coordinate, Texture> grid;
+    for( const Cell* cell : cells )
+    {
+        grid[ Coordinate( std::lround( cell->Location.x() / cellSize ),
+            std::lround( cell->Location.y() / cellSize ),
+            std::lround( cell->Location.z() / cellSize ) ) ] =
+            cell->selectedTexture();
+    }
+
+    std::vector<Quad> quads;
+    for( int face = 0; face < FaceCount; face++ )
+    {
+        // The board is only ever seen from above
+        if( face == NegativeY )
+            continue;
+
+        const Direction& direction = DIRECTIONS[face];
+
+        // Planes of faces, split by chunk
+        std::map< std::tuple<int, int, int>, Slice > slices;
+
+        for( std::map<Coordinate, Texture>::const_iterator iter = grid.begin();
+            iter != grid.end(); iter++ )
+        {
+            const Coordinate& cube = iter->first;
+            const Coordinate neighbour(
+                std::get<0>( cube ) + (int)direction.Normal.x(),
+                std::get<1>( cube ) + (int)direction.Normal.y(),
+                std::get<2>( cube ) + (int)direction.Normal.z() );
+
+            if( grid.count( neighbour ) )
+                continue;
+
+            const std::tuple<int, int, int> slice(
+                project( cube, direction.Normal ),
+                chunkOf( std::get<0>( cube ), chunkSize ),
+                chunkOf( std::get<2>( cube ), chunkSize ) );
+            slices[slice][ std::make_pair(
+                project( cube, direction.V ), project( cube, direction.U ) ) ] =
+                iter->second;
+        }
+
+        for( std::map< std::tuple<int, int, int>, Slice >::iterator slice =
+            slices.begin(); slice != slices.end(); slice++ )
+        {
+            mergeSlice( slice->second, (Face)face,
+                std::get<0>( slice->first ), std::make_pair(
+                std::get<1>( slice->first ), std::get<2>( slice->first ) ),
+                cellSize, quads );
+        }
+    }
+
+    return quads;
+}
+
+/**
+ * @brief      Gets the part of a cube texture showing one face. Cube textures
+ *             are laid out as a cross of 3 by 4 faces, matching
+ *             models/UVCube.obj.
+ *
+ * @param[in]  face  The face of the cube.
+ *
+ * @return     The face's cell of the cross.
+ */
+TextureCache::Region GreedyMesher::atlasRegion( Face face )
+{
+    switch( face )
+    {
+        case PositiveX:
+            return TextureCache::Region( 1, 1, 3, 4 );
+        case NegativeX:
+            return TextureCache::Region( 1, 3, 3, 4 );
+        case PositiveY:
+            return TextureCache::Region( 0, 1, 3, 4 );
+        case NegativeY:
+            return TextureCache::Region( 2, 1, 3, 4 );
+        case PositiveZ:
+            return TextureCache::Region( 1, 0, 3, 4 );
+        case NegativeZ:
+        default:
+            return TextureCache::Region( 1, 2, 3, 4 );
+    }
+}
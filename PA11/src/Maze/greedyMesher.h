@@ -0,0 +1,60 @@
+#ifndef GREEDY_MESHER_H
+#define GREEDY_MESHER_H
+
+#include <QVector2D>
+#include <QVector3D>
+
+#include <utility>
+#include <vector>
+
+#include "3D/textureCache.h"
+#include "Maze/cell.h"
+
+/**
+ * @brief      Turns the labyrinth's cubes into as few textured quads as
+ *             possible.
+ * @details    Faces against a neighbouring cube, and every bottom face, are
+ * never seen and are dropped. The remaining faces are grouped by plane and
+ * direction, and each plane is greedily covered with rectangles of faces that
+ * share a texture, growing every rectangle along its first axis and then its
+ * second. A rectangle repeats the cube's face once per cell it covers, so
+ * each face of a cube texture is drawn from a texture of its own that can
+ * be repeated (see atlasRegion).
+ *
+ * Rectangles never cross from one square chunk of cells into the next, so
+ * chunks can be drawn or culled on their own.
+ */
+namespace GreedyMesher
+{
+    enum Face
+    {
+        PositiveX,
+        NegativeX,
+        PositiveY,
+        NegativeY,
+        PositiveZ,
+        NegativeZ,
+        FaceCount
+    };
+
+    struct Quad
+    {
+        Texture SelectedTexture;
+        Face Direction;
+
+        // Chunk of the cells covered, in chunks along x and z
+        std::pair<int, int> Chunk;
+
+        // Counter clockwise when seen from the front
+        QVector3D Corners[4];
+
+        // Number of cube faces covered along each side
+        QVector2D Tiles;
+    };
+
+    std::vector<Quad> mesh( const std::vector<Cell*>& cells, float cellSize,
+        int chunkSize );
+    TextureCache::Region atlasRegion( Face face );
+};
+
+#endif  //  GREEDY_MESHER_H
@@ -0,0 +1,164 @@
+#include "hintPath.h"
+
+#include "3D/resourceCache.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for an empty, hidden HintPath.
+ */
+HintPath::HintPath()
+    :   Visible( false ), m_vbo( NULL ), m_vao( NULL ), m_numVertices( 0 ),
+        m_dirty( false )
+{
+}
+
+/**
+ * @brief      Destructor for HintPath.
+ */
+HintPath::~HintPath()
+{
+    teardownGL();
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Replaces the path, fading from the first point to the last.
+ *
+ * @param[in]  points  The points of the path, in world space.
+ */
+void HintPath::setPath( const std::vector<QVector3D>& points )
+{
+    const QVector4D start( 1.0f, 0.9f, 0.2f, 1.0f );
+    const QVector4D end( 1.0f, 0.3f, 0.1f, 1.0f );
+
+    m_vertices.clear();
+    m_bounds = Bounds();
+    for( unsigned i = 0; i < points.size(); i++ )
+    {
+        m_bounds.expand( points[i] );
+        const float t = points.size() > 1 ? i / ( points.size() - 1.0f ) : 0;
+        m_vertices.push_back( ColorVertex( points[i],
+            start * ( 1.0f - t ) + end * t ) );
+    }
+
+    m_dirty = true;
+}
+
+//
+// RENDERABLE FUNCTIONS ////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Creates the buffer the path is streamed into.
+ */
+void HintPath::initializeGL()
+{
+    initializeOpenGLFunctions();
+
+    m_program = ResourceCache::program( PATH_TO_V_SHADER, PATH_TO_F_SHADER );
+    m_program->bind();
+
+    m_modelClip = m_program->uniformLocation( "model_to_clip" );
+
+    m_vbo = new QOpenGLBuffer();
+    m_vbo->create();
+    m_vbo->bind();
+    m_vbo->setUsagePattern( QOpenGLBuffer::DynamicDraw );
+
+    m_vao = new QOpenGLVertexArrayObject();
+    m_vao->create();
+    m_vao->bind();
+
+    m_program->enableAttributeArray( "position" );
+    m_program->enableAttributeArray( "color" );
+    m_program->setAttributeBuffer(  "position",
+                                    GL_FLOAT,
+                                    ColorVertex::positionOffset(),
+                                    ColorVertex::PositionTupleSize,
+                                    ColorVertex::stride() );
+    m_program->setAttributeBuffer(  "color",
+                                    GL_FLOAT,
+                                    ColorVertex::colorOffset(),
+                                    ColorVertex::ColorTupleSize,
+                                    ColorVertex::stride() );
+
+    m_vao->release();
+    m_vbo->release();
+    m_program->release();
+}
+
+/**
+ * @brief      Uploads the path if it changed, then queues it to be drawn.
+ *
+ * @param      queue  The queue of the frame.
+ */
+void HintPath::submit( RenderQueue& queue )
+{
+    if( !Visible || m_vbo == NULL )
+        return;
+
+    if( m_dirty )
+    {
+        m_vbo->bind();
+        m_vbo->allocate( m_vertices.data(),
+            m_vertices.size() * sizeof( ColorVertex ) );
+        m_vbo->release();
+
+        m_numVertices = m_vertices.size();
+        m_dirty = false;
+    }
+
+    if( m_numVertices < 2 )
+        return;
+
+    RenderQueue::Item item;
+    item.Program = m_program.data();
+    item.VAO = m_vao;
+    item.LineWidth = 4.0f;
+    item.ModelClip = m_modelClip;
+    item.Center = m_bounds.center();
+    item.Mode = GL_LINE_STRIP;
+    item.Count = m_numVertices;
+    queue.submit( item );
+}
+
+/**
+ * @brief      The path is set by the game, there is nothing to update.
+ */
+void HintPath::update()
+{
+}
+
+/**
+ * @brief      Helper function to delete OpenGL data.
+ */
+void HintPath::teardownGL()
+{
+    delete m_vbo;
+    delete m_vao;
+
+    m_vbo = NULL;
+    m_vao = NULL;
+
+    m_program.clear();
+}
+
+/**
+ * @brief      Gets the box around the path. A hidden path is never drawn, so
+ *             it is left out of culling.
+ *
+ * @param[out] bounds  The world space bounds.
+ *
+ * @return     True while the path is visible.
+ */
+bool HintPath::worldBounds( Bounds& bounds )
+{
+    bounds = m_bounds;
+    return Visible;
+}
@@ -0,0 +1,60 @@
+#ifndef HINT_PATH_H
+#define HINT_PATH_H
+
+#include <QOpenGLBuffer>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLVertexArrayObject>
+
+#include <QMatrix4x4>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector3D>
+
+#include <vector>
+
+#include "3D/bounds.h"
+#include "3D/colorVertex.h"
+#include "3D/renderable.h"
+#include "Controls/camera3d.h"
+
+/**
+ * @brief      Line drawn over the floor along the way to the goal.
+ * @details    The points are only re-uploaded when the path changes, which
+ * happens when the ball it starts from rolls into another cell.
+ */
+class HintPath  :   public Renderable
+{
+public:
+    HintPath();
+    ~HintPath();
+
+    void setPath( const std::vector<QVector3D>& points );
+
+    // Renderable Functions
+    void initializeGL();
+    void submit( RenderQueue& queue );
+    void update();
+    void teardownGL();
+    bool worldBounds( Bounds& bounds );
+
+    bool Visible;
+
+private:
+    // OpenGL State Data
+    QOpenGLBuffer* m_vbo;
+    QOpenGLVertexArrayObject* m_vao;
+    QSharedPointer<QOpenGLShaderProgram> m_program;
+
+    // Path Information
+    std::vector<ColorVertex> m_vertices;
+    Bounds m_bounds;
+    int m_numVertices;
+    bool m_dirty;
+
+    // Shader Information
+    const QString PATH_TO_V_SHADER = ":/shader/colorShader.vs";
+    const QString PATH_TO_F_SHADER = ":/shader/colorShader.fs";
+    int m_modelClip;
+};
+
+#endif  //  HINT_PATH_H
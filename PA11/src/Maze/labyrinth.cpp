@@ -1,106 +1,123 @@
 #include "labyrinth.h"
 #include <QFileInfo>
+#include <algorithm>
+#include <cmath>
+
+#include "Controls/profiler.h"
 
 Labyrinth::Labyrinth( Environment env, int seed, int width, int height )
-    :   m_env( env ), m_seed( seed ), m_width( width ), m_height( height )
+    :   m_env( env ), m_visibility( CHUNK_SIZE ), m_seed( seed ),
+        m_width( width ), m_height( height )
 {
     m_maze = MazeGenerator::makeMaze( m_seed, m_width, m_height );
 
 
-    player = new QMediaPlayer(); 
-      
-    QString file;  
-    if( m_env == Environment::Rock ){
-        file = "sounds/rock.mp3";
-    }
-    else{
-        file = "sounds/ice.mp3";
-    }
-
-    QUrl url = QUrl::fromLocalFile(QFileInfo(file).absoluteFilePath());
-    player->setMedia(url);
-    player->setVolume(800); 
-    player->play();
+    player = playMusic( m_env );
 
+    std::pair<int, int> goal( m_width / 2, m_height / 2 );
     float xpos = 0.0f, zpos = 0.0f;
-    for( unsigned int y = 0; y < m_maze[0].size(); ++y )
+    for( int y = 0; y < m_maze.height(); ++y )
     {
-        for( unsigned int x = 0; x < m_maze.size(); ++x )
+        for( int x = 0; x < m_maze.width(); ++x )
         {
-            if( m_maze[x][y] == MazeGenerator::START )
+            const int cell = m_maze.at( x, y );
+            if( cell == MazeGenerator::START )
             {
                 m_startingLocation.first = xpos;
                 m_startingLocation.second = zpos;
             }
+            else if( cell == MazeGenerator::END )
+                goal = std::pair<int, int>( x, y );
 
-            if( m_maze[x][y] == MazeGenerator::WALL )
-            {
-                if( m_env == Environment::Rock )
-                    m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( xpos, 2.0f, zpos ) ), Cell::getRandomRockWall() ) );
-                else if( m_env == Environment::Ice )
-                    m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( xpos, 2.0f, zpos ) ), Cell::getRandomIceWall() ) );
-            }
-            else if ( m_maze[x][y] == MazeGenerator::FLOOR || m_maze[x][y] == MazeGenerator::START )
-            {
-                if( m_env == Environment::Rock )
-                    m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( xpos, 0.0f, zpos ) ), Texture::DirtFloor ) );
-                else if( m_env == Environment::Ice )
-                    m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( xpos, 0.0f, zpos ) ), Texture::SnowFloor ) );
-            }
+            if( cell == MazeGenerator::WALL )
+                addWall( xpos, zpos );
+            else if ( cell == MazeGenerator::FLOOR || cell == MazeGenerator::START )
+                addFloor( xpos, zpos );
             xpos += 2.0f;
         }
         xpos = 0.0f;
         zpos += 2.0f;
     }
 
-    if( m_env == Environment::Rock )
+    // North
+    for( float i = -2.0f; i <= m_maze.width() * 2.0f; i += 2.0f )
+        addWall( i, -2.0f );
+    // South
+    for( float i = -2.0f; i <= m_maze.width() * 2.0f; i += 2.0f )
+        addWall( i, m_maze.height() * 2.0f );
+    // East
+    for( float i = 0.0f; i < m_maze.width() * 2.0f; i += 2.0f )
+        addWall( -2.0f, i );
+    // West
+    for( float i = -2.0f; i < m_maze.width() * 2.0f; i += 2.0f )
+        addWall( m_maze.height() * 2.0f, i );
+
+    // Only the visible faces are drawn, merged into quads grouped by chunk,
+    // texture and direction so each face texture of a chunk is drawn in one
+    // call, for the potentially visible set below the walls
+    for( const GreedyMesher::Quad& quad :
+        GreedyMesher::mesh( m_cells, 2.0f, CHUNK_SIZE ) )
+    {
+        std::vector<CellBatch*>& chunk = m_chunks[ quad.Chunk ];
+        if( chunk.empty() )
+        {
+            chunk.resize( Texture::TextureCount * GreedyMesher::FaceCount,
+                NULL );
+        }
+
+        CellBatch*& batch = chunk[ CellBatch::index( quad.SelectedTexture,
+            quad.Direction ) ];
+        if( batch == NULL )
+        {
+            batch = new CellBatch( quad.SelectedTexture, quad.Direction );
+            m_batches.push_back( batch );
+        }
+        batch->addQuad( quad );
+    }
+
+    for( std::map< PotentiallyVisibleSet::Chunk, std::vector<CellBatch*> >::
+        iterator chunk = m_chunks.begin(); chunk != m_chunks.end(); chunk++ )
     {
-        // North
-        for( float i = -2.0f; i <= m_maze.size() * 2.0f; i += 2.0f )
-            m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( i, 2.0f, -2.0f ) ), Cell::getRandomRockWall() ) );
-        // South
-        for( float i = -2.0f; i <= m_maze.size() * 2.0f; i += 2.0f )
-            m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( i, 2.0f, m_maze[0].size() * 2.0f ) ), Cell::getRandomRockWall() ) );
-        // East
-        for( float i = 0.0f; i < m_maze.size() * 2.0f; i += 2.0f )
-            m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( -2.0, 2.0f, i ) ), Cell::getRandomRockWall() ) );
-        // West
-        for( float i = -2.0f; i < m_maze.size() * 2.0f; i += 2.0f )
-            m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3(  m_maze[0].size() * 2.0f, 2.0f, i ) ), Cell::getRandomRockWall() ) );
+        chunk->second.erase( std::remove( chunk->second.begin(),
+            chunk->second.end(), (CellBatch*)NULL ), chunk->second.end() );
     }
-    else if( m_env == Environment::Ice )
+
+    // Above the walls most of the maze is in view at once, so it is drawn
+    // from one batch per texture and direction, merged across the chunks
+    const int mazeChunk = std::max( m_maze.width(), m_maze.height() ) + 1;
+    std::vector<CellBatch*> overview(
+        Texture::TextureCount * GreedyMesher::FaceCount, NULL );
+    for( const GreedyMesher::Quad& quad :
+        GreedyMesher::mesh( m_cells, 2.0f, mazeChunk ) )
     {
-        // North
-        for( float i = -2.0f; i <= m_maze.size() * 2.0f; i += 2.0f )
-            m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( i, 2.0f, -2.0f ) ), Cell::getRandomIceWall() ) );
-        // South
-        for( float i = -2.0f; i <= m_maze.size() * 2.0f; i += 2.0f )
-            m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( i, 2.0f, m_maze[0].size() * 2.0f ) ), Cell::getRandomIceWall() ) );
-        // East
-        for( float i = 0.0f; i < m_maze.size() * 2.0f; i += 2.0f )
-            m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3( -2.0, 2.0f, i ) ), Cell::getRandomIceWall() ) );
-        // West
-        for( float i = -2.0f; i < m_maze.size() * 2.0f; i += 2.0f )
-            m_cells.push_back( new Cell( btTransform( getRandomRotation(), 
-                        btVector3(  m_maze[0].size() * 2.0f, 2.0f, i ) ), Cell::getRandomIceWall() ) );
+        CellBatch*& batch = overview[ CellBatch::index( quad.SelectedTexture,
+            quad.Direction ) ];
+        if( batch == NULL )
+        {
+            batch = new CellBatch( quad.SelectedTexture, quad.Direction );
+            m_overview.push_back( batch );
+        }
+        batch->addQuad( quad );
     }
+
+    std::vector<Bounds> bounds;
+    for( CellBatch* batch : m_overview )
+        bounds.push_back( batch->bounds() );
+    m_tree.build( bounds );
+
+    m_visibility.build( m_maze );
+    m_distanceField.start( m_maze, goal.first, goal.second );
+
+    // Merge the cells into one static body
+    m_collision = new LabyrinthCollision( 2.0f );
+    for( Cell* cell : m_cells )
+        m_collision->addCube( cell->Location );
+    m_collision->build();
 }
 
 void Labyrinth::addRigidBodies( btDiscreteDynamicsWorld* dynamicsWorld )
 {
-    for( Cell* cell : m_cells )
-        dynamicsWorld->addRigidBody( cell->RigidBody );
+    dynamicsWorld->addRigidBody( m_collision->RigidBody );
 }
 
 
@@ -109,22 +126,86 @@ std::pair<float, float> Labyrinth::getStartingLocation()
     return m_startingLocation;
 }
 
+/**
+ * @brief      Gets the distance of every cell to the hole.
+ *
+ * @return     The distance field of the maze.
+ */
+const DistanceField& Labyrinth::distanceField() const
+{
+    return m_distanceField;
+}
+
+/**
+ * @brief      Gets the cell the distance field starts at. The field covers
+ *             the whole maze, which starts at the first cell.
+ *
+ * @return     The x and z cell of the field's first cell.
+ */
+std::pair<int, int> Labyrinth::fieldOrigin() const
+{
+    return std::pair<int, int>( 0, 0 );
+}
+
 void Labyrinth::initializeGL()
 {
-    for( Cell* cell : m_cells )
-        cell->initializeGL();
+    initializeOpenGLFunctions();
+
+    for( CellBatch* batch : m_batches )
+        batch->initializeGL();
+    for( CellBatch* batch : m_overview )
+        batch->initializeGL();
 }
 
-void Labyrinth::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void Labyrinth::submit( RenderQueue& queue )
 {
-    for( Cell* cell : m_cells )
-        cell->paintGL( camera, projection );
+    const Frustum& frustum = queue.frustum();
+
+    // Inside the maze and below the walls, only draw the chunks in sight
+    const QVector3D& eye = queue.eye();
+    const std::vector<PotentiallyVisibleSet::Chunk>* visible = NULL;
+    if( eye.y() < WALL_TOP )
+        visible = m_visibility.visibleChunks( std::floor( eye.x() / 2.0f + 0.5f ),
+            std::floor( eye.z() / 2.0f + 0.5f ) );
+
+    // Otherwise nothing is hidden behind the walls, only outside the view
+    if( visible == NULL )
+    {
+        std::vector<int> inView;
+        m_tree.query( frustum, inView );
+        for( int index : inView )
+            m_overview[index]->submit( queue );
+
+        Profiler::countCulling( inView.size(),
+            m_overview.size() - inView.size() );
+        return;
+    }
+
+    int drawn = 0;
+    for( const PotentiallyVisibleSet::Chunk& chunk : *visible )
+    {
+        std::map< PotentiallyVisibleSet::Chunk, std::vector<CellBatch*> >::
+            iterator batches = m_chunks.find( chunk );
+        if( batches == m_chunks.end() )
+            continue;
+
+        for( CellBatch* batch : batches->second )
+        {
+            if( !frustum.intersects( batch->bounds() ) )
+                continue;
+
+            batch->submit( queue );
+            drawn++;
+        }
+    }
+    Profiler::countCulling( drawn, m_batches.size() - drawn );
 }
 
 void Labyrinth::update()
 {
-    for( Cell* cell : m_cells )
-        cell->update();
+    // The field is spread over the first ticks, so a large maze never stalls
+    if( !m_distanceField.isSettled() )
+        m_distanceField.advance( m_maze, DistanceField::CELLS_PER_TICK );
 
     if(QMediaPlayer::StoppedState){
         player->play();
@@ -133,8 +214,10 @@ void Labyrinth::update()
 
 void Labyrinth::teardownGL()
 {
-    for( Cell* cell : m_cells )
-        cell->teardownGL();
+    for( CellBatch* batch : m_batches )
+        batch->teardownGL();
+    for( CellBatch* batch : m_overview )
+        batch->teardownGL();
 }
 
 Environment Labyrinth::getRandomEnvironment()
@@ -153,24 +236,104 @@ Environment Labyrinth::getRandomEnvironment()
     }
 }
 
-btQuaternion Labyrinth::getRandomRotation()
+/**
+ * @brief      Starts the music of an environment.
+ *
+ * @param[in]  env   The environment of the labyrinth.
+ *
+ * @return     The player of the music.
+ */
+QMediaPlayer* Labyrinth::playMusic( Environment env )
+{
+    QMediaPlayer* player = new QMediaPlayer(); 
+      
+    QString file;  
+    if( env == Environment::Rock ){
+        file = "sounds/rock.mp3";
+    }
+    else{
+        file = "sounds/ice.mp3";
+    }
+
+    QUrl url = QUrl::fromLocalFile(QFileInfo(file).absoluteFilePath());
+    player->setMedia(url);
+    player->setVolume(800); 
+    player->play();
+
+    return player;
+}
+
+/**
+ * @brief      Queues every face texture a labyrinth may use, whichever
+ *             environment is picked. Bottom faces are never drawn.
+ *
+ * @param      loader  The loader to queue the assets on.
+ */
+void Labyrinth::queueAssets( AssetLoader& loader )
 {
-    switch( rand() % 4 )
+    for( int texture = 0; texture < Texture::TextureCount; texture++ )
     {
-        case 0:
-            return btQuaternion( 1, 0, 0, 1 );
-            break;
-        case 1:
-            return btQuaternion( 0, 1, 0, 1 );
-            break;
-        case 2:
-            return btQuaternion( 0, 0, 1, 1 );
-            break;
-        case 3:
-            return btQuaternion( 0, 0, 0, 1 );
-            break;
-        default:
-            return btQuaternion( 0, 0, 0, 1 );
-            break;
+        for( int face = 0; face < GreedyMesher::FaceCount; face++ )
+        {
+            if( face == GreedyMesher::NegativeY )
+                continue;
+
+            loader.addTexture( CellBatch::texturePath( (Texture)texture ),
+                GreedyMesher::atlasRegion( (GreedyMesher::Face)face ) );
+        }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief      Adds a wall cube on top of a floor cube. The floor under a wall
+ *             is never seen, but it hides the sides of the floor around it and
+ *             lets the floor merge into fewer faces and collision boxes.
+ *
+ * @param[in]  x     The x location of the cube.
+ * @param[in]  z     The z location of the cube.
+ */
+void Labyrinth::addWall( float x, float z )
+{
+    m_cells.push_back( new Cell( btVector3( x, 2.0f, z ), wallTexture( x, z ) ) );
+    addFloor( x, z );
+}
+
+/**
+ * @brief      Adds a floor cube.
+ *
+ * @param[in]  x     The x location of the cube.
+ * @param[in]  z     The z location of the cube.
+ */
+void Labyrinth::addFloor( float x, float z )
+{
+    const Texture texture = m_env == Environment::Rock ?
+        Texture::DirtFloor : Texture::SnowFloor;
+    m_cells.push_back( new Cell( btVector3( x, 0.0f, z ), texture ) );
+}
+
+/**
+ * @brief      Picks the texture of a wall. Walls are textured in blocks of
+ *             WALL_BLOCK by WALL_BLOCK cells rather than one by one, so
+ *             neighbouring walls can be merged into larger quads.
+ *
+ * @param[in]  x     The x location of the wall.
+ * @param[in]  z     The z location of the wall.
+ *
+ * @return     The texture of the wall's block.
+ */
+Texture Labyrinth::wallTexture( float x, float z )
+{
+    const int blockSize = 2 * WALL_BLOCK;
+    const std::pair<int, int> block( std::floor( x / blockSize ),
+        std::floor( z / blockSize ) );
+
+    std::map< std::pair<int, int>, Texture >::iterator iter =
+        m_wallTextures.find( block );
+    if( iter != m_wallTextures.end() )
+        return iter->second;
+
+    const Texture texture = m_env == Environment::Rock ?
+        Cell::getRandomRockWall() : Cell::getRandomIceWall();
+    m_wallTextures[ block ] = texture;
+    return texture;
+}
@@ -2,10 +2,19 @@
 #define LABYRINTH_H
 
 #include <QMatrix4x4>
+#include <map>
+#include <utility>
 #include <vector>
 
+#include "3D/assetLoader.h"
+#include "3D/boundsTree.h"
 #include "Maze/cell.h"
+#include "Maze/cellBatch.h"
+#include "Maze/distanceField.h"
+#include "Maze/greedyMesher.h"
+#include "Maze/labyrinthCollision.h"
 #include "Maze/mazeGenerator.h"
+#include "Maze/potentiallyVisibleSet.h"
 
 #include "Controls/camera3d.h"
 
@@ -24,25 +33,51 @@ public:
     Labyrinth( Environment env, int seed, int width, int height );
     void addRigidBodies( btDiscreteDynamicsWorld* dynamicsWorld );
     std::pair<float, float> getStartingLocation();
+    const DistanceField& distanceField() const;
+    std::pair<int, int> fieldOrigin() const;
 
     // Renderable Functions
     void initializeGL();
-    void paintGL( Camera3D& camera, QMatrix4x4& projection );
+    void submit( RenderQueue& queue );
     void update();
     void teardownGL();
 
     static Environment getRandomEnvironment();
+    static QMediaPlayer* playMusic( Environment env );
+    static void queueAssets( AssetLoader& loader );
 
 private:
 
     QMediaPlayer *player;
 
-    btQuaternion getRandomRotation();
+    void addWall( float x, float z );
+    void addFloor( float x, float z );
+    Texture wallTexture( float x, float z );
+
+    // Walls share a texture in blocks of this many cells per side
+    const int WALL_BLOCK = 4;
+
+    // Cells per side of the chunks culled by the potentially visible set
+    const int CHUNK_SIZE = 8;
+
+    // Walls block the view of a camera lower than their tops
+    const float WALL_TOP = 3.0f;
 
     Environment m_env;
 
     std::vector< Cell* > m_cells;
-    std::vector< std::vector<int> > m_maze;
+    std::vector< CellBatch* > m_batches;
+    std::map< PotentiallyVisibleSet::Chunk, std::vector<CellBatch*> > m_chunks;
+    PotentiallyVisibleSet m_visibility;
+
+    // The whole maze in one batch per texture and direction, for the view
+    // from above the walls
+    std::vector< CellBatch* > m_overview;
+    BoundsTree m_tree;
+    std::map< std::pair<int, int>, Texture > m_wallTextures;
+    LabyrinthCollision* m_collision;
+    MazeGrid m_maze;
+    DistanceField m_distanceField;
     int m_seed;
     int m_width, m_height;
     std::pair<float, float> m_startingLocation;
@@ -0,0 +1,149 @@
+#include "labyrinthCollision.h"
+
+#include <cmath>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for LabyrinthCollision.
+ *
+ * @param[in]  cellSize  The edge length of a single cube.
+ */
+LabyrinthCollision::LabyrinthCollision( float cellSize )
+    :   RigidBody( NULL ), m_cellSize( cellSize ), m_collisionShape( NULL ),
+        m_motionState( NULL ), m_rigidBodyCI( NULL )
+{
+}
+
+/**
+ * @brief      Destructor for LabyrinthCollision. The body must already be
+ *             removed from its dynamics world.
+ */
+LabyrinthCollision::~LabyrinthCollision()
+{
+    delete RigidBody;
+    delete m_rigidBodyCI;
+    delete m_motionState;
+    delete m_collisionShape;
+
+    for( std::map< std::pair<int, int>, btBoxShape* >::iterator iter =
+        m_boxShapes.begin(); iter != m_boxShapes.end(); iter++ )
+    {
+        delete iter->second;
+    }
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Fills the grid cell a cube occupies. Must be called before
+ *             build.
+ *
+ * @param[in]  center  The center of the cube, on the cell grid.
+ */
+void LabyrinthCollision::addCube( const btVector3& center )
+{
+    const int x = std::lround( center.x() / m_cellSize );
+    const int y = std::lround( center.y() / m_cellSize );
+    const int z = std::lround( center.z() / m_cellSize );
+
+    m_layers[y].insert( std::make_pair( z, x ) );
+}
+
+/**
+ * @brief      Merges the filled cells into boxes and creates the static
+ *             rigid body holding them.
+ */
+void LabyrinthCollision::build()
+{
+    m_collisionShape = new btCompoundShape();
+
+    for( std::map< int, std::set< std::pair<int, int> > >::iterator layer =
+        m_layers.begin(); layer != m_layers.end(); layer++ )
+    {
+        std::set< std::pair<int, int> >& cells = layer->second;
+
+        // Cells are taken in row order, so every box starts at its top left
+        while( !cells.empty() )
+        {
+            const int z = cells.begin()->first;
+            const int x = cells.begin()->second;
+
+            int width = 1;
+            while( cells.count( std::make_pair( z, x + width ) ) )
+                width++;
+
+            int depth = 1;
+            bool rowFilled = true;
+            while( rowFilled )
+            {
+                for( int i = 0; i < width && rowFilled; i++ )
+                    rowFilled = cells.count( std::make_pair( z + depth, x + i ) );
+                if( rowFilled )
+                    depth++;
+            }
+
+            for( int j = 0; j < depth; j++ )
+                for( int i = 0; i < width; i++ )
+                    cells.erase( std::make_pair( z + j, x + i ) );
+
+            const btVector3 center(
+                ( x + ( width - 1 ) * 0.5f ) * m_cellSize,
+                layer->first * m_cellSize,
+                ( z + ( depth - 1 ) * 0.5f ) * m_cellSize );
+            m_collisionShape->addChildShape(
+                btTransform( btQuaternion( 0, 0, 0, 1 ), center ),
+                boxShape( width, depth ) );
+        }
+    }
+    m_layers.clear();
+
+    m_motionState = new btDefaultMotionState(
+        btTransform( btQuaternion( 0, 0, 0, 1 ), btVector3( 0, 0, 0 ) ) );
+
+    // No mass, so the body is static and never simulated or woken up
+    m_rigidBodyCI = new btRigidBody::btRigidBodyConstructionInfo(
+        0, m_motionState, m_collisionShape, btVector3( 0, 0, 0 ) );
+    RigidBody = new btRigidBody( *m_rigidBodyCI );
+}
+
+/**
+ * @brief      Gets the number of boxes the cells were merged into.
+ *
+ * @return     The number of boxes.
+ */
+int LabyrinthCollision::numBoxes() const
+{
+    return m_collisionShape == NULL ? 0 :
+        m_collisionShape->getNumChildShapes();
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the box shape covering a block of cells, shared between
+ *             every box of the same size.
+ *
+ * @param[in]  width  The number of cells along x.
+ * @param[in]  depth  The number of cells along z.
+ *
+ * @return     The box shape.
+ */
+btBoxShape* LabyrinthCollision::boxShape( int width, int depth )
+{
+    btBoxShape*& shape = m_boxShapes[ std::make_pair( width, depth ) ];
+    if( shape == NULL )
+    {
+        const float half = m_cellSize * 0.5f;
+        shape = new btBoxShape( btVector3( width * half, half,
+            depth * half ) );
+    }
+
+    return shape;
+}
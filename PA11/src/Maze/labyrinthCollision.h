@@ -0,0 +1,47 @@
+#ifndef LABYRINTH_COLLISION_H
+#define LABYRINTH_COLLISION_H
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+/**
+ * @brief      Static collision of the whole labyrinth as one rigid body.
+ * @details    The labyrinth is a grid of equally sized cubes. Each layer of
+ * cubes is merged into as few boxes as possible, greedily growing every box
+ * along x and then along z, and the boxes are put in a single compound shape.
+ * The broadphase then only ever sees one static object, however large the
+ * maze is, and the compound's own tree narrows contacts down to nearby boxes.
+ */
+class LabyrinthCollision
+{
+public:
+    LabyrinthCollision( float cellSize );
+    ~LabyrinthCollision();
+
+    void addCube( const btVector3& center );
+    void build();
+
+    int numBoxes() const;
+
+    btRigidBody* RigidBody;
+
+private:
+    btBoxShape* boxShape( int width, int depth );
+
+    float m_cellSize;
+
+    // Filled cells of each layer, keyed by ( z, x ) so rows are contiguous
+    std::map< int, std::set< std::pair<int, int> > > m_layers;
+
+    // Bullet Information
+    btCompoundShape* m_collisionShape;
+    std::map< std::pair<int, int>, btBoxShape* > m_boxShapes;
+    btDefaultMotionState* m_motionState;
+    btRigidBody::btRigidBodyConstructionInfo* m_rigidBodyCI;
+};
+
+#endif  //  LABYRINTH_COLLISION_H
@@ -0,0 +1,224 @@
+#include "labyrinthTile.h"
+
+#include <cmath>
+
+#include "Maze/cell.h"
+#include "Maze/greedyMesher.h"
+#include "Maze/mazeGenerator.h"
+#include "Maze/random.h"
+
+const float LabyrinthTile::CELL_SIZE = 2.0f;
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for LabyrinthTile. Generates, meshes and builds the
+ *             collision of the tile without touching OpenGL or the world.
+ *
+ * @param[in]  env    The environment of the labyrinth.
+ * @param[in]  seed   The seed of the whole labyrinth.
+ * @param[in]  coord  The tile, in tiles along x and z.
+ */
+LabyrinthTile::LabyrinthTile( Environment env, uint64_t seed, Coord coord )
+    :   m_coord( coord ), m_collision( NULL )
+{
+    Random random( Random::hash( seed, coord.first, coord.second ) );
+    m_maze = MazeGenerator::makeTile( random.next(), SIZE );
+
+    // Doors into the west and north neighbours, whose rooms are on odd cells
+    m_maze.set( 0, 1 + 2 * random.nextInt( SIZE / 2 ), MazeGenerator::FLOOR );
+    m_maze.set( 1 + 2 * random.nextInt( SIZE / 2 ), 0, MazeGenerator::FLOOR );
+
+    const Texture floor = env == Environment::Rock ?
+        Texture::DirtFloor : Texture::SnowFloor;
+
+    std::vector<Cell*> cells;
+    for( int x = 0; x < SIZE; x++ )
+    {
+        for( int z = 0; z < SIZE; z++ )
+        {
+            const int cellX = coord.first * SIZE + x;
+            const int cellZ = coord.second * SIZE + z;
+            const float worldX = cellX * CELL_SIZE;
+            const float worldZ = cellZ * CELL_SIZE;
+
+            // Walls stand on a floor cube, see Labyrinth::addWall
+            if( m_maze.at( x, z ) == MazeGenerator::WALL )
+            {
+                cells.push_back( new Cell( btVector3( worldX, CELL_SIZE,
+                    worldZ ), wallTexture( env, seed, cellX, cellZ ) ) );
+            }
+            cells.push_back( new Cell( btVector3( worldX, 0.0f, worldZ ),
+                floor ) );
+        }
+    }
+
+    // A chunk is exactly one tile, so every quad stays inside it
+    std::vector<CellBatch*> batches(
+        Texture::TextureCount * GreedyMesher::FaceCount, NULL );
+    for( const GreedyMesher::Quad& quad :
+        GreedyMesher::mesh( cells, CELL_SIZE, SIZE ) )
+    {
+        CellBatch*& batch = batches[ CellBatch::index( quad.SelectedTexture,
+            quad.Direction ) ];
+        if( batch == NULL )
+        {
+            batch = new CellBatch( quad.SelectedTexture, quad.Direction );
+            m_batches.push_back( batch );
+        }
+        batch->addQuad( quad );
+    }
+
+    for( CellBatch* batch : m_batches )
+        m_bounds.expand( batch->bounds() );
+
+    m_collision = new LabyrinthCollision( CELL_SIZE );
+    for( Cell* cell : cells )
+    {
+        m_collision->addCube( cell->Location );
+        delete cell;
+    }
+    m_collision->build();
+}
+
+/**
+ * @brief      Destructor for LabyrinthTile. The tile must already be torn down
+ *             and removed from its dynamics world.
+ */
+LabyrinthTile::~LabyrinthTile()
+{
+    for( CellBatch* batch : m_batches )
+        delete batch;
+
+    delete m_collision;
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the position of the tile.
+ *
+ * @return     The tile, in tiles along x and z.
+ */
+LabyrinthTile::Coord LabyrinthTile::coord() const
+{
+    return m_coord;
+}
+
+/**
+ * @brief      Gets the cells of the tile.
+ *
+ * @return     The tile's maze, indexed from its first cell.
+ */
+const MazeGrid& LabyrinthTile::maze() const
+{
+    return m_maze;
+}
+
+/**
+ * @brief      Gets the box around everything the tile draws.
+ *
+ * @return     The world space bounds of the tile.
+ */
+const Bounds& LabyrinthTile::bounds() const
+{
+    return m_bounds;
+}
+
+/**
+ * @brief      Uploads the tile's batches.
+ */
+void LabyrinthTile::initializeGL()
+{
+    for( CellBatch* batch : m_batches )
+        batch->initializeGL();
+}
+
+/**
+ * @brief      Queues the tile, one draw per face texture.
+ *
+ * @param      queue  The queue of the frame.
+ */
+void LabyrinthTile::submit( RenderQueue& queue )
+{
+    for( CellBatch* batch : m_batches )
+        batch->submit( queue );
+}
+
+/**
+ * @brief      Releases the GPU copy of the tile's batches.
+ */
+void LabyrinthTile::teardownGL()
+{
+    for( CellBatch* batch : m_batches )
+        batch->teardownGL();
+}
+
+/**
+ * @brief      Adds the tile's static body to a dynamics world.
+ *
+ * @param      dynamicsWorld  The world to add the tile to.
+ */
+void LabyrinthTile::addRigidBodies( btDiscreteDynamicsWorld* dynamicsWorld )
+{
+    dynamicsWorld->addRigidBody( m_collision->RigidBody );
+}
+
+/**
+ * @brief      Removes the tile's static body from a dynamics world.
+ *
+ * @param      dynamicsWorld  The world the tile was added to.
+ */
+void LabyrinthTile::removeRigidBodies( btDiscreteDynamicsWorld* dynamicsWorld )
+{
+    dynamicsWorld->removeRigidBody( m_collision->RigidBody );
+}
+
+/**
+ * @brief      Gets the tile a point of the world is over.
+ *
+ * @param[in]  position  The point, in world space.
+ *
+ * @return     The tile, in tiles along x and z.
+ */
+LabyrinthTile::Coord LabyrinthTile::tileOf( const btVector3& position )
+{
+    const int cellX = std::floor( position.x() / CELL_SIZE + 0.5f );
+    const int cellZ = std::floor( position.z() / CELL_SIZE + 0.5f );
+
+    // Rounds towards negative infinity
+    return Coord( ( cellX < 0 ? cellX - SIZE + 1 : cellX ) / SIZE,
+        ( cellZ < 0 ? cellZ - SIZE + 1 : cellZ ) / SIZE );
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Picks the texture of a wall from the seed, the same for every
+ *             wall of a WALL_BLOCK by WALL_BLOCK block.
+ *
+ * @param[in]  env   The environment of the labyrinth.
+ * @param[in]  seed  The seed of the whole labyrinth.
+ * @param[in]  x     The x cell of the wall.
+ * @param[in]  z     The z cell of the wall.
+ *
+ * @return     The texture of the wall's block.
+ */
+Texture LabyrinthTile::wallTexture( Environment env, uint64_t seed, int x,
+    int z ) const
+{
+    const int blockX = ( x < 0 ? x - WALL_BLOCK + 1 : x ) / WALL_BLOCK;
+    const int blockZ = ( z < 0 ? z - WALL_BLOCK + 1 : z ) / WALL_BLOCK;
+
+    // The five wall textures of each environment are listed in a row
+    const int first = env == Environment::Rock ?
+        Texture::RockWall1 : Texture::IceWall1;
+    return (Texture)( first +
+        Random::hash( ~seed, blockX, blockZ ) % 5 );
+}
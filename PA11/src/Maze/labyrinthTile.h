@@ -0,0 +1,67 @@
+#ifndef LABYRINTH_TILE_H
+#define LABYRINTH_TILE_H
+
+#include <QMatrix4x4>
+#include <utility>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "3D/bounds.h"
+#include "3D/renderQueue.h"
+#include "Maze/cellBatch.h"
+#include "Maze/labyrinth.h"
+#include "Maze/labyrinthCollision.h"
+#include "Maze/mazeGrid.h"
+
+/**
+ * @brief      One square tile of a StreamingLabyrinth.
+ * @details    A tile is a maze of SIZE by SIZE cells that owns the walls along
+ * its west and north edges, with one door through each, so neighbouring tiles
+ * always join up and every tile can be generated from the seed on its own.
+ *
+ * The constructor does everything on the CPU, generating the maze, meshing
+ * it and building its collision, and is safe to run on a worker thread. The
+ * GL upload and the dynamics world are left to the GUI thread.
+ */
+class LabyrinthTile
+{
+public:
+    typedef std::pair<int, int> Coord;
+
+    LabyrinthTile( Environment env, uint64_t seed, Coord coord );
+    ~LabyrinthTile();
+
+    Coord coord() const;
+    const MazeGrid& maze() const;
+    const Bounds& bounds() const;
+
+    void initializeGL();
+    void submit( RenderQueue& queue );
+    void teardownGL();
+
+    void addRigidBodies( btDiscreteDynamicsWorld* dynamicsWorld );
+    void removeRigidBodies( btDiscreteDynamicsWorld* dynamicsWorld );
+
+    static Coord tileOf( const btVector3& position );
+
+    // Cells per side of a tile, even so its rooms sit on the odd cells
+    static const int SIZE = 16;
+
+    // Cells of the labyrinth are this far apart
+    static const float CELL_SIZE;
+
+private:
+    Texture wallTexture( Environment env, uint64_t seed, int x, int z ) const;
+
+    // Walls share a texture in blocks of this many cells per side
+    const int WALL_BLOCK = 4;
+
+    Coord m_coord;
+    MazeGrid m_maze;
+    std::vector< CellBatch* > m_batches;
+    Bounds m_bounds;
+    LabyrinthCollision* m_collision;
+};
+
+#endif  //  LABYRINTH_TILE_H
@@ -1,99 +1,186 @@
 #include "mazeGenerator.h"
 
-#define Grid std::vector< std::vector<int> >
-#define Cell std::tuple<int, int>
-#define row( x ) std::get<0>( x ) 
-#define col( x ) std::get<1>( x ) 
+#include <algorithm>
+#include <iostream>
+#include <vector>
 
-Grid MazeGenerator::makeMaze( int seed, int width, int height )
-{
-    srand( seed );
+#include "Maze/random.h"
+
+//
+// PRIVATE HELPERS /////////////////////////////////////////////////////////////
+//
 
-    Grid maze( width, std::vector<int>( height, WALL ) );
-    std::list<Cell> workers;
+namespace
+{
+    /**
+     * @brief      Finds the set a label belongs to, halving the path on the
+     *             way.
+     *
+     * @param      parent  The parent of every label.
+     * @param[in]  label   The label to look up.
+     *
+     * @return     The label of the set.
+     */
+    int findSet( std::vector<int>& parent, int label )
+    {
+        while( parent[label] != label )
+        {
+            parent[label] = parent[ parent[label] ];
+            label = parent[label];
+        }
+        return label;
+    }
 
-    workers.push_back( std::make_tuple( width / 2, height / 2 ) );
-    while( workers.size() > 0 )
+    /**
+     * @brief      Carves a perfect maze into a grid of walls with Eller's
+     *             algorithm.
+     * @details    Rooms sit on every other cell from the given offsets, with
+     * walls between them. Rooms are carved one row at a time and only the
+     * current row's sets are kept, so besides the grid itself only a few
+     * integers per room of a single row are needed, however many rows there
+     * are.
+     *
+     * @param      random   The random number generator to carve with.
+     * @param      maze     The grid to carve, filled with walls.
+     * @param[in]  offsetX  The x of the first row of rooms, 0 or 1.
+     * @param[in]  offsetZ  The z of the first column of rooms, 0 or 1.
+     *
+     * @return     The memory used besides the grid, in bytes.
+     */
+    std::size_t carveRooms( Random& random, MazeGrid& maze, int offsetX,
+        int offsetZ )
     {
-        std::list<Cell>::iterator iter = workers.begin();
+        using namespace MazeGenerator;
+
+        const int rows = std::max( 0, ( maze.width() - offsetX + 1 ) / 2 );
+        const int columns = std::max( 0, ( maze.height() - offsetZ + 1 ) / 2 );
 
-        while( iter != workers.end() )
+        // Per room of the current row, labels stay below the number of
+        // columns
+        std::vector<int> labels( columns, -1 );
+        std::vector<int> parent( columns );
+        std::vector<int> remap( columns );
+        std::vector<int> roomsInSet( columns );
+        std::vector<int> pickedRoom( columns );
+        std::vector<char> setGoesDown( columns );
+        std::vector<char> goesDown( columns );
+
+        for( int row = 0; row < rows; row++ )
         {
-            bool removeWorker = false;
+            const int x = offsetX + 2 * row;
+            const bool lastRow = row == rows - 1;
 
-            switch( rand() % 4 )
+            // Renumber the sets carried down, then give the other rooms new
+            // ones
+            std::fill( remap.begin(), remap.end(), -1 );
+            int numSets = 0;
+            for( int column = 0; column < columns; column++ )
             {
-                case 0:
-                    col( *iter ) -= 2;
-                    if( col( *iter ) < 0 || 
-                        maze[row( *iter )][col( *iter )] == FLOOR )
-                    {
-                        removeWorker = true;
-                        break;
-                    }
-                    maze[row( *iter )][col( *iter ) + 1] = FLOOR;
-                    break;
-                case 1:
-                    col( *iter ) += 2;
-                    if( col( *iter ) >= height || 
-                        maze[row( *iter )][col( *iter )] == FLOOR )
-                    {
-                        removeWorker = true;
-                        break;
-                    }
-                    maze[row( *iter )][col( *iter ) - 1] = FLOOR;
-                    break;
-                case 2:
-                    row( *iter ) -= 2;
-                    if( row( *iter ) < 0 || 
-                        maze[row( *iter )][col( *iter )] == FLOOR )
-                    {
-                        removeWorker = true;
-                        break;
-                    }
-                    maze[row( *iter ) + 1][col( *iter )] = FLOOR;
-                    break;
-                case 3:
-                    row( *iter ) += 2;
-                    if( row( *iter ) >= width || 
-                        maze[row( *iter )][col( *iter )] == FLOOR )
-                    {
-                        removeWorker = true;
-                        break;
-                    }
-                    maze[row( *iter ) - 1][col( *iter )] = FLOOR;
-                    break;
+                int& label = labels[column];
+                if( label >= 0 )
+                {
+                    if( remap[label] < 0 )
+                        remap[label] = numSets++;
+                    label = remap[label];
+                }
+            }
+            for( int column = 0; column < columns; column++ )
+            {
+                if( labels[column] < 0 )
+                    labels[column] = numSets++;
+                parent[column] = column;
+                maze.set( x, offsetZ + 2 * column, FLOOR );
             }
 
-            if( removeWorker )
-                iter = workers.erase( iter );
-            else
+            // Randomly join neighbouring sets, and every one on the last row
+            for( int column = 0; column + 1 < columns; column++ )
+            {
+                const int left = findSet( parent, labels[column] );
+                const int right = findSet( parent, labels[column + 1] );
+                if( left != right && ( lastRow || random.nextBool() ) )
+                {
+                    parent[right] = left;
+                    maze.set( x, offsetZ + 2 * column + 1, FLOOR );
+                }
+            }
+            for( int column = 0; column < columns; column++ )
+                labels[column] = findSet( parent, labels[column] );
+
+            if( lastRow )
+                break;
+
+            // Every set carries on down at least once, from a random room if
+            // it did not happen to pick one
+            std::fill( roomsInSet.begin(), roomsInSet.end(), 0 );
+            std::fill( setGoesDown.begin(), setGoesDown.end(), 0 );
+            for( int column = 0; column < columns; column++ )
+            {
+                const int label = labels[column];
+                if( random.nextInt( ++roomsInSet[label] ) == 0 )
+                    pickedRoom[label] = column;
+
+                goesDown[column] = random.nextBool();
+                if( goesDown[column] )
+                    setGoesDown[label] = 1;
+            }
+            for( int column = 0; column < columns; column++ )
             {
-                workers.push_back( 
-                    std::make_tuple( row( *iter ), col( *iter ) ) );
-                workers.push_back( 
-                    std::make_tuple( row( *iter ), col( *iter ) ) );
-                workers.push_back( 
-                    std::make_tuple( row( *iter ), col( *iter ) ) );
-                workers.push_back( 
-                    std::make_tuple( row( *iter ), col( *iter ) ) );
-
-                maze[row( *iter )][col( *iter )] = FLOOR;
-                ++iter;
+                const int label = labels[column];
+                if( !setGoesDown[label] && pickedRoom[label] == column )
+                    goesDown[column] = 1;
+
+                if( goesDown[column] )
+                    maze.set( x + 1, offsetZ + 2 * column, FLOOR );
+                else
+                    labels[column] = -1;
             }
         }
+
+        return 5 * columns * sizeof( int ) + 2 * columns * sizeof( char );
     }
+}
 
-    maze[width / 2][height / 2] = START;
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
 
-    switch( rand() % 4 )
+/**
+ * @brief      Generates a perfect maze, with the start at its center and the
+ *             end along one of its diagonals.
+ *
+ * @param[in]  seed         The seed of the maze.
+ * @param[in]  width        The number of cells along x.
+ * @param[in]  height       The number of cells along z.
+ * @param[out] workerBytes  If not NULL, the memory used besides the grid.
+ *
+ * @return     The maze.
+ */
+MazeGrid MazeGenerator::makeMaze( int seed, int width, int height,
+    std::size_t* workerBytes )
+{
+    Random random( seed );
+    MazeGrid maze( width, height, WALL );
+
+    // Rooms line up with the center cell, where the ball starts
+    const std::size_t carveBytes = carveRooms( random, maze,
+        ( width / 2 ) % 2, ( height / 2 ) % 2 );
+
+    if( workerBytes != NULL )
+        *workerBytes = carveBytes;
+
+    if( width == 0 || height == 0 )
+        return maze;
+
+    maze.set( width / 2, height / 2, START );
+
+    switch( random.nextInt( 4 ) )
     {
         case 0:
             for(int i = 0; i < std::min(width, height); i++)
             {
-                if( maze[i][i] == FLOOR )
+                if( maze.at( i, i ) == FLOOR )
                 {
-                    maze[i][i] = END;
+                    maze.set( i, i, END );
                     break;
                 }
             }
@@ -101,9 +188,9 @@ Grid MazeGenerator::makeMaze( int seed, int width, int height )
         case 1:
             for(int i = 0; i < std::min(width, height); i++)
             {
-                if( maze[width - i - 1][i] == FLOOR )
+                if( maze.at( width - i - 1, i ) == FLOOR )
                 {
-                    maze[width - i - 1][i] = END;
+                    maze.set( width - i - 1, i, END );
                     break;
                 }
             }
@@ -111,9 +198,9 @@ Grid MazeGenerator::makeMaze( int seed, int width, int height )
         case 2:
             for(int i = 0; i < std::min(width, height); i++)
             {
-                if( maze[i][height - i - 1] == FLOOR )
+                if( maze.at( i, height - i - 1 ) == FLOOR )
                 {
-                    maze[i][height - i - 1] = END;
+                    maze.set( i, height - i - 1, END );
                     break;
                 }
             }
@@ -121,9 +208,9 @@ Grid MazeGenerator::makeMaze( int seed, int width, int height )
         case 3:
             for(int i = 1; i < std::min(width, height); i++)
             {
-                if( maze[width - i][height - i] == FLOOR )
+                if( maze.at( width - i, height - i ) == FLOOR )
                 {
-                    maze[width - i][height - i] = END;
+                    maze.set( width - i, height - i, END );
                     break;
                 }
             }
@@ -133,15 +220,33 @@ Grid MazeGenerator::makeMaze( int seed, int width, int height )
     return maze;
 }
 
-void MazeGenerator::printMaze( Grid maze )
+/**
+ * @brief      Generates one square tile of a larger maze. Rooms sit on the odd
+ *             cells, so the first row and column are walls the tile shares
+ *             with its neighbours; there is no start or end.
+ *
+ * @param[in]  seed  The seed of the tile.
+ * @param[in]  size  The number of cells along each side, even.
+ *
+ * @return     The tile.
+ */
+MazeGrid MazeGenerator::makeTile( uint64_t seed, int size )
 {
-    for( unsigned int y = 0; y < maze[0].size(); ++y )
+    Random random( seed );
+    MazeGrid tile( size, size, WALL );
+    carveRooms( random, tile, 1, 1 );
+    return tile;
+}
+
+void MazeGenerator::printMaze( const MazeGrid& maze )
+{
+    for( int y = 0; y < maze.height(); ++y )
     {
-        for( unsigned int x = 0; x < maze.size(); ++x )
+        for( int x = 0; x < maze.width(); ++x )
         {
-            if( maze[x][y] == FLOOR )
+            if( maze.at( x, y ) == FLOOR )
                 std::cout << "-";
-            else if(  maze[x][y] == WALL )
+            else if(  maze.at( x, y ) == WALL )
                 std::cout << "|";
             else
                 std::cout << "*";
@@ -149,8 +254,3 @@ void MazeGenerator::printMaze( Grid maze )
         std::cout << std::endl;
     }
 }
-
-#undef Grid
-#undef Cell
-#undef row
-#undef col
\ No newline at end of file
@@ -1,16 +1,10 @@
 #ifndef MAZE_GENERATOR_H
 #define MAZE_GENERATOR_H
 
-#include <algorithm>
-#include <tuple>
-#include <vector>
-#include <list>
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
 
-#define Grid std::vector< std::vector<int> >
-#define Cell std::tuple<int, int>
-#define row( x ) std::get<0>( x ) 
-#define col( x ) std::get<1>( x ) 
+#include "Maze/mazeGrid.h"
 
 namespace MazeGenerator
 {
@@ -18,13 +12,10 @@ namespace MazeGenerator
     const int END = 1;
     const int WALL = 2;
     const int FLOOR = 3;
-    Grid makeMaze( int seed, int width, int height );
-    void printMaze( Grid maze );
+    MazeGrid makeMaze( int seed, int width, int height,
+        std::size_t* workerBytes = NULL );
+    MazeGrid makeTile( uint64_t seed, int size );
+    void printMaze( const MazeGrid& maze );
 }
 
-#undef Grid
-#undef Cell
-#undef row
-#undef col
-
-#endif  //  MAZE_GENERATOR_H
\ No newline at end of file
+#endif  //  MAZE_GENERATOR_H
@@ -0,0 +1,99 @@
+#include "mazeGrid.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for MazeGrid.
+ *
+ * @param[in]  width   The number of cells along x.
+ * @param[in]  height  The number of cells along z.
+ * @param[in]  fill    The value every cell starts with.
+ */
+MazeGrid::MazeGrid( int width, int height, int fill )
+    :   m_width( width ), m_height( height )
+{
+    uint8_t byte = fill & 3;
+    byte |= byte << 2;
+    byte |= byte << 4;
+
+    m_cells.assign( ( (std::size_t)width * height + 3 ) / 4, byte );
+}
+
+//
+// ACCESSORS ///////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the number of cells along x.
+ *
+ * @return     The width of the grid.
+ */
+int MazeGrid::width() const
+{
+    return m_width;
+}
+
+/**
+ * @brief      Gets the number of cells along z.
+ *
+ * @return     The height of the grid.
+ */
+int MazeGrid::height() const
+{
+    return m_height;
+}
+
+/**
+ * @brief      Checks if a cell is inside the grid.
+ *
+ * @param[in]  x     The x of the cell.
+ * @param[in]  z     The z of the cell.
+ *
+ * @return     True if the cell is inside the grid.
+ */
+bool MazeGrid::contains( int x, int z ) const
+{
+    return x >= 0 && z >= 0 && x < m_width && z < m_height;
+}
+
+/**
+ * @brief      Gets the value of a cell, which must be inside the grid.
+ *
+ * @param[in]  x     The x of the cell.
+ * @param[in]  z     The z of the cell.
+ *
+ * @return     The value of the cell.
+ */
+int MazeGrid::at( int x, int z ) const
+{
+    const std::size_t index = (std::size_t)x * m_height + z;
+    return ( m_cells[ index >> 2 ] >> ( ( index & 3 ) * 2 ) ) & 3;
+}
+
+/**
+ * @brief      Sets the value of a cell, which must be inside the grid.
+ *
+ * @param[in]  x      The x of the cell.
+ * @param[in]  z      The z of the cell.
+ * @param[in]  value  The new value of the cell.
+ */
+void MazeGrid::set( int x, int z, int value )
+{
+    const std::size_t index = (std::size_t)x * m_height + z;
+    const int shift = ( index & 3 ) * 2;
+
+    uint8_t& byte = m_cells[ index >> 2 ];
+    byte = ( byte & ~( 3 << shift ) ) | ( ( value & 3 ) << shift );
+}
+
+/**
+ * @brief      Gets the memory taken by the cells.
+ *
+ * @return     The size of the cell storage, in bytes.
+ */
+std::size_t MazeGrid::memoryUsage() const
+{
+    return m_cells.size();
+}
@@ -0,0 +1,32 @@
+#ifndef MAZE_GRID_H
+#define MAZE_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief      Flat grid of maze cells, packed at two bits per cell.
+ * @details    Every cell holds one of the four MazeGenerator values, so four
+ * cells share a byte. A 10000 by 10000 maze fits in 25 MB.
+ */
+class MazeGrid
+{
+public:
+    MazeGrid( int width = 0, int height = 0, int fill = 0 );
+
+    int width() const;
+    int height() const;
+    bool contains( int x, int z ) const;
+
+    int at( int x, int z ) const;
+    void set( int x, int z, int value );
+
+    std::size_t memoryUsage() const;
+
+private:
+    int m_width, m_height;
+    std::vector<uint8_t> m_cells;
+};
+
+#endif  //  MAZE_GRID_H
@@ -0,0 +1,353 @@
+#include "potentiallyVisibleSet.h"
+
+#include <algorithm>
+
+#include "Maze/mazeGenerator.h"
+
+//
+// PRIVATE HELPERS /////////////////////////////////////////////////////////////
+//
+
+namespace
+{
+    // Corners of the grid, in cells from the eye's cell, whose lower left
+    // corner is the origin; x is the shallow axis and z the steep one
+    struct Corner
+    {
+        int X, Z;
+    };
+
+    // A sight line through a near corner, on the eye's cell or a wall it has
+    // to pass, and a far corner on a wall
+    struct Line
+    {
+        Corner Near, Far;
+    };
+
+    // A corner a view's line has to pass, linked to the ones before it
+    struct Bump
+    {
+        Corner Position;
+        int Parent;
+    };
+
+    // Sight lines between two bounding lines, none of them through a wall
+    struct View
+    {
+        Line Shallow, Steep;
+        int ShallowBump, SteepBump;
+    };
+
+    const int NO_BUMP = -1;
+
+    /**
+     * @brief      Gets which side of a line a corner is on.
+     *
+     * @param[in]  line    The line.
+     * @param[in]  corner  The corner.
+     *
+     * @return     Positive if the line passes below the corner, negative if
+     *             above it, and 0 if through it.
+     */
+    int side( const Line& line, const Corner& corner )
+    {
+        return ( line.Far.Z - line.Near.Z ) * ( line.Far.X - corner.X ) -
+            ( line.Far.X - line.Near.X ) * ( line.Far.Z - corner.Z );
+    }
+
+    /**
+     * @brief      Makes a view's shallow line pass above a wall's corner, then
+     *             pivots it on the steep bumps it would cross.
+     *
+     * @param      view    The view.
+     * @param[in]  corner  The upper left corner of the wall.
+     * @param      bumps   Every bump of the scan.
+     */
+    void addShallowBump( View& view, const Corner& corner,
+        std::vector<Bump>& bumps )
+    {
+        view.Shallow.Far = corner;
+        bumps.push_back( Bump{ corner, view.ShallowBump } );
+        view.ShallowBump = bumps.size() - 1;
+
+        for( int bump = view.SteepBump; bump != NO_BUMP;
+            bump = bumps[bump].Parent )
+        {
+            if( side( view.Shallow, bumps[bump].Position ) < 0 )
+                view.Shallow.Near = bumps[bump].Position;
+        }
+    }
+
+    /**
+     * @brief      Makes a view's steep line pass below a wall's corner, then
+     *             pivots it on the shallow bumps it would cross.
+     *
+     * @param      view    The view.
+     * @param[in]  corner  The lower right corner of the wall.
+     * @param      bumps   Every bump of the scan.
+     */
+    void addSteepBump( View& view, const Corner& corner,
+        std::vector<Bump>& bumps )
+    {
+        view.Steep.Far = corner;
+        bumps.push_back( Bump{ corner, view.SteepBump } );
+        view.SteepBump = bumps.size() - 1;
+
+        for( int bump = view.ShallowBump; bump != NO_BUMP;
+            bump = bumps[bump].Parent )
+        {
+            if( side( view.Steep, bumps[bump].Position ) > 0 )
+                view.Steep.Near = bumps[bump].Position;
+        }
+    }
+
+    /**
+     * @brief      Checks if a view has closed, its lines lying on top of each
+     *             other through a corner of the eye's cell.
+     *
+     * @param[in]  view  The view.
+     *
+     * @return     True if no sight line is left in the view.
+     */
+    bool isClosed( const View& view )
+    {
+        const Corner upperLeft = { 0, 1 };
+        const Corner lowerRight = { 1, 0 };
+
+        return side( view.Shallow, view.Steep.Near ) == 0 &&
+            side( view.Shallow, view.Steep.Far ) == 0 &&
+            ( side( view.Shallow, upperLeft ) == 0 ||
+            side( view.Shallow, lowerRight ) == 0 );
+    }
+}
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for PotentiallyVisibleSet.
+ *
+ * @param[in]  chunkSize  The number of cells along each side of a chunk.
+ */
+PotentiallyVisibleSet::PotentiallyVisibleSet( int chunkSize )
+    :   m_chunkSize( chunkSize ), m_width( 0 ), m_height( 0 )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Computes the visible chunks of every floor cell of a maze.
+ *             Everything outside the maze counts as a wall.
+ *
+ * @param[in]  maze  The maze.
+ */
+void PotentiallyVisibleSet::build( const MazeGrid& maze )
+{
+    m_maze = maze;
+    m_width = maze.width();
+    m_height = maze.height();
+    m_visible.assign( m_width * m_height, std::vector<Chunk>() );
+
+    // Chunks span the border walls, one cell outside the maze on every side
+    m_firstChunk = chunkOf( -1, -1 );
+    const Chunk lastChunk = chunkOf( m_width, m_height );
+    m_chunksZ = lastChunk.second - m_firstChunk.second + 1;
+    const int numChunks = ( lastChunk.first - m_firstChunk.first + 1 ) *
+        m_chunksZ;
+
+    for( int x = 0; x < m_width; x++ )
+    {
+        for( int z = 0; z < m_height; z++ )
+        {
+            if( isWall( x, z ) )
+                continue;
+
+            std::vector<bool> marked( numChunks, false );
+            std::vector<Chunk>& visible = m_visible[ x * m_height + z ];
+            mark( x, z, marked, visible );
+
+            // The quarters overlap along the axes, which is harmless
+            scanQuarter( x, z, 1, 1, marked, visible );
+            scanQuarter( x, z, -1, 1, marked, visible );
+            scanQuarter( x, z, 1, -1, marked, visible );
+            scanQuarter( x, z, -1, -1, marked, visible );
+        }
+    }
+}
+
+/**
+ * @brief      Gets the chunk a cell belongs to.
+ *
+ * @param[in]  x     The x cell of the maze grid.
+ * @param[in]  z     The z cell of the maze grid.
+ *
+ * @return     The chunk of the cell.
+ */
+PotentiallyVisibleSet::Chunk PotentiallyVisibleSet::chunkOf( int x, int z )
+    const
+{
+    // Rounds towards negative infinity for the border cells
+    return Chunk( ( x < 0 ? x - m_chunkSize + 1 : x ) / m_chunkSize,
+        ( z < 0 ? z - m_chunkSize + 1 : z ) / m_chunkSize );
+}
+
+/**
+ * @brief      Gets the chunks that may be visible from a cell.
+ *
+ * @param[in]  x     The x cell of the maze grid.
+ * @param[in]  z     The z cell of the maze grid.
+ *
+ * @return     The visible chunks, or NULL if the cell is outside the maze or
+ *             inside a wall, where nothing can be culled.
+ */
+const std::vector<PotentiallyVisibleSet::Chunk>*
+    PotentiallyVisibleSet::visibleChunks( int x, int z ) const
+{
+    if( isWall( x, z ) )
+        return NULL;
+
+    return &m_visible[ x * m_height + z ];
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Checks if a cell blocks the view.
+ *
+ * @param[in]  x     The x cell of the maze grid.
+ * @param[in]  z     The z cell of the maze grid.
+ *
+ * @return     True for walls and anything outside the maze.
+ */
+bool PotentiallyVisibleSet::isWall( int x, int z ) const
+{
+    return !m_maze.contains( x, z ) || m_maze.at( x, z ) == MazeGenerator::WALL;
+}
+
+/**
+ * @brief      Marks every cell visible from a floor cell in one quarter of the
+ *             grid around it.
+ * @details    The quarter is mirrored so it lies towards positive x and z,
+ * the floor cell spanning the corners ( 0, 0 ) to ( 1, 1 ). Cells are visited
+ * in diagonals moving outwards, and along each diagonal from the shallowest
+ * to the steepest, so the views, also kept from shallowest to steepest, are
+ * walked through once per diagonal.
+ *
+ * @param[in]  fromX       The x cell of the floor cell.
+ * @param[in]  fromZ       The z cell of the floor cell.
+ * @param[in]  directionX  The direction of the quarter along x, 1 or -1.
+ * @param[in]  directionZ  The direction of the quarter along z, 1 or -1.
+ * @param      marked      Flags of the chunks seen so far.
+ * @param      visible     The chunks seen so far.
+ */
+void PotentiallyVisibleSet::scanQuarter( int fromX, int fromZ,
+    int directionX, int directionZ, std::vector<bool>& marked,
+    std::vector<Chunk>& visible ) const
+{
+    // Up to the border walls just outside the maze
+    const int extentX = directionX > 0 ? m_width - fromX : fromX + 1;
+    const int extentZ = directionZ > 0 ? m_height - fromZ : fromZ + 1;
+
+    // Every sight line out of the floor cell into the quarter to begin with
+    View all;
+    all.Shallow = Line{ Corner{ 0, 1 }, Corner{ extentX, 0 } };
+    all.Steep = Line{ Corner{ 1, 0 }, Corner{ 0, extentZ } };
+    all.ShallowBump = NO_BUMP;
+    all.SteepBump = NO_BUMP;
+
+    std::vector<View> views( 1, all );
+    std::vector<Bump> bumps;
+
+    for( int diagonal = 1; diagonal <= extentX + extentZ && !views.empty();
+        diagonal++ )
+    {
+        size_t index = 0;
+        const int lastZ = std::min( diagonal, extentZ );
+        for( int z = std::max( 0, diagonal - extentX );
+            z <= lastZ && index < views.size(); z++ )
+        {
+            const int x = diagonal - z;
+            const Corner upperLeft = { x, z + 1 };
+            const Corner lowerRight = { x + 1, z };
+
+            // Views the cell is above, only steeper cells can be in them
+            while( index < views.size() &&
+                side( views[index].Steep, lowerRight ) >= 0 )
+                index++;
+
+            // Above every view, or below the current one
+            if( index == views.size() ||
+                side( views[index].Shallow, upperLeft ) <= 0 )
+                continue;
+
+            const int cellX = fromX + x * directionX;
+            const int cellZ = fromZ + z * directionZ;
+            mark( cellX, cellZ, marked, visible );
+            if( !isWall( cellX, cellZ ) )
+                continue;
+
+            View& view = views[index];
+            const bool crossesShallow = side( view.Shallow, lowerRight ) < 0;
+            const bool crossesSteep = side( view.Steep, upperLeft ) > 0;
+
+            if( crossesShallow && crossesSteep )
+            {
+                // The wall fills the view
+                views.erase( views.begin() + index );
+            }
+            else if( crossesShallow )
+            {
+                // The wall cuts off the shallow side of the view
+                addShallowBump( view, upperLeft, bumps );
+                if( isClosed( view ) )
+                    views.erase( views.begin() + index );
+            }
+            else if( crossesSteep )
+            {
+                // The wall cuts off the steep side of the view
+                addSteepBump( view, lowerRight, bumps );
+                if( isClosed( view ) )
+                    views.erase( views.begin() + index );
+            }
+            else
+            {
+                // The wall splits the view, the steeper half is passed next
+                views.insert( views.begin() + index, view );
+                addSteepBump( views[index], lowerRight, bumps );
+                addShallowBump( views[index + 1], upperLeft, bumps );
+
+                if( isClosed( views[index + 1] ) )
+                    views.erase( views.begin() + index + 1 );
+                if( isClosed( views[index] ) )
+                    views.erase( views.begin() + index );
+            }
+        }
+    }
+}
+
+/**
+ * @brief      Marks the chunk of a cell visible, once.
+ *
+ * @param[in]  x        The x cell of the maze grid.
+ * @param[in]  z        The z cell of the maze grid.
+ * @param      marked   Flags of the chunks seen so far.
+ * @param      visible  The chunks seen so far.
+ */
+void PotentiallyVisibleSet::mark( int x, int z, std::vector<bool>& marked,
+    std::vector<Chunk>& visible ) const
+{
+    const Chunk chunk = chunkOf( x, z );
+    const int index = ( chunk.first - m_firstChunk.first ) * m_chunksZ +
+        chunk.second - m_firstChunk.second;
+    if( !marked[index] )
+    {
+        marked[index] = true;
+        visible.push_back( chunk );
+    }
+}
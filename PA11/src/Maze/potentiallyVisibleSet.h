@@ -0,0 +1,57 @@
+#ifndef POTENTIALLY_VISIBLE_SET_H
+#define POTENTIALLY_VISIBLE_SET_H
+
+#include <utility>
+#include <vector>
+
+#include "Maze/mazeGrid.h"
+
+/**
+ * @brief      Which chunks of the labyrinth can be seen from each floor cell.
+ * @details    The maze grid is split into square chunks of cells. A cell is
+ * visible from a floor cell if any straight line from anywhere in the floor
+ * cell reaches anywhere in it without crossing a wall, and the chunk of every
+ * visible cell, walls included, is marked visible. As the eye can be anywhere
+ * in its cell, nothing in sight is culled.
+ *
+ * Each quarter around the floor cell is scanned outwards in diagonals, keeping
+ * the views still open between walls. A view is bounded by its shallowest and
+ * steepest sight lines, each pivoting on the corners of the walls it has to
+ * pass; a wall in a view narrows or splits it. This is the precise permissive
+ * field of view, run from every floor cell.
+ *
+ * Walls only block the view from below their tops, so the set only applies to
+ * a camera inside the maze and lower than the walls.
+ */
+class PotentiallyVisibleSet
+{
+public:
+    typedef std::pair<int, int> Chunk;
+
+    PotentiallyVisibleSet( int chunkSize );
+
+    void build( const MazeGrid& maze );
+
+    Chunk chunkOf( int x, int z ) const;
+    const std::vector<Chunk>* visibleChunks( int x, int z ) const;
+
+private:
+    bool isWall( int x, int z ) const;
+    void scanQuarter( int fromX, int fromZ, int directionX, int directionZ,
+        std::vector<bool>& marked, std::vector<Chunk>& visible ) const;
+    void mark( int x, int z, std::vector<bool>& marked,
+        std::vector<Chunk>& visible ) const;
+
+    int m_chunkSize;
+    int m_width, m_height;
+    MazeGrid m_maze;
+
+    // Visible chunks of every cell, empty for walls, indexed x * height + z
+    std::vector< std::vector<Chunk> > m_visible;
+
+    // Range of chunks, to index flags of visited chunks with
+    Chunk m_firstChunk;
+    int m_chunksZ;
+};
+
+#endif  //  POTENTIALLY_VISIBLE_SET_H
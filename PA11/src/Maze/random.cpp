@@ -0,0 +1,91 @@
+#include "random.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Random.
+ *
+ * @param[in]  seed  The seed of the sequence.
+ */
+Random::Random( uint64_t seed )
+    :   m_state( 0 ), m_increment( 0xda3e39cb94b95bdbULL )
+{
+    next();
+    m_state += seed;
+    next();
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the next number of the sequence.
+ *
+ * @return     A uniformly distributed 32-bit number.
+ */
+uint32_t Random::next()
+{
+    const uint64_t state = m_state;
+    m_state = state * 6364136223846793005ULL + m_increment;
+
+    const uint32_t xorShifted = ( ( state >> 18u ) ^ state ) >> 27u;
+    const uint32_t rotation = state >> 59u;
+    return ( xorShifted >> rotation ) | ( xorShifted << ( ( -rotation ) & 31 ) );
+}
+
+/**
+ * @brief      Gets a number below a bound, without the bias of a plain modulo.
+ *
+ * @param[in]  bound  The exclusive upper bound, greater than 0.
+ *
+ * @return     A uniformly distributed number in [0, bound).
+ */
+uint32_t Random::nextInt( uint32_t bound )
+{
+    // Reject the low values that would make some results more likely
+    const uint32_t threshold = -bound % bound;
+    for( ;; )
+    {
+        const uint32_t value = next();
+        if( value >= threshold )
+            return value % bound;
+    }
+}
+
+/**
+ * @brief      Flips a coin.
+ *
+ * @return     True or false with equal odds.
+ */
+bool Random::nextBool()
+{
+    return next() >> 31;
+}
+
+//
+// STATIC HELPERS //////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Mixes a seed with a grid coordinate, so every coordinate gets
+ *             its own unrelated seed.
+ *
+ * @param[in]  seed  The seed of the whole grid.
+ * @param[in]  x     The x coordinate.
+ * @param[in]  z     The z coordinate.
+ *
+ * @return     The seed of the coordinate.
+ */
+uint64_t Random::hash( uint64_t seed, int x, int z )
+{
+    uint64_t value = seed ^ ( (uint64_t)(uint32_t)x << 32 | (uint32_t)z );
+
+    // SplitMix64 finalizer
+    value += 0x9e3779b97f4a7c15ULL;
+    value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+    return value ^ ( value >> 31 );
+}
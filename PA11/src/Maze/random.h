@@ -0,0 +1,27 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/**
+ * @brief      Small seedable random number generator (PCG32).
+ * @details    Unlike rand(), every instance has its own state and produces the
+ * same sequence for a seed on every platform and standard library.
+ */
+class Random
+{
+public:
+    Random( uint64_t seed );
+
+    uint32_t next();
+    uint32_t nextInt( uint32_t bound );
+    bool nextBool();
+
+    static uint64_t hash( uint64_t seed, int x, int z );
+
+private:
+    uint64_t m_state;
+    uint64_t m_increment;
+};
+
+#endif  //  RANDOM_H
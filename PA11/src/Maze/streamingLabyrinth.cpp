@@ -0,0 +1,390 @@
+#include "streamingLabyrinth.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+#include "Controls/profiler.h"
+#include "Maze/mazeGenerator.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for StreamingLabyrinth. No tile is built until the
+ *             balls are first streamed around.
+ *
+ * @param[in]  env            The environment of the labyrinth.
+ * @param[in]  seed           The seed of the labyrinth.
+ * @param      dynamicsWorld  The world tiles are added to as they arrive.
+ */
+StreamingLabyrinth::StreamingLabyrinth( Environment env, int seed,
+    btDiscreteDynamicsWorld* dynamicsWorld )
+    :   m_env( env ), m_seed( seed ), m_dynamicsWorld( dynamicsWorld ),
+        m_treeDirty( false ), m_cancelled( false )
+{
+    player = Labyrinth::playMusic( m_env );
+
+    // Nothing has streamed in yet, the field fills in as tiles arrive
+    const int homeSize = ( 2 * HOME_RADIUS + 1 ) * LabyrinthTile::SIZE;
+    const std::pair<int, int> origin = fieldOrigin();
+    const std::pair<float, float> start = getStartingLocation();
+    m_home = MazeGrid( homeSize, homeSize, MazeGenerator::WALL );
+    const int startX = std::lround( start.first / LabyrinthTile::CELL_SIZE );
+    const int startZ = std::lround( start.second / LabyrinthTile::CELL_SIZE );
+    m_distanceField.build( m_home, startX - origin.first,
+        startZ - origin.second );
+}
+
+/**
+ * @brief      Destructor for StreamingLabyrinth. Cancels the builds not
+ *             started yet and waits for the rest, then removes every tile from
+ *             the world. The GL data must already be torn down.
+ */
+StreamingLabyrinth::~StreamingLabyrinth()
+{
+    m_cancelled.store( true );
+    for( const JobSystem::Handle& build : m_builds )
+        JobSystem::instance().wait( build );
+
+    for( LabyrinthTile* tile : m_built )
+        delete tile;
+    for( LabyrinthTile* tile : m_uploads )
+        delete tile;
+
+    for( std::map< LabyrinthTile::Coord, LabyrinthTile* >::iterator iter =
+        m_tiles.begin(); iter != m_tiles.end(); iter++ )
+    {
+        iter->second->removeRigidBodies( m_dynamicsWorld );
+        delete iter->second;
+    }
+
+    delete player;
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Follows the balls, requesting every missing tile in range from
+ *             the job system, nearest first.
+ *
+ * @param[in]  focus  The positions of the balls.
+ */
+void StreamingLabyrinth::stream( const std::vector<btVector3>& focus )
+{
+    m_focus.clear();
+    for( const btVector3& position : focus )
+        m_focus.push_back( LabyrinthTile::tileOf( position ) );
+
+    // In rings outwards from each ball
+    for( int radius = 0; radius <= LOAD_RADIUS; radius++ )
+    {
+        for( const LabyrinthTile::Coord& center : m_focus )
+        {
+            for( int x = -radius; x <= radius; x++ )
+            {
+                for( int z = -radius; z <= radius; z++ )
+                {
+                    if( std::max( std::abs( x ), std::abs( z ) ) == radius )
+                    {
+                        request( LabyrinthTile::Coord( center.first + x,
+                            center.second + z ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief      Evicts the tiles the balls have left behind, then uploads up to
+ *             UPLOADS_PER_FRAME built tiles, nearest first, and adds them to
+ *             the world. Requires a current context.
+ */
+void StreamingLabyrinth::uploadTiles()
+{
+    for( std::map< LabyrinthTile::Coord, LabyrinthTile* >::iterator iter =
+        m_tiles.begin(); iter != m_tiles.end(); )
+    {
+        if( distance( iter->first ) > EVICT_RADIUS )
+        {
+            evict( iter->second );
+            iter = m_tiles.erase( iter );
+            m_treeDirty = true;
+        }
+        else
+            iter++;
+    }
+
+    std::vector<LabyrinthTile*> built;
+    {
+        QMutexLocker lock( &m_mutex );
+        built.swap( m_built );
+    }
+    m_uploads.insert( m_uploads.end(), built.begin(), built.end() );
+
+    std::sort( m_uploads.begin(), m_uploads.end(),
+        [this]( LabyrinthTile* first, LabyrinthTile* second ){
+            return distance( first->coord() ) < distance( second->coord() );
+        } );
+
+    // Tiles out of range sort last and are dropped without an upload
+    int uploaded = 0;
+    std::vector<LabyrinthTile*>::iterator tile = m_uploads.begin();
+    for( ; tile != m_uploads.end(); tile++ )
+    {
+        const bool inRange = distance( (*tile)->coord() ) <= EVICT_RADIUS;
+        if( inRange && uploaded == UPLOADS_PER_FRAME )
+            break;
+
+        m_requested.erase( (*tile)->coord() );
+        if( !inRange )
+        {
+            delete *tile;
+            continue;
+        }
+
+        (*tile)->initializeGL();
+        (*tile)->addRigidBodies( m_dynamicsWorld );
+        addToHome( *tile );
+        m_tiles[ (*tile)->coord() ] = *tile;
+        m_treeDirty = true;
+        uploaded++;
+    }
+    m_uploads.erase( m_uploads.begin(), tile );
+}
+
+/**
+ * @brief      Checks if the tiles right around every ball are resident, so
+ *             the balls have something to stand on.
+ *
+ * @return     True once the balls can be dropped in.
+ */
+bool StreamingLabyrinth::isReady() const
+{
+    for( const LabyrinthTile::Coord& center : m_focus )
+    {
+        for( int x = -READY_RADIUS; x <= READY_RADIUS; x++ )
+        {
+            for( int z = -READY_RADIUS; z <= READY_RADIUS; z++ )
+            {
+                if( !m_tiles.count( LabyrinthTile::Coord( center.first + x,
+                    center.second + z ) ) )
+                    return false;
+            }
+        }
+    }
+
+    return !m_focus.empty();
+}
+
+/**
+ * @brief      Gets the number of resident tiles.
+ *
+ * @return     The number of tiles uploaded and in the world.
+ */
+int StreamingLabyrinth::numTiles() const
+{
+    return m_tiles.size();
+}
+
+/**
+ * @brief      Gets where the balls start, in a room near the middle of the
+ *             first tile.
+ *
+ * @return     The x and z of the start.
+ */
+std::pair<float, float> StreamingLabyrinth::getStartingLocation()
+{
+    // Rooms are on the odd cells of a tile
+    const int cell = ( LabyrinthTile::SIZE / 2 ) | 1;
+    return std::pair<float, float>( cell * LabyrinthTile::CELL_SIZE,
+        cell * LabyrinthTile::CELL_SIZE );
+}
+
+/**
+ * @brief      Gets the distance of every cell near the start back to it. An
+ *             endless labyrinth has no hole, so the way home is the goal.
+ *
+ * @return     The distance field around the start.
+ */
+const DistanceField& StreamingLabyrinth::distanceField() const
+{
+    return m_distanceField;
+}
+
+/**
+ * @brief      Gets the cell the distance field starts at.
+ *
+ * @return     The x and z cell of the field's first cell.
+ */
+std::pair<int, int> StreamingLabyrinth::fieldOrigin() const
+{
+    const int origin = -HOME_RADIUS * LabyrinthTile::SIZE;
+    return std::pair<int, int>( origin, origin );
+}
+
+//
+// RENDERABLE FUNCTIONS ////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Tiles are uploaded as they arrive, see uploadTiles.
+ */
+void StreamingLabyrinth::initializeGL()
+{
+    initializeOpenGLFunctions();
+}
+
+/**
+ * @brief      Uploads the tiles that have arrived, then queues the resident
+ *             tiles in view.
+ *
+ * @param      queue  The queue of the frame.
+ */
+void StreamingLabyrinth::submit( RenderQueue& queue )
+{
+    uploadTiles();
+
+    if( m_treeDirty )
+        buildTree();
+
+    std::vector<int> inView;
+    m_tree.query( queue.frustum(), inView );
+    for( int index : inView )
+        m_treeTiles[index]->submit( queue );
+
+    Profiler::countCulling( inView.size(),
+        m_treeTiles.size() - inView.size() );
+}
+
+/**
+ * @brief      Tiles are static, there is nothing to update.
+ */
+void StreamingLabyrinth::update()
+{
+}
+
+/**
+ * @brief      Releases the GL data of every resident tile.
+ */
+void StreamingLabyrinth::teardownGL()
+{
+    for( std::map< LabyrinthTile::Coord, LabyrinthTile* >::iterator iter =
+        m_tiles.begin(); iter != m_tiles.end(); iter++ )
+    {
+        iter->second->teardownGL();
+    }
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Queues a tile to be built, unless it already is or has been.
+ *
+ * @param[in]  coord  The tile to build.
+ */
+void StreamingLabyrinth::request( const LabyrinthTile::Coord& coord )
+{
+    if( m_tiles.count( coord ) || !m_requested.insert( coord ).second )
+        return;
+
+    // Finished builds have handed their tile over already
+    m_builds.erase( std::remove_if( m_builds.begin(), m_builds.end(),
+        []( const JobSystem::Handle& build ){ return build->isDone(); } ),
+        m_builds.end() );
+
+    const Environment env = m_env;
+    const uint64_t seed = m_seed;
+    m_builds.push_back( JobSystem::instance().run( [this, env, seed, coord]{
+        if( m_cancelled.load() )
+            return;
+
+        LabyrinthTile* tile = new LabyrinthTile( env, seed, coord );
+
+        QMutexLocker lock( &m_mutex );
+        m_built.push_back( tile );
+    } ) );
+}
+
+/**
+ * @brief      Releases a resident tile's GL data and rigid body.
+ *
+ * @param      tile  The tile to evict.
+ */
+void StreamingLabyrinth::evict( LabyrinthTile* tile )
+{
+    tile->removeRigidBodies( m_dynamicsWorld );
+    tile->teardownGL();
+    delete tile;
+}
+
+/**
+ * @brief      Copies a tile near the start into the home maze, and joins its
+ *             cells to the distance field. Tiles further out are skipped.
+ *
+ * @param[in]  tile  The tile that was streamed in.
+ */
+void StreamingLabyrinth::addToHome( const LabyrinthTile* tile )
+{
+    const std::pair<int, int> origin = fieldOrigin();
+    const int minX = tile->coord().first * LabyrinthTile::SIZE - origin.first;
+    const int minZ = tile->coord().second * LabyrinthTile::SIZE -
+        origin.second;
+    if( !m_home.contains( minX, minZ ) )
+        return;
+
+    const MazeGrid& maze = tile->maze();
+    for( int x = 0; x < LabyrinthTile::SIZE; x++ )
+        for( int z = 0; z < LabyrinthTile::SIZE; z++ )
+            m_home.set( minX + x, minZ + z, maze.at( x, z ) );
+
+    m_distanceField.update( m_home, minX, minZ,
+        minX + LabyrinthTile::SIZE - 1, minZ + LabyrinthTile::SIZE - 1 );
+}
+
+/**
+ * @brief      Rebuilds the culling tree over the resident tiles.
+ */
+void StreamingLabyrinth::buildTree()
+{
+    m_treeTiles.clear();
+    std::vector<Bounds> bounds;
+    for( std::map< LabyrinthTile::Coord, LabyrinthTile* >::iterator iter =
+        m_tiles.begin(); iter != m_tiles.end(); iter++ )
+    {
+        m_treeTiles.push_back( iter->second );
+        bounds.push_back( iter->second->bounds() );
+    }
+
+    m_tree.build( bounds );
+    m_treeDirty = false;
+}
+
+/**
+ * @brief      Gets how far a tile is from the nearest ball, in tiles.
+ *
+ * @param[in]  coord  The tile.
+ *
+ * @return     The distance to the nearest ball's tile.
+ */
+int StreamingLabyrinth::distance( const LabyrinthTile::Coord& coord ) const
+{
+    int nearest = INT_MAX;
+    for( const LabyrinthTile::Coord& center : m_focus )
+    {
+        nearest = std::min( nearest, std::max(
+            std::abs( coord.first - center.first ),
+            std::abs( coord.second - center.second ) ) );
+    }
+
+    return nearest;
+}
@@ -0,0 +1,110 @@
+#ifndef STREAMING_LABYRINTH_H
+#define STREAMING_LABYRINTH_H
+
+#include <QMatrix4x4>
+#include <QMediaPlayer>
+#include <QMutex>
+
+#include <atomic>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "3D/boundsTree.h"
+#include "3D/renderable.h"
+#include "Controls/camera3d.h"
+#include "Controls/jobSystem.h"
+#include "Maze/distanceField.h"
+#include "Maze/labyrinth.h"
+#include "Maze/labyrinthTile.h"
+
+/**
+ * @brief      Endless labyrinth streamed in tiles around the balls.
+ * @details    Tiles within LOAD_RADIUS of a ball are built as jobs on the
+ * JobSystem, then uploaded and added to the dynamics world on the GUI thread
+ * while drawing, a few per frame and nearest first. Tiles further than
+ * EVICT_RADIUS from every ball have their GL buffers and rigid body released.
+ * Only the tiles around the balls are ever resident, so memory and frame time
+ * stay the same however far the balls roll.
+ */
+class StreamingLabyrinth    :   public Renderable
+{
+public:
+    StreamingLabyrinth( Environment env, int seed,
+        btDiscreteDynamicsWorld* dynamicsWorld );
+    ~StreamingLabyrinth();
+
+    void stream( const std::vector<btVector3>& focus );
+    void uploadTiles();
+    bool isReady() const;
+    int numTiles() const;
+    std::pair<float, float> getStartingLocation();
+    const DistanceField& distanceField() const;
+    std::pair<int, int> fieldOrigin() const;
+
+    // Renderable Functions
+    void initializeGL();
+    void submit( RenderQueue& queue );
+    void update();
+    void teardownGL();
+
+private:
+    void request( const LabyrinthTile::Coord& coord );
+    void evict( LabyrinthTile* tile );
+    int distance( const LabyrinthTile::Coord& coord ) const;
+    void addToHome( const LabyrinthTile* tile );
+    void buildTree();
+
+    // Tiles are built this many tiles around a ball, and kept until they are
+    // further than EVICT_RADIUS, so tiles on the edge do not thrash
+    const int LOAD_RADIUS = 3;
+    const int EVICT_RADIUS = 4;
+
+    // Tiles around a ball that must be resident before the game starts
+    const int READY_RADIUS = 1;
+
+    // Built tiles uploaded per frame, to keep the frames even
+    const int UPLOADS_PER_FRAME = 2;
+
+    // Tiles around the first one covered by the distance field back to the
+    // start; the field keeps the tiles' cells after they are evicted
+    const int HOME_RADIUS = 4;
+
+    QMediaPlayer* player;
+
+    Environment m_env;
+    int m_seed;
+    btDiscreteDynamicsWorld* m_dynamicsWorld;
+
+    // Tiles the balls are on, as of the last stream
+    std::vector< LabyrinthTile::Coord > m_focus;
+
+    // Uploaded and in the world
+    std::map< LabyrinthTile::Coord, LabyrinthTile* > m_tiles;
+
+    // Resident tiles to cull, rebuilt whenever a tile comes or goes
+    BoundsTree m_tree;
+    std::vector< LabyrinthTile* > m_treeTiles;
+    bool m_treeDirty;
+
+    // Requested but not resident yet, whether building or built
+    std::set< LabyrinthTile::Coord > m_requested;
+    std::vector< LabyrinthTile* > m_uploads;
+
+    // Every cell streamed in near the start, and their way back to it
+    MazeGrid m_home;
+    DistanceField m_distanceField;
+
+    // Builds not known to be done yet, skipped once cancelled
+    std::vector< JobSystem::Handle > m_builds;
+    std::atomic<bool> m_cancelled;
+
+    // Filled by the builds as tiles are built
+    QMutex m_mutex;
+    std::vector< LabyrinthTile* > m_built;
+};
+
+#endif  //  STREAMING_LABYRINTH_H
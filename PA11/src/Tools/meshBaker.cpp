@@ -0,0 +1,76 @@
+/** @file meshBaker.cpp
+ * @brief Offline tool that bakes models into MeshCache files.
+ * @details Run from the bin directory so the baked paths match the ones the
+ * game loads, e.g. `./MeshBaker.exe models/*.obj`. Pass `--color` before any
+ * models that should be baked as material-based meshes.
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QTextStream>
+
+#include "3D/modelLoader.h"
+
+int main( int argc, char** argv )
+{
+    QCoreApplication app( argc, argv );
+    QTextStream out( stdout );
+
+    QStringList arguments = app.arguments();
+    arguments.removeFirst();
+
+    if( arguments.isEmpty() )
+    {
+        out << "Usage: MeshBaker.exe [--color] model.obj..." << endl;
+        return 1;
+    }
+
+    bool colorModels = false;
+    int failures = 0;
+
+    for( const QString& argument : arguments )
+    {
+        if( argument == "--color" )
+        {
+            colorModels = true;
+            continue;
+        }
+
+        bool loaded, cached;
+        int numVertices, numIndices;
+        MeshCache::Layout layout;
+        if( colorModels )
+        {
+            ColorMesh mesh;
+            loaded = ModelLoader::loadColorModel( argument, mesh, &cached );
+            numVertices = mesh.Vertices.size();
+            numIndices = mesh.Indices.size();
+            layout = MeshCache::ColorLayout;
+        }
+        else
+        {
+            UVMesh mesh;
+            loaded = ModelLoader::loadUVModel( argument, mesh, &cached );
+            numVertices = mesh.Vertices.size();
+            numIndices = mesh.Indices.size();
+            layout = MeshCache::UVLayout;
+        }
+
+        const QString cachePath = MeshCache::cachePath( argument, layout );
+        if( !loaded )
+        {
+            out << argument << ": failed to load" << endl;
+            failures++;
+        }
+        else if( !cached )
+        {
+            out << cachePath << ": failed to save" << endl;
+            failures++;
+        }
+        else
+            out << cachePath << ": " << numVertices << " vertices, "
+                << numIndices << " indices" << endl;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
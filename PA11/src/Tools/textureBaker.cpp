@@ -0,0 +1,112 @@
+/** @file textureBaker.cpp
+ * @brief Offline tool that bakes images into TextureCache files.
+ * @details Run from the bin directory so the baked paths match the ones the
+ * game loads, e.g. `./TextureBaker.exe textures/*.jpg`. Opaque images are
+ * stored DXT1 compressed; pass `--rgba` before any images that should keep a
+ * raw RGBA mip chain instead. Pass `--grid 3x4` before images laid out as a
+ * grid of textures, such as the labyrinth's cube crosses, to bake every cell
+ * as its own chain.
+ */
+
+#include <QGuiApplication>
+#include <QImage>
+#include <QStringList>
+#include <QTextStream>
+
+#include "3D/textureCache.h"
+
+/**
+ * @brief      Bakes a region of an image and reports it.
+ *
+ * @param      out        The stream to report to.
+ * @param[in]  path       The path to the image source.
+ * @param[in]  image      The decoded image.
+ * @param[in]  region     The region to bake.
+ * @param[in]  rawImages  Whether to keep a raw RGBA chain.
+ *
+ * @return     True if the region's cache was written.
+ */
+bool bake( QTextStream& out, const QString& path, const QImage& image,
+    const TextureCache::Region& region, bool rawImages )
+{
+    TextureCache::Format format =
+        rawImages || image.hasAlphaChannel() ?
+        TextureCache::RGBA8 : TextureCache::DXT1;
+
+    TextureCache::MipChain chain;
+    if( !TextureCache::build( TextureCache::crop( image, region ), format,
+        chain ) || !TextureCache::save( path, chain, region ) )
+    {
+        out << TextureCache::cachePath( path, region ) << ": failed to bake"
+            << endl;
+        return false;
+    }
+
+    qint64 bytes = 0;
+    for( const TextureCache::MipLevel& level : chain.Levels )
+        bytes += level.Data.size();
+
+    out << TextureCache::cachePath( path, region ) << ": "
+        << chain.Levels[0].Width << "x" << chain.Levels[0].Height
+        << ", " << chain.Levels.size() << " levels, "
+        << ( format == TextureCache::DXT1 ? "DXT1" : "RGBA" ) << ", "
+        << bytes / 1024 << " KiB" << endl;
+    return true;
+}
+
+int main( int argc, char** argv )
+{
+    QGuiApplication app( argc, argv );
+    QTextStream out( stdout );
+
+    QStringList arguments = app.arguments();
+    arguments.removeFirst();
+
+    if( arguments.isEmpty() )
+    {
+        out << "Usage: TextureBaker.exe [--rgba] [--grid CxR] image..."
+            << endl;
+        return 1;
+    }
+
+    bool rawImages = false;
+    int columns = 1, rows = 1;
+    int failures = 0;
+
+    for( int i = 0; i < arguments.size(); i++ )
+    {
+        const QString& argument = arguments[i];
+        if( argument == "--rgba" )
+        {
+            rawImages = true;
+            continue;
+        }
+
+        if( argument == "--grid" && i + 1 < arguments.size() )
+        {
+            const QStringList size = arguments[++i].split( 'x' );
+            columns = size.value( 0 ).toInt();
+            rows = size.value( 1 ).toInt();
+            if( columns < 1 || rows < 1 )
+            {
+                out << "Invalid grid " << arguments[i] << endl;
+                return 1;
+            }
+            continue;
+        }
+
+        // Every cell of the grid, or the whole image without one
+        const QImage image( argument );
+        for( int row = 0; row < rows; row++ )
+        {
+            for( int column = 0; column < columns; column++ )
+            {
+                if( !bake( out, argument, image, TextureCache::Region( column,
+                    row, columns, rows ), rawImages ) )
+                    failures++;
+            }
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
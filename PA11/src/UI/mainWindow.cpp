@@ -9,14 +9,18 @@
  * @details   Creates an OGLWidget with an OpenGL surface to draw on as the
  * central widget. A menu bar will also be created for user interaction with the
  * central widget.
+ *
+ * @param[in]  infinite  True to play an endless, streamed labyrinth.
  */
-MainWindow::MainWindow()
+MainWindow::MainWindow( bool infinite )
 {
     showMaximized();
 
     titleWidget = NULL;
     oglWidget = NULL;
     winWidget = NULL;
+    assetLoader = NULL;
+    infiniteMaze = infinite;
 
     createActions();
     createMenus();
@@ -37,7 +41,7 @@ void MainWindow::swapToTitle()
 
     titleWidget = new TitleWidget();
 
-    connect( titleWidget, SIGNAL( clickedPlay() ), this, SLOT( swapToGame() ) );
+    connect( titleWidget, SIGNAL( clickedPlay() ), this, SLOT( loadGame() ) );
     connect( titleWidget, SIGNAL( clickedExit() ), QApplication::instance(),
         SLOT( quit() ) );
 
@@ -52,6 +56,25 @@ void MainWindow::swapToTitle()
     }
 }
 
+/**
+ * @brief      Slot to decode the game's assets in the background, showing the
+ *             progress on the title screen. Swaps to the game once done.
+ */
+void MainWindow::loadGame()
+{
+    if( assetLoader != NULL )
+        return;
+
+    assetLoader = new AssetLoader( this );
+    Game::queueAssets( *assetLoader );
+
+    connect( assetLoader, SIGNAL( progress( int, int ) ),
+        titleWidget, SLOT( setProgress( int, int ) ) );
+    connect( assetLoader, SIGNAL( finished() ), this, SLOT( swapToGame() ) );
+
+    assetLoader->start();
+}
+
 void MainWindow::swapToGame()
 {
     menuBar->show();
@@ -62,11 +85,12 @@ void MainWindow::swapToGame()
     format.setRenderableType( QSurfaceFormat::OpenGL );
     format.setProfile( QSurfaceFormat::NoProfile );
     format.setVersion( 2,1 );
-    oglWidget = new OGLWidget();
+    oglWidget = new OGLWidget( infiniteMaze );
     oglWidget->setFormat( format );
 
     connect( actionPauseProgram, SIGNAL(triggered()), oglWidget , SLOT(pause()) );
     connect( oglWidget, SIGNAL(win()), this, SLOT(swapToWin()));
+    connect( oglWidget, SIGNAL(loaded()), this, SLOT(finishLoading()));
 
     setCentralWidget( oglWidget );
     if( titleWidget != NULL ){
@@ -79,6 +103,16 @@ void MainWindow::swapToGame()
     }
 }
 
+/**
+ * @brief      Releases the loader's handles once the game holds its own and has
+ *             uploaded them to the GPU.
+ */
+void MainWindow::finishLoading()
+{
+    delete assetLoader;
+    assetLoader = NULL;
+}
+
 void MainWindow::swapToWin()
 {
     winWidget = new WinWidget();
@@ -90,7 +124,8 @@ void MainWindow::swapToWin()
  */
 void MainWindow::restartGame()
 {
-    QProcess::startDetached(QApplication::applicationFilePath());
+    QProcess::startDetached(QApplication::applicationFilePath(),
+        QApplication::arguments().mid( 1 ));
     exit(12);
 }
 
@@ -7,6 +7,7 @@
 #include <QMenu>
 #include <QAction>
 
+#include "3D/assetLoader.h"
 #include "oglWidget.h"
 #include "titleWidget.h"
 #include "winWidget.h"
@@ -16,11 +17,13 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    MainWindow();
+    MainWindow( bool infinite = false );
 
 public slots:
     void swapToTitle();
+    void loadGame();
     void swapToGame();
+    void finishLoading();
     void swapToWin();
     void restartGame();
 
@@ -32,6 +35,8 @@ private:
     OGLWidget* oglWidget;
     TitleWidget* titleWidget;
     WinWidget* winWidget;
+    AssetLoader* assetLoader;
+    bool infiniteMaze;
 
     QMenuBar* menuBar;
     QMenu* menuFile;
@@ -5,8 +5,10 @@
 
 /**
  * @brief      Default constructor for OGLWidget.
+ *
+ * @param[in]  infinite  True to play an endless, streamed labyrinth.
  */
-OGLWidget::OGLWidget()
+OGLWidget::OGLWidget( bool infinite )
 {
     // Update the widget after a frameswap
     connect( this, SIGNAL( frameSwapped() ),
@@ -15,31 +17,8 @@ OGLWidget::OGLWidget()
     // Allows keyboard input to fall through
     setFocusPolicy( Qt::ClickFocus );
 
-    camera.rotate( -90.0f, 1.0f, 0.0f, 0.0f );
-    camera.translate( 30.0f, 75.0f, 30.0f );
-
-    Environment selectedEnvironment = Labyrinth::getRandomEnvironment();
-
-    renderables["Labyrinth"] = new Labyrinth( selectedEnvironment, time(NULL), 30, 30 );
-
-    std::pair<float, float> startingLocation = ((Labyrinth*)renderables["Labyrinth"])->getStartingLocation();
-
-    if( selectedEnvironment == Environment::Rock ){
-        renderables["Ball"] = new Ball( startingLocation.first, 1.5f, startingLocation.second, true );
-        renderables["Ball2"] = new Ball( startingLocation.first+0.5, 1.5f, startingLocation.second+0.5f, true);
-    }
-    else if( selectedEnvironment == Environment::Ice ){
-        renderables["Ball"] = new Ball( startingLocation.first, 1.5f, startingLocation.second, false );
-        renderables["Ball2"] = new Ball( startingLocation.first+0.5, 1.5f, startingLocation.second+0.5f, false);
-    }
-    else{
-        renderables["Ball"] = new Ball( startingLocation.first, 1.5f, startingLocation.second, true );
-        renderables["Ball2"] = new Ball( startingLocation.first+0.5, 1.5f, startingLocation.second+0.5f, true);
-    }
-
-    const btVector3 wallSize = btVector3(100, 50, 100);
-    const btVector3 location = btVector3(0, 52.5, 0 );
-    m_invisibleWall = new Wall( wallSize, location );
+    m_game = new Game( time(NULL), infinite );
+    m_profileInput = m_game->profiler().addSection( "Input" );
 }
 
 /**
@@ -49,7 +28,7 @@ OGLWidget::~OGLWidget()
 {
     makeCurrent();
     teardownGL();
-    teardownBullet();
+    delete m_game;
 }
 
 //
@@ -64,20 +43,9 @@ void OGLWidget::initializeGL()
     // Init OpenGL Backend
     initializeOpenGLFunctions();
     printContextInfo();
-    initializeBullet();
-
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
-    {
-        (*iter)->initializeGL();
-    }
-
-    ((Labyrinth*)renderables["Labyrinth"])->addRigidBodies( m_dynamicsWorld );
-    m_dynamicsWorld->addRigidBody( ((Ball*)renderables["Ball"])->RigidBody );    
-    m_dynamicsWorld->addRigidBody( ((Ball*)renderables["Ball2"])->RigidBody );
-    m_dynamicsWorld->addRigidBody( m_invisibleWall->RigidBody );
-
 
+    // The GL uploads are spread over the first frames, see paintGL
+    m_game->initializeGL();
 }
 
 /**
@@ -88,11 +56,7 @@ void OGLWidget::initializeGL()
  */
 void OGLWidget::resizeGL( int width, int height )
 {
-    projection.setToIdentity();
-    projection.perspective( 55.0f,  // Field of view angle
-                            float( width ) / float( height ),   // Aspect Ratio
-                            0.001f,  // Near Plane (MUST BE GREATER THAN 0)
-                            1500.0f );  // Far Plane
+    m_game->resizeGL( width, height );
 }
 
 /**
@@ -100,23 +64,17 @@ void OGLWidget::resizeGL( int width, int height )
  */
 void OGLWidget::paintGL()
 {
-    // Set the default OpenGL states
-    glEnable( GL_DEPTH_TEST );
-    glDepthFunc( GL_LEQUAL );
-    glDepthMask( GL_TRUE );
-    glEnable( GL_CULL_FACE );
-    glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
-
-    // Clear the screen
-    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
-
-
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
+    if( m_game->isLoading() )
     {
-        (*iter)->paintGL( camera, projection );
+        if( m_game->initializeNextRenderable() )
+            emit loaded();
+
+        paintLoading();
+        return;
     }
 
+    m_game->paintGL();
+
     // 2D Elements
     QFont ConsolasFont( "Consolas", std::min( 35 * (QWidget::width() / 1855.0f), 35 * (QWidget::height() / 1056.0f)), QFont::Bold );
     // Draw 2D Elements
@@ -125,8 +83,10 @@ void OGLWidget::paintGL()
     painter.beginNativePainting();
     painter.setPen( QColor( 255, 255, 255, 255 ) );
     painter.setFont( ConsolasFont );
-    painter.drawText( rect, Qt::AlignHCenter, QString::number( score ) );
+    painter.drawText( rect, Qt::AlignHCenter, QString::number( m_game->score() ) );
     painter.endNativePainting();
+
+    m_game->profiler().paintOverlay( painter, QWidget::rect() );
 }
 
 /**
@@ -134,11 +94,7 @@ void OGLWidget::paintGL()
  */
 void OGLWidget::teardownGL()
 {
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
-    {
-        (*iter)->teardownGL();
-    }
+    m_game->teardownGL();
 }
 
 //
@@ -151,30 +107,43 @@ void OGLWidget::teardownGL()
 void OGLWidget::update()
 {
     float dt = updateTimer.deltaTime();
+    m_game->profiler().nextFrame();
+
+    // Nothing moves until every renderable has been uploaded
+    if( m_game->isLoading() )
+    {
+        QOpenGLWidget::update();
+        return;
+    }
+
+    m_game->profiler().begin( m_profileInput );
     Input::update();
     flyThroughCamera();
+    controlProfiler();
 
     // Reset camera and gravity if space is pressed
     if( Input::keyPressed( Qt::Key_Space ) )
-    {
-        camera.setRotation( -90.0f, 1.0f, 0.0f, 0.0f );
-        camera.setTranslation( 30.0f, 75.0f, 30.0f );
-        m_dynamicsWorld->setGravity( btVector3( 0, -9.8, 0 ) );
-    }
+        m_game->resetBoard();
+
+    // Show the way to the goal, or let the AI roll the second ball there
+    if( Input::keyTriggered( Qt::Key_H ) )
+        m_game->toggleHint();
+    if( Input::keyTriggered( Qt::Key_G ) )
+        m_game->toggleAI();
 
     if( !isPaused )
-    {
-        checkIfWon();
         controlBoard();
+    m_game->profiler().end( m_profileInput );
+
+    // The frame time is still consumed while paused, so unpausing does not
+    // make the simulation catch up on the paused time
 
-        for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-            iter != renderables.end(); iter++ )
-        {
-            (*iter)->update();
-        }
+    if( !isPaused )
+    {
+        if( m_game->hasWon() )
+            emit win();
 
-        score += dt * 100;
-        m_dynamicsWorld->stepSimulation( dt, 10 );        
+        m_game->update( dt );
     }
 
     QOpenGLWidget::update();
@@ -242,38 +211,12 @@ void OGLWidget::mouseReleaseEvent( QMouseEvent* event )
 // PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
 //
 
-/**
- * @brief      Helper function to initialize bullet data.
- */
-void OGLWidget::initializeBullet()
-{
-    m_broadphase = new btDbvtBroadphase();
-    m_collisionConfig = new btDefaultCollisionConfiguration();
-    m_dispatcher = new btCollisionDispatcher( m_collisionConfig );
-    m_solver = new btSequentialImpulseConstraintSolver();
-    m_dynamicsWorld = new btDiscreteDynamicsWorld( m_dispatcher, m_broadphase,
-        m_solver, m_collisionConfig );
-    m_dynamicsWorld->setGravity( btVector3( 0, -9.8, 0 ) );
-}
-
-/**
- * @brief      Helper function to delete bullet allocations.
- */
-void OGLWidget::teardownBullet()
-{
-    delete m_dynamicsWorld;
-    delete m_solver;
-    delete m_dispatcher;
-    delete m_collisionConfig;
-    delete m_broadphase;
-}
-
-
 /**
  * @brief      Updates the main camera to behave like a Fly-Through Camera.
  */
 void OGLWidget::flyThroughCamera()
 {
+    Camera3D& camera = m_game->camera();
     static const float cameraTranslationSpeed = 0.02f;
     static const float cameraRotationSpeed = 0.1f;
 
@@ -304,67 +247,60 @@ void OGLWidget::flyThroughCamera()
 } 
 
 /**
- * @brief      Shows victory message if both balls go through the hole.
+ * @brief      Tilts the board based on user input.
  */
-void OGLWidget::checkIfWon()
+void OGLWidget::controlBoard()
 {
-    btTransform firstObject; 
-    (((Ball*)renderables["Ball"])->RigidBody->getMotionState())->getWorldTransform(firstObject);
+    int horizontal = 0;
+    if( Input::keyPressed( Qt::Key_Left ) )
+        horizontal = -1;
+    else if( Input::keyPressed( Qt::Key_Right ) )
+        horizontal = 1;
 
-    btTransform secondObject;
-    (((Ball*)renderables["Ball2"])->RigidBody->getMotionState())->getWorldTransform(secondObject);
+    int vertical = 0;
+    if( Input::keyPressed( Qt::Key_Up ) )
+        vertical = -1;
+    else if( Input::keyPressed( Qt::Key_Down ) )
+        vertical = 1;
 
-    if( firstObject.getOrigin().y() < 0 && secondObject.getOrigin().y() < 0 )
-    {
-        emit win();
-    }
+    m_game->setTilt( horizontal, vertical );
 }
 
-
 /**
- * @brief      Updates board based on user input.
+ * @brief      Toggles the profiler overlay with F3 and saves the recorded
+ *             frames to profile.csv and profile.json with F4.
  */
-void OGLWidget::controlBoard()
+void OGLWidget::controlProfiler()
 {
-    const float rotationSpeed = 0.7f;
-    const float rollingSpeed = 0.5f;
-    btVector3 gravity = m_dynamicsWorld->getGravity();
-
-    // Update horizontal rotation
-    if( Input::keyPressed( Qt::Key_Left ) )
-    {
-        camera.rotate( -rotationSpeed, QVector3D(0, 0, 1) );            
-        camera.translate( 0.70f, 0, 0);
-        gravity -= btVector3( rollingSpeed, 0, 0 );
-    }
-
-    else if( Input::keyPressed( Qt::Key_Right ) )
-    {
-        camera.rotate( rotationSpeed, QVector3D(0, 0, 1) );            
-        camera.translate( -0.70f, 0, 0);                
-        gravity += btVector3( rollingSpeed, 0, 0 );
-    }
-
-
-    // Update vertical rotation
-    if( Input::keyPressed( Qt::Key_Up ) )
-    {
-        camera.rotate( rotationSpeed, QVector3D(1, 0, 0) );
-        camera.translate( 0, 0, 0.70f );        
-        gravity -= btVector3( 0, 0, rollingSpeed );
-    }
+    if( Input::keyTriggered( Qt::Key_F3 ) )
+        m_game->profiler().OverlayVisible = !m_game->profiler().OverlayVisible;
 
-    else if( Input::keyPressed( Qt::Key_Down ) )
+    if( Input::keyTriggered( Qt::Key_F4 ) )
     {
-        camera.rotate( -rotationSpeed, QVector3D(1, 0, 0) );
-        camera.translate( 0, 0, -0.70f );        
-        gravity += btVector3( 0, 0, rollingSpeed );
+        if( m_game->profiler().exportCSV( "profile.csv" ) &&
+            m_game->profiler().exportTrace( "profile.json" ) )
+            qDebug() << "Saved profile.csv and profile.json";
+        else
+            qDebug() << "Could not save the profile";
     }
+}
 
-    // Update gravity
-    m_dynamicsWorld->setGravity( gravity );
+/**
+ * @brief      Draws the loading screen shown while renderables are uploaded.
+ */
+void OGLWidget::paintLoading()
+{
+    glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
+    QFont ConsolasFont( "Consolas", std::min( 35 * (QWidget::width() / 1855.0f), 35 * (QWidget::height() / 1056.0f)), QFont::Bold );
+    QPainter painter(this);
+    painter.setPen( QColor( 255, 255, 255, 255 ) );
+    painter.setFont( ConsolasFont );
+    painter.drawText( rect(), Qt::AlignCenter, QString( "Loading %1 / %2" )
+        .arg( m_game->numInitialized() ).arg( m_game->numRenderables() ) );
 }
+
 /**
  * @brief      Helper function to print OpenGL Context information to the debug.
  */
@@ -10,23 +10,14 @@
 #include <QKeyEvent>
 #include <QMouseEvent>
 
-#include <QMap>
-#include <QMatrix4x4>
-
 #include <QDebug>
 #include <QString>
 #include <QMediaPlayer>
 #include <QPainter>
 
-#include <btBulletDynamicsCommon.h>
-
 #include "Controls/input.h"
-#include "Controls/camera3d.h"
 #include "Controls/time.h"
-#include "3D/renderable.h"
-#include "Maze/labyrinth.h"
-#include "Maze/ball.h"
-#include "Maze/wall.h"
+#include "Maze/game.h"
 
 class OGLWidget    :    public QOpenGLWidget,
                         protected QOpenGLFunctions
@@ -34,7 +25,7 @@ class OGLWidget    :    public QOpenGLWidget,
     Q_OBJECT
 
 public:
-    OGLWidget();
+    OGLWidget( bool infinite = false );
     OGLWidget( QString team1, QString team2 );
     ~OGLWidget();
 
@@ -45,6 +36,7 @@ public:
 
 signals:
     void win();
+    void loaded();
 
 protected slots:
     void pause();
@@ -57,34 +49,22 @@ protected:
     void mouseReleaseEvent( QMouseEvent* event );
 
 private:
-    void initializeBullet();
-    void teardownBullet();
     void flyThroughCamera();
     void controlBoard();
+    void controlProfiler();
+    void paintLoading();
     void printContextInfo();
-    void checkIfWon();
-
-    // OpenGL Objects
-    QMap<QString, Renderable*> renderables;
 
-    // Invisible Bullet object
-    Wall* m_invisibleWall;
-    int score;
-
-    // 3D data
-    QMatrix4x4 projection;
-    Camera3D camera;
-
-    // Bullet data
-    btBroadphaseInterface* m_broadphase;
-    btDefaultCollisionConfiguration* m_collisionConfig;
-    btCollisionDispatcher* m_dispatcher;
-    btSequentialImpulseConstraintSolver* m_solver;
-    btDiscreteDynamicsWorld* m_dynamicsWorld;
+    // Scene, physics and renderables
+    Game* m_game;
 
     // World Timer
     Time updateTimer;
 
+    // Input section of the game's profiler, F3 toggles the overlay and F4
+    // saves the timings
+    int m_profileInput;
+
     // Pause flag
     bool isPaused = false;
 };
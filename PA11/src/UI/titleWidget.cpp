@@ -13,6 +13,11 @@ TitleWidget::TitleWidget()
     m_lbBackground->setPixmap( *m_imgBackground );
     m_lbBackground->setScaledContents( true );
 
+    m_lbProgress = new QLabel( this );
+    m_lbProgress->setAlignment( Qt::AlignCenter );
+    m_lbProgress->setStyleSheet( "QLabel{color: white; font: bold;}" );
+    m_lbProgress->hide();
+
     QIcon iconPlay = QIcon( *m_imgPlay );
     m_btnPlay = new QPushButton( this );
     m_btnPlay->setIcon( iconPlay );
@@ -43,11 +48,30 @@ TitleWidget::~TitleWidget()
     delete m_imgGear;
     delete m_imgPlay;
     delete m_lbBackground;
+    delete m_lbProgress;
     delete m_btnPlay;
     delete m_btnExit;
     delete m_btnSettings;
 }
 
+/**
+ * @brief      Shows the progress of the game's asset loading in place of the
+ *             buttons.
+ *
+ * @param[in]  loaded  The number of assets loaded so far.
+ * @param[in]  total   The number of assets being loaded.
+ */
+void TitleWidget::setProgress( int loaded, int total )
+{
+    m_btnPlay->setEnabled( false );
+    m_btnPlay->hide();
+    m_btnExit->hide();
+    m_btnSettings->hide();
+
+    m_lbProgress->setText( QString( "Loading %1 / %2" ).arg( loaded ).arg( total ) );
+    m_lbProgress->show();
+}
+
 void TitleWidget::resizeEvent( QResizeEvent* event )
 {
     (void)event;
@@ -69,6 +93,9 @@ void TitleWidget::resize()
     m_btnExit->setGeometry( QWidget::width() - (350.0f * percentWidth), QWidget::height() - (170 * percentHeight),
         80 * percentWidth, 80 * percentHeight );
 
+    m_lbProgress->setGeometry( QWidget::width() - (450.0f * percentWidth), QWidget::height() - (170 * percentHeight),
+        280 * percentWidth, 80 * percentHeight );
+
     m_btnSettings->setIconSize( QSize( 80 * percentWidth, 79 * percentHeight ) );
     m_btnSettings->setGeometry( QWidget::width() - (250.0f * percentWidth), QWidget::height() - (170 * percentHeight),
         80 * percentWidth, 80 * percentHeight );
@@ -15,6 +15,9 @@ public:
     TitleWidget();
     ~TitleWidget();
 
+public slots:
+    void setProgress( int loaded, int total );
+
 signals:
     void clickedPlay();
     void clickedSettings();
@@ -27,6 +30,7 @@ private:
     void resize();
 
     QLabel* m_lbBackground;
+    QLabel* m_lbProgress;
 
     QPushButton* m_btnPlay;
     QPushButton* m_btnExit;
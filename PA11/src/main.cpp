@@ -6,7 +6,9 @@
  */
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <time.h>
+#include "Controls/benchmark.h"
 #include "UI/mainWindow.h"
 
 int main( int argc, char** argv )
@@ -14,8 +16,43 @@ int main( int argc, char** argv )
     srand( time(NULL) );
 
     QApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption benchmarkOption( "benchmark",
+        "Runs <frames> frames without a window and prints their timings.",
+        "frames" );
+    QCommandLineOption seedOption( "seed",
+        "Seed of the benchmarked labyrinth.", "seed", "1" );
+    QCommandLineOption tickRateOption( "tick-rate",
+        "Physics ticks per second of the benchmark.", "ticks", "60" );
+    QCommandLineOption mazeBenchmarkOption( "maze-benchmark",
+        "Generates a <size> by <size> maze and prints its timings.", "size" );
+    QCommandLineOption infiniteOption( "infinite",
+        "Plays an endless labyrinth, streamed in around the balls." );
+    parser.addOption( benchmarkOption );
+    parser.addOption( infiniteOption );
+    parser.addOption( mazeBenchmarkOption );
+    parser.addOption( seedOption );
+    parser.addOption( tickRateOption );
+    parser.process( app );
+
+    if( parser.isSet( mazeBenchmarkOption ) )
+    {
+        return Benchmark::runMaze( parser.value( mazeBenchmarkOption ).toInt(),
+            parser.value( seedOption ).toInt() );
+    }
+
+    if( parser.isSet( benchmarkOption ) )
+    {
+        Benchmark benchmark( parser.value( benchmarkOption ).toInt(),
+            parser.value( seedOption ).toInt(),
+            parser.value( tickRateOption ).toFloat(),
+            parser.isSet( infiniteOption ) );
+        return benchmark.run();
+    }
     
-    MainWindow mainWindow;
+    MainWindow mainWindow( parser.isSet( infiniteOption ) );
     mainWindow.resize( QSize( 800, 600 ) );
     mainWindow.setWindowTitle( "PA11 Labyrinth - Ben Nicholes, Denis Morozov, " 
         "Saharath Kleips" );
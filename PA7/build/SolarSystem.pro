@@ -23,14 +23,22 @@ QMAKE_CXXFLAGS_WARD_ON += -Wall -pedantic
 # HEADERS += first_file.h second_file.h
 # SOURCES += first_file.cpp second_file.cpp
 HEADERS += \
+    ../src/benchmark.h \
+    ../src/bounds.h \
     ../src/camera3d.h \
+    ../src/frustum.h \
+    ../src/glState.h \
     ../src/input.h \
+    ../src/jobSystem.h \
     ../src/mainWindow.h \
     ../src/modelLoader.h \
     ../src/oglWidget.h \
     ../src/renderable.h \
+    ../src/resourceCache.h \
     ../src/ring.h \
+    ../src/scene.h \
     ../src/skybox.h \
+    ../src/textureCache.h \
     ../src/transform3d.h \
     ../src/vertex.h \
     #PLANETS
@@ -49,14 +57,22 @@ HEADERS += \
 
 
 SOURCES += \
+    ../src/benchmark.cpp \
+    ../src/bounds.cpp \
     ../src/camera3d.cpp \
+    ../src/frustum.cpp \
+    ../src/glState.cpp \
     ../src/input.cpp \
+    ../src/jobSystem.cpp \
     ../src/main.cpp \
     ../src/mainWindow.cpp \
     ../src/modelLoader.cpp \
     ../src/oglWidget.cpp \
+    ../src/resourceCache.cpp \
     ../src/ring.cpp \
+    ../src/scene.cpp \
     ../src/skybox.cpp \
+    ../src/textureCache.cpp \
     ../src/transform3d.cpp \
     ../src/vertex.cpp \
     #PLANETS
@@ -27,10 +27,17 @@ void Earth::initializeGL()
 }
 
 
-void Earth::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void Earth::paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state )
 {
-    Planet::paintGL( camera, projection );
-    moon->paintGL( camera, projection );
+    // The moon never strays far from the earth, so both are skipped at once
+    // while neither is in view
+    Bounds system = worldBounds();
+    system.expand( moon->worldBounds() );
+    if( !Frustum( projection * camera.toMatrix() ).intersects( system ) )
+        return;
+
+    Planet::paintGL( camera, projection, state );
+    moon->paintGL( camera, projection, state );
 }
 
 void Earth::update()
@@ -4,14 +4,6 @@
 // STATIC VARIABLE INITILIZATION ///////////////////////////////////////////////
 // 
 bool Planet::SCALED = false;
-QOpenGLBuffer* Planet::vbo = NULL;
-QOpenGLVertexArrayObject* Planet::vao = NULL;
-QOpenGLShaderProgram* Planet::program = NULL;
-Vertex* Planet::model = NULL;
-int Planet::numVertices = -1;
-int Planet::modelWorld = -1;
-int Planet::worldEye = -1;
-int Planet::eyeClip = -1;
 
 //
 // CONSTRUCTORS ////////////////////////////////////////////////////////////////
@@ -19,19 +11,16 @@ int Planet::eyeClip = -1;
 
 
 Planet::Planet()
+    :   vao( NULL ), modelClip( -1 )
 {
     m_texturePath = ":/texture/earth.jpg";
-    if( model == NULL )
-        loadModel( MODEL_PATH, model, numVertices );
+    model = ResourceCache::model( MODEL_PATH );
 }
 
 Planet::Planet( QString texturePath )
-    :   m_texturePath( texturePath )
+    :   vao( NULL ), m_texturePath( texturePath ), modelClip( -1 )
 {
-    if( model == NULL )
-    {
-        loadModel( MODEL_PATH, model, numVertices );
-    }
+    model = ResourceCache::model( MODEL_PATH );
 }
 
 Planet::~Planet()
@@ -50,102 +39,84 @@ Planet::~Planet()
 void Planet::initializeGL()
 {
     initializeOpenGLFunctions();
-    // Create the shader this planet will be using
-    if( program == NULL )
-    {    
-        program = new QOpenGLShaderProgram();
-        program->addShaderFromSourceFile( QOpenGLShader::Vertex, 
-            V_SHADER_PATH );
-        program->addShaderFromSourceFile( QOpenGLShader::Fragment, 
-            F_SHADER_PATH );
-        program->link();
-        program->bind();
-        
-        // Cache the Uniform Locations
-        modelWorld = program->uniformLocation( "model_to_world" );
-        worldEye = program->uniformLocation( "world_to_eye" );
-        eyeClip = program->uniformLocation( "eye_to_clip" );
-
-    }
-    else
-        program->bind();
-
-    // Create Texture Buffer Object
-    texture = new QOpenGLTexture( QImage( m_texturePath ).mirrored() );
-    
-    texture->setMinificationFilter( QOpenGLTexture::LinearMipMapLinear );
-    texture->setMagnificationFilter( QOpenGLTexture::Linear );
-
-    // Create the Vertex Buffer Object only if it's not already created
-    if( vbo == NULL )
-    {
-        vbo = new QOpenGLBuffer();
-        vbo->create();
-        vbo->bind();
-        vbo->setUsagePattern( QOpenGLBuffer::StaticDraw );
-        vbo->allocate( model, numVertices * sizeof( model[0] ) );
-    }
-    else
-        vbo->bind();
-
-    // Create the Vertex Array Object only if it's not already created
-    if( vao == NULL )
-    {
-        vao = new QOpenGLVertexArrayObject();
-        vao->create();
-        vao->bind();
-        program->enableAttributeArray( 0 );
-        program->enableAttributeArray( 1 );
-        program->setAttributeBuffer(    0,
-                                        GL_FLOAT,
-                                        Vertex::positionOffset(),
-                                        Vertex::PositionTupleSize,
-                                        Vertex::stride() );
-        program->setAttributeBuffer(    1,
-                                        GL_FLOAT,
-                                        Vertex::uvOffset(),
-                                        Vertex::UVTupleSize,
-                                        Vertex::stride() );
-    }
-    else
-        vao->bind();
+
+    // Every planet shares one program, vertex buffer and texture per path
+    program = ResourceCache::program( V_SHADER_PATH, F_SHADER_PATH );
+    texture = ResourceCache::texture( m_texturePath );
+    vbo = ResourceCache::vertexBuffer( MODEL_PATH );
+
+    // Cache the Uniform Locations
+    modelClip = program->uniformLocation( "model_to_clip" );
+
+    // Create the Vertex Array Object
+    program->bind();
+    vbo->bind();
+    vao = new QOpenGLVertexArrayObject();
+    vao->create();
+    vao->bind();
+    program->enableAttributeArray( 0 );
+    program->enableAttributeArray( 1 );
+    program->setAttributeBuffer(    0,
+                                    GL_FLOAT,
+                                    Vertex::positionOffset(),
+                                    Vertex::PositionTupleSize,
+                                    Vertex::stride() );
+    program->setAttributeBuffer(    1,
+                                    GL_FLOAT,
+                                    Vertex::uvOffset(),
+                                    Vertex::UVTupleSize,
+                                    Vertex::stride() );
 
     // Release all in order
     vao->release();
     vbo->release();
-    texture->release();
     program->release();
 }
 
-void Planet::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void Planet::paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state )
 {
-    glEnable( GL_DEPTH_TEST );
-    glDepthFunc( GL_LEQUAL );
-    glDepthMask( GL_TRUE );
-    glEnable( GL_CULL_FACE );
+    // Skip the draw while out of view, which far off bodies mostly are
+    const QMatrix4x4 worldToClip = projection * camera.toMatrix();
+    const Frustum frustum( worldToClip );
+    if( !frustum.intersects( worldBounds() ) )
+        return;
 
-    program->bind();
-
-    program->setUniformValue( worldEye, camera.toMatrix() );
-    program->setUniformValue( eyeClip, projection );
-
-    vao->bind();
-    texture->bind();
+    state.setDepthTest( true );
+    state.setDepthFunc( GL_LEQUAL );
+    state.setDepthMask( true );
+    state.setCullFace( GL_BACK );
 
-    program->setUniformValue( modelWorld, transform.toMatrix() );
+    state.useProgram( program.data() );
+    state.bindVAO( vao );
+    state.bindTexture( texture.data() );
 
-    glDrawArrays( GL_TRIANGLES, 0, numVertices );
+    program->setUniformValue( modelClip, worldToClip * transform.toMatrix() );
 
-    texture->release();
-    vao->release();
-    program->release();
+    glDrawArrays( GL_TRIANGLES, 0, model->NumVertices );
+    state.countDrawCall( model->NumVertices / 3 );
 }
 
 void Planet::update()
 {
 }
 
+/**
+ * @brief      Gets the box around the planet where it is now.
+ *
+ * @return     The bounds of the planet, in world space.
+ */
+Bounds Planet::worldBounds()
+{
+    return model->Box.transformed( transform.toMatrix() );
+}
+
 void Planet::teardownGL()
 {
-    delete texture;
-}
\ No newline at end of file
+    delete vao;
+    vao = NULL;
+
+    // The last planet to let go of them frees them
+    texture.clear();
+    vbo.clear();
+    program.clear();
+}
@@ -6,18 +6,19 @@
 #include <QOpenGLVertexArrayObject>
 #include <QOpenGLTexture>
 #include <QOpenGLShaderProgram>
+#include <QSharedPointer>
 #include <QDebug>
 
 #include "../renderable.h"
-#include "../modelLoader.h"
+#include "../resourceCache.h"
 #include "../transform3d.h"
 #include "../camera3d.h"
+#include "../frustum.h"
 #include "../vertex.h"
 
 class QOpenGLShaderProgram;
 
-class Planet    :   public Renderable,
-                    protected ModelLoader
+class Planet    :   public Renderable
 {
 protected:
     Planet();
@@ -30,35 +31,34 @@ protected:
 
 public:
     void initializeGL();
-    void paintGL( Camera3D& camera, QMatrix4x4& projection );
+    void paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state );
     virtual void update();
     void teardownGL();
 
+    Bounds worldBounds();
+
     // Planet Information
     Transform3D transform;
     static bool SCALED;
 
 private:
-    // OpenGL State Information
-    static QOpenGLBuffer* vbo;
-    static QOpenGLVertexArrayObject* vao;
-    static QOpenGLShaderProgram* program;
+    // OpenGL State Information, shared through the ResourceCache
+    QSharedPointer<QOpenGLBuffer> vbo;
+    QOpenGLVertexArrayObject* vao;
+    QSharedPointer<QOpenGLShaderProgram> program;
 
     // Model Information
     const QString MODEL_PATH = "models/planet.obj";
-    static Vertex* model;
-    static int numVertices;
+    QSharedPointer<ResourceCache::Model> model;
 
     // Texture Information
     QString m_texturePath;
-    QOpenGLTexture* texture;
+    QSharedPointer<QOpenGLTexture> texture;
 
     // Shader Information
     const QString V_SHADER_PATH = ":/shader/simple.vs";
     const QString F_SHADER_PATH = ":/shader/simple.fs";
-    static int modelWorld;
-    static int worldEye;
-    static int eyeClip;
+    int modelClip;
 };
 
 #endif  //  PLANET_H
\ No newline at end of file
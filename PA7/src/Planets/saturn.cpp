@@ -25,10 +25,17 @@ void Saturn::initializeGL()
 }
 
 
-void Saturn::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void Saturn::paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state )
 {
-    Planet::paintGL( camera, projection );
-    ring->paintGL( camera, projection );
+    // The rings surround the planet, so both are skipped at once while
+    // neither is in view
+    Bounds system = worldBounds();
+    system.expand( ring->worldBounds() );
+    if( !Frustum( projection * camera.toMatrix() ).intersects( system ) )
+        return;
+
+    Planet::paintGL( camera, projection, state );
+    ring->paintGL( camera, projection, state );
 }
 
 void Saturn::update()
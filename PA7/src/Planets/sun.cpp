@@ -1,5 +1,31 @@
 #include "sun.h"
 
+#include "../jobSystem.h"
+
+namespace
+{
+    // Where each planet orbits, in the order of Sun::orbiting
+    struct Orbit
+    {
+        const char* Name;
+        float Radius;
+        float StartAngle;
+        float Speed;
+    };
+
+    const Orbit ORBITS[] = {
+        { "Mercury", 3.0f, 2.0f, 0.035f },
+        { "Venus", 6.0f, 23.0f, 0.0090f },
+        { "Earth", 11.0f, 10.0f, 0.00099f },
+        { "Mars", 18.0f, 8.0f, 0.000945f },
+        { "Jupiter", 36.0f, 20.0f, 0.00050f },
+        { "Saturn", 72.0f, 28.0f, 0.00040f },
+        { "Uranus", 100.0f, 30.0f, 0.00035f },
+        { "Neptune", 200.0f, 46.0f, 0.00020f },
+        { "Pluto", 300.0f, 55.0f, 0.000010f }
+    };
+}
+
 //
 // CONSTRUCTORS ////////////////////////////////////////////////////////////////
 // 
@@ -20,6 +46,12 @@ Sun::Sun()
     planets["Uranus"] =  new Uranus();
     planets["Neptune"] = new Neptune();
     planets["Pluto"] = new Pluto();
+
+    for( int i = 0; i < NUM_ORBITS; i++ )
+    {
+        orbiting[i] = planets[ ORBITS[i].Name ];
+        orbitAngles[i] = ORBITS[i].StartAngle;
+    }
 }
 
 //
@@ -37,15 +69,15 @@ void Sun::initializeGL()
     }
 }
 
-void Sun::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void Sun::paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state )
 {
-    Planet::paintGL( camera, projection );
+    Planet::paintGL( camera, projection, state );
     
     // PAINT ALL PLANETS
     for( QMap<QString, Planet*>::iterator iter = planets.begin(); 
         iter != planets.end(); iter++ )
     {
-        (*iter)->paintGL( camera, projection );
+        (*iter)->paintGL( camera, projection, state );
     }
 }
 
@@ -56,102 +88,36 @@ void Sun::update()
         transform.rotate( 0.27f, 0, 1, 0 );
     }
 
-    // MERCURY
-    {
-        static float translationAngle = 2.0;
-        translationAngle += .035;
-        planets["Mercury"]->transform.setTranslation( 
-            transform.translation().x() + 3.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 3.0f * cos( translationAngle ));
-    }
-
-    // VENUS
-    {
-        static float translationAngle = 23.0;
-        translationAngle += .0090;
-        planets["Venus"]->transform.setTranslation( 
-            transform.translation().x() + 6.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 6.0f * cos( translationAngle ) );
-    }
-
-    // EARTH
-    {
-        static float translationAngle = 10.0;
-        translationAngle += .00099;
-        planets["Earth"]->transform.setTranslation( 
-            transform.translation().x() + 11.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 11.0f * cos( translationAngle ) );
-    }
-
-    // MARS
-    {
-        static float translationAngle = 8.0;
-        translationAngle += .000945;
-        planets["Mars"]->transform.setTranslation( 
-            transform.translation().x() + 18.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 18.0f * cos( translationAngle ) );
-    }
-
-    // JUPITER
-    {
-        static float translationAngle = 20.0;
-        translationAngle += .00050;
-        planets["Jupiter"]->transform.setTranslation( 
-            transform.translation().x() + 36.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 36.0f * cos( translationAngle ) );
-    }
-
-    // SATURN
-    {
-        static float translationAngle = 28.0;
-        translationAngle += .00040;
-        planets["Saturn"]->transform.setTranslation( 
-            transform.translation().x() + 72.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 72.0f * cos( translationAngle ) );
-    }
-
-    // URANUS
-    {
-        static float translationAngle = 30.0;
-        translationAngle += .00035;
-        planets["Uranus"]->transform.setTranslation( 
-            transform.translation().x() + 100.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 100.0f * cos( translationAngle ) );
-    }
-
-    // NEPTUNE
-    {
-        static float translationAngle = 46.0;
-        translationAngle += .00020;
-        planets["Neptune"]->transform.setTranslation( 
-            transform.translation().x() + 200.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 200.0f * cos( translationAngle ) );
-    }
+    // Each planet only moves itself and its moons and rings, so they all
+    // update side by side
+    JobSystem::instance().parallelFor( 0, NUM_ORBITS, 1,
+        [this]( int begin, int end ){
+            for( int i = begin; i < end; i++ )
+                updateOrbit( i );
+        } );
+}
 
-    // PLUTO
-    {
-        static float translationAngle = 55.0;
-        translationAngle += .000010;
-        planets["Pluto"]->transform.setTranslation( 
-            transform.translation().x() + 300.0f * sin( translationAngle ),
-            transform.translation().y(),
-            transform.translation().z() + 300.0f * cos( translationAngle ) );
-    }
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
 
-    // UPDATE ALL PLANETS
-    for( QMap<QString, Planet*>::iterator iter = planets.begin(); 
-        iter != planets.end(); iter++ )
-    {
-        (*iter)->update();
-    }
+/**
+ * @brief      Moves a planet along its orbit, then updates it. Touches nothing
+ *             but the planet, so orbits can be updated in parallel.
+ *
+ * @param[in]  orbit  The index of the orbit.
+ */
+void Sun::updateOrbit( int orbit )
+{
+    const Orbit& data = ORBITS[orbit];
+    orbitAngles[orbit] += data.Speed;
+
+    const float angle = orbitAngles[orbit];
+    orbiting[orbit]->transform.setTranslation(
+        transform.translation().x() + data.Radius * sin( angle ),
+        transform.translation().y(),
+        transform.translation().z() + data.Radius * cos( angle ) );
+    orbiting[orbit]->update();
 }
 
 void Sun::teardownGL()
@@ -22,12 +22,20 @@ public:
     Sun();
 
     void initializeGL();
-    void paintGL( Camera3D& camera, QMatrix4x4& projection );
+    void paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state );
     void update();
     void teardownGL();
 
 private:
+    void updateOrbit( int orbit );
+
     QMap<QString, Planet*> planets;
+
+    // Each planet with its angle along its orbit, read by the update jobs
+    // without touching the map
+    enum { NUM_ORBITS = 9 };
+    Planet* orbiting[NUM_ORBITS];
+    float orbitAngles[NUM_ORBITS];
 };
 
 #endif  //  SUN_H
\ No newline at end of file
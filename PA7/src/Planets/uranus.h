@@ -10,7 +10,7 @@ public:
     Uranus();
 
     void initializeGL();
-    void paintGL( Camera3D& camera, QMatrix4x4& projection );
+    void paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state );
     void update();
     void teardownGL();
 
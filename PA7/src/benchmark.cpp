@@ -0,0 +1,185 @@
+#include "benchmark.h"
+
+#include <QElapsedTimer>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QSurfaceFormat>
+
+#include <algorithm>
+#include <cmath>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Benchmark.
+ *
+ * @param[in]  numFrames  The number of frames to run.
+ * @param[in]  width      The width of the offscreen framebuffer.
+ * @param[in]  height     The height of the offscreen framebuffer.
+ */
+Benchmark::Benchmark( int numFrames, int width, int height )
+    :   m_numFrames( numFrames ), m_width( width ), m_height( height )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Loads the scene, runs every frame and prints the results.
+ *
+ * @return     The exit code of the program.
+ */
+int Benchmark::run()
+{
+    QTextStream out( stdout );
+
+    // Same context the window asks for
+    QSurfaceFormat format;
+    format.setDepthBufferSize( 24 );
+    format.setRenderableType( QSurfaceFormat::OpenGL );
+    format.setProfile( QSurfaceFormat::NoProfile );
+    format.setVersion( 2,1 );
+
+    QOpenGLContext context;
+    context.setFormat( format );
+    if( !context.create() )
+    {
+        out << "Could not create an OpenGL context" << endl;
+        return 1;
+    }
+
+    QOffscreenSurface surface;
+    surface.setFormat( context.format() );
+    surface.create();
+    if( !context.makeCurrent( &surface ) )
+    {
+        out << "Could not make the OpenGL context current" << endl;
+        return 1;
+    }
+
+    QOpenGLFramebufferObject framebuffer( m_width, m_height,
+        QOpenGLFramebufferObject::Depth );
+    framebuffer.bind();
+
+    QOpenGLFunctions* gl = context.functions();
+    out << "OpenGL " << reinterpret_cast<const char*>(
+        gl->glGetString( GL_RENDERER ) ) << ", " << m_numFrames
+        << " frames at " << m_width << "x" << m_height << endl;
+
+    // Everything is loaded up front, loading is not part of the run
+    Scene scene;
+    scene.initializeGL();
+    scene.resizeGL( m_width, m_height );
+    scene.setPaused( false );
+
+    std::vector<double> frameTimes, updateTimes, drawTimes, finishTimes;
+    std::vector<double> drawCalls, triangles, stateCalls, stateSkipped;
+
+    // Every frame moves the planets one step, as in the window
+    QElapsedTimer frameTimer, timer;
+    for( int frame = 0; frame < m_numFrames; frame++ )
+    {
+        frameTimer.start();
+
+        timer.start();
+        cameraScript( scene, frame );
+        scene.update();
+        updateTimes.push_back( timer.nsecsElapsed() / 1e6 );
+
+        timer.start();
+        scene.glState().resetCounts();
+        scene.paintGL();
+        drawTimes.push_back( timer.nsecsElapsed() / 1e6 );
+
+        // Wait for the GPU, so the frame time includes the draw itself
+        timer.start();
+        gl->glFinish();
+        finishTimes.push_back( timer.nsecsElapsed() / 1e6 );
+
+        frameTimes.push_back( frameTimer.nsecsElapsed() / 1e6 );
+
+        drawCalls.push_back( scene.glState().drawCalls() );
+        triangles.push_back( scene.glState().triangles() );
+        stateCalls.push_back( scene.glState().issuedCalls() );
+        stateSkipped.push_back( scene.glState().skippedCalls() );
+    }
+
+    out << qSetFieldWidth( 10 ) << left << "" << right << "mean" << "p50"
+        << "p99" << "max" << qSetFieldWidth( 0 ) << "  (ms)" << endl;
+    report( out, "Frame", frameTimes );
+    report( out, "Update", updateTimes );
+    report( out, "Draw", drawTimes );
+    report( out, "Finish", finishTimes );
+
+    out << qSetFieldWidth( 10 ) << left << "" << right << "mean" << "p50"
+        << "p99" << "max" << qSetFieldWidth( 0 ) << endl;
+    report( out, "Draws", drawCalls );
+    report( out, "Triangles", triangles );
+    report( out, "State", stateCalls );
+    report( out, "Skipped", stateSkipped );
+
+    scene.teardownGL();
+
+    framebuffer.release();
+    context.doneCurrent();
+    return 0;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Stands in for the user, turning the camera a quarter degree a
+ *             frame so the planets sweep in and out of view, and swapping to
+ *             the scaled view for the second half of the run.
+ *
+ * @param      scene  The scene to control.
+ * @param[in]  frame  The frame being run.
+ */
+void Benchmark::cameraScript( Scene& scene, int frame )
+{
+    scene.camera().rotate( 0.25f, Camera3D::LocalUp );
+
+    if( frame == m_numFrames / 2 )
+        scene.swapScaledView();
+}
+
+/**
+ * @brief      Prints the mean, median, 99th percentile and worst of a series.
+ *
+ * @param      out     The stream to print to.
+ * @param[in]  name    The name of the series.
+ * @param[in]  values  The series.
+ */
+void Benchmark::report( QTextStream& out, const QString& name,
+    std::vector<double> values )
+{
+    out << qSetFieldWidth( 10 ) << left << name << right
+        << qSetRealNumberPrecision( 3 ) << fixed;
+
+    if( values.empty() )
+    {
+        out << "n/a" << qSetFieldWidth( 0 ) << endl;
+        return;
+    }
+
+    std::sort( values.begin(), values.end() );
+
+    double sum = 0.0;
+    for( double value : values )
+        sum += value;
+
+    const int n = values.size();
+    const int p50 = std::max( 0, (int)std::ceil( 0.50 * n ) - 1 );
+    const int p99 = std::max( 0, (int)std::ceil( 0.99 * n ) - 1 );
+
+    out << sum / n << values[p50] << values[p99] << values[n - 1]
+        << qSetFieldWidth( 0 ) << endl;
+}
@@ -44,6 +44,9 @@ private:
     QVector3D m_translation;
     QQuaternion m_rotation;
     QMatrix4x4 m_world;
+
+    // Set by every change, m_world is rebuilt on the next toMatrix
+    bool m_dirty;
 };
 
 #ifndef QT_DEBUG_TRANSFORM_STREAM
@@ -0,0 +1,95 @@
+#include "frustum.h"
+
+#include <QVector3D>
+
+#include <cmath>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Frustum.
+ *
+ * @param[in]  worldToClip  The projection times the camera's world to eye
+ *                          matrix.
+ */
+Frustum::Frustum( const QMatrix4x4& worldToClip )
+{
+    const QVector4D x = worldToClip.row( 0 );
+    const QVector4D y = worldToClip.row( 1 );
+    const QVector4D z = worldToClip.row( 2 );
+    const QVector4D w = worldToClip.row( 3 );
+
+    // Left, right, bottom, top, near and far
+    m_planes[0] = w + x;
+    m_planes[1] = w - x;
+    m_planes[2] = w + y;
+    m_planes[3] = w - y;
+    m_planes[4] = w + z;
+    m_planes[5] = w - z;
+
+    // Unit normals, so distances to the planes can be compared to a radius
+    for( int i = 0; i < NUM_PLANES; i++ )
+        m_planes[i] /= m_planes[i].toVector3D().length();
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Checks where a box is relative to the view volume. The sphere of
+ *             the box is tried first, which settles most boxes well away from
+ *             a plane; the box itself is only tested against the others.
+ * @details    A box crossing the edge of two planes outside the view may be
+ * kept as intersecting, but one never gets culled while in sight.
+ *
+ * @param[in]  bounds  The box, in world space.
+ *
+ * @return     Outside if it can not be seen, Inside if all of it is in view.
+ */
+Frustum::Result Frustum::classify( const Bounds& bounds ) const
+{
+    if( bounds.isEmpty() )
+        return Outside;
+
+    const QVector3D center = bounds.center();
+    const QVector3D extents = bounds.extents();
+    const float radius = extents.length();
+
+    Result result = Inside;
+    for( int i = 0; i < NUM_PLANES; i++ )
+    {
+        const QVector4D& plane = m_planes[i];
+        const float distance = QVector3D::dotProduct( plane.toVector3D(),
+            center ) + plane.w();
+        if( distance >= radius )
+            continue;
+        if( distance <= -radius )
+            return Outside;
+
+        // How far the box reaches towards the plane's normal
+        const float reach = std::abs( plane.x() ) * extents.x() +
+            std::abs( plane.y() ) * extents.y() +
+            std::abs( plane.z() ) * extents.z();
+        if( distance < -reach )
+            return Outside;
+        if( distance < reach )
+            result = Intersecting;
+    }
+
+    return result;
+}
+
+/**
+ * @brief      Checks if any of a box may be in view.
+ *
+ * @param[in]  bounds  The box, in world space.
+ *
+ * @return     True unless the box is outside the view volume.
+ */
+bool Frustum::intersects( const Bounds& bounds ) const
+{
+    return classify( bounds ) != Outside;
+}
@@ -0,0 +1,288 @@
+#include "glState.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for GLState. Nothing is known until first set.
+ */
+GLState::GLState()
+    :   m_known( 0 ), m_depthTest( false ), m_depthFunc( GL_LESS ),
+        m_depthMask( true ), m_cullEnabled( false ), m_cullMode( GL_BACK ),
+        m_lineWidth( 1.0f ), m_program( NULL ), m_vao( NULL ),
+        m_texture( NULL ), m_issued( 0 ), m_skipped( 0 ), m_drawCalls( 0 ),
+        m_triangles( 0 )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Initializes the GL functions the state is set with.
+ */
+void GLState::initializeGL()
+{
+    initializeOpenGLFunctions();
+}
+
+/**
+ * @brief      Forgets the whole copy, so the next setters all call GL. Needed
+ *             whenever GL was used without going through the tracker.
+ */
+void GLState::invalidate()
+{
+    m_known = 0;
+
+    // Bound objects may since have been deleted
+    m_program = NULL;
+    m_vao = NULL;
+    m_texture = NULL;
+}
+
+/**
+ * @brief      Enables or disables depth testing.
+ *
+ * @param[in]  enabled  Whether fragments are depth tested.
+ */
+void GLState::setDepthTest( bool enabled )
+{
+    if( !needsCall( DepthTest, m_depthTest == enabled ) )
+        return;
+
+    if( enabled )
+        glEnable( GL_DEPTH_TEST );
+    else
+        glDisable( GL_DEPTH_TEST );
+    m_depthTest = enabled;
+}
+
+/**
+ * @brief      Sets the depth comparison.
+ *
+ * @param[in]  func  The comparison, such as GL_LEQUAL.
+ */
+void GLState::setDepthFunc( GLenum func )
+{
+    if( !needsCall( DepthFunc, m_depthFunc == func ) )
+        return;
+
+    glDepthFunc( func );
+    m_depthFunc = func;
+}
+
+/**
+ * @brief      Enables or disables depth writes.
+ *
+ * @param[in]  enabled  Whether fragments write their depth.
+ */
+void GLState::setDepthMask( bool enabled )
+{
+    if( !needsCall( DepthMask, m_depthMask == enabled ) )
+        return;
+
+    glDepthMask( enabled ? GL_TRUE : GL_FALSE );
+    m_depthMask = enabled;
+}
+
+/**
+ * @brief      Sets which faces are culled.
+ *
+ * @param[in]  face  GL_BACK or GL_FRONT, or GL_NONE to draw both sides.
+ */
+void GLState::setCullFace( GLenum face )
+{
+    const bool enabled = face != GL_NONE;
+    if( needsCall( CullEnabled, m_cullEnabled == enabled ) )
+    {
+        if( enabled )
+            glEnable( GL_CULL_FACE );
+        else
+            glDisable( GL_CULL_FACE );
+        m_cullEnabled = enabled;
+    }
+
+    // The culled side is kept while culling is off
+    if( enabled && needsCall( CullMode, m_cullMode == face ) )
+    {
+        glCullFace( face );
+        m_cullMode = face;
+    }
+}
+
+/**
+ * @brief      Sets the width lines are rasterized with.
+ *
+ * @param[in]  width  The width in pixels.
+ */
+void GLState::setLineWidth( float width )
+{
+    if( !needsCall( LineWidth, m_lineWidth == width ) )
+        return;
+
+    glLineWidth( width );
+    m_lineWidth = width;
+}
+
+/**
+ * @brief      Binds a shader program.
+ *
+ * @param      program  The program, or NULL for none.
+ *
+ * @return     True if the program had to be bound.
+ */
+bool GLState::useProgram( QOpenGLShaderProgram* program )
+{
+    if( !needsCall( Program, m_program == program ) )
+        return false;
+
+    if( program != NULL )
+        program->bind();
+    else
+        glUseProgram( 0 );
+    m_program = program;
+    return true;
+}
+
+/**
+ * @brief      Binds a vertex array object.
+ *
+ * @param      vao   The VAO, or NULL for none.
+ *
+ * @return     True if the VAO had to be bound.
+ */
+bool GLState::bindVAO( QOpenGLVertexArrayObject* vao )
+{
+    if( !needsCall( VAO, m_vao == vao ) )
+        return false;
+
+    // A VAO is only released through itself, one bound by someone else stays
+    if( vao != NULL )
+        vao->bind();
+    else if( m_vao != NULL )
+        m_vao->release();
+    m_vao = vao;
+    return true;
+}
+
+/**
+ * @brief      Binds a 2D texture to the active unit.
+ *
+ * @param      texture  The texture, or NULL for none.
+ *
+ * @return     True if the texture had to be bound.
+ */
+bool GLState::bindTexture( QOpenGLTexture* texture )
+{
+    if( !needsCall( Texture, m_texture == texture ) )
+        return false;
+
+    if( texture != NULL )
+        texture->bind();
+    else
+        glBindTexture( GL_TEXTURE_2D, 0 );
+    m_texture = texture;
+    return true;
+}
+
+/**
+ * @brief      Unbinds the texture, VAO and program, in that order.
+ */
+void GLState::releaseAll()
+{
+    bindTexture( NULL );
+    bindVAO( NULL );
+    useProgram( NULL );
+}
+
+/**
+ * @brief      Counts a draw made with the tracked state.
+ *
+ * @param[in]  numTriangles  The number of triangles drawn.
+ */
+void GLState::countDrawCall( int numTriangles )
+{
+    m_drawCalls++;
+    m_triangles += numTriangles;
+}
+
+/**
+ * @brief      Gets the GL calls made since the counts were last reset.
+ *
+ * @return     The number of calls made.
+ */
+int GLState::issuedCalls() const
+{
+    return m_issued;
+}
+
+/**
+ * @brief      Gets the GL calls skipped since the counts were last reset, as
+ *             the state was already set. Adding them to the issued calls gives
+ *             the calls made without the tracker.
+ *
+ * @return     The number of calls skipped.
+ */
+int GLState::skippedCalls() const
+{
+    return m_skipped;
+}
+
+/**
+ * @brief      Gets the draws made since the counts were last reset.
+ *
+ * @return     The number of draws.
+ */
+int GLState::drawCalls() const
+{
+    return m_drawCalls;
+}
+
+/**
+ * @brief      Gets the triangles drawn since the counts were last reset.
+ *
+ * @return     The number of triangles.
+ */
+int GLState::triangles() const
+{
+    return m_triangles;
+}
+
+/**
+ * @brief      Starts counting the calls and draws anew.
+ */
+void GLState::resetCounts()
+{
+    m_issued = 0;
+    m_skipped = 0;
+    m_drawCalls = 0;
+    m_triangles = 0;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Checks if a field has to be set in GL, counting the call either
+ *             way. The field is known from then on.
+ *
+ * @param[in]  field  The field being set.
+ * @param[in]  same   Whether the copy already holds the new value.
+ *
+ * @return     True if GL has to be called.
+ */
+bool GLState::needsCall( Field field, bool same )
+{
+    if( same && ( m_known & field ) )
+    {
+        m_skipped++;
+        return false;
+    }
+
+    m_known |= field;
+    m_issued++;
+    return true;
+}
@@ -0,0 +1,83 @@
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QOpenGLVertexArrayObject>
+
+/**
+ * @brief      Shadow copy of the GL state the renderables draw with.
+ * @details    Every setter compares against what was last set and only calls
+ * GL when the state actually changes. Anything that touches GL behind the
+ * tracker's back, such as QPainter or a buffer upload, leaves the copy stale,
+ * so invalidate() has to be called before relying on it again. The calls made
+ * and skipped are counted, along with the draws the renderables report.
+ */
+class GLState   :   protected QOpenGLFunctions
+{
+public:
+    GLState();
+
+    void initializeGL();
+    void invalidate();
+
+    // Fixed function state
+    void setDepthTest( bool enabled );
+    void setDepthFunc( GLenum func );
+    void setDepthMask( bool enabled );
+    void setCullFace( GLenum face );
+    void setLineWidth( float width );
+
+    // Bindings, NULL unbinds; true if anything was bound
+    bool useProgram( QOpenGLShaderProgram* program );
+    bool bindVAO( QOpenGLVertexArrayObject* vao );
+    bool bindTexture( QOpenGLTexture* texture );
+    void releaseAll();
+
+    // Called by the renderables after each draw
+    void countDrawCall( int numTriangles );
+
+    // GL calls and draws since the counts were last reset
+    int issuedCalls() const;
+    int skippedCalls() const;
+    int drawCalls() const;
+    int triangles() const;
+    void resetCounts();
+
+private:
+    enum Field
+    {
+        DepthTest   = 1 << 0,
+        DepthFunc   = 1 << 1,
+        DepthMask   = 1 << 2,
+        CullEnabled = 1 << 3,
+        CullMode    = 1 << 4,
+        LineWidth   = 1 << 5,
+        Program     = 1 << 6,
+        VAO         = 1 << 7,
+        Texture     = 1 << 8
+    };
+
+    bool needsCall( Field field, bool same );
+
+    // Fields whose value below is known to match GL
+    unsigned int m_known;
+
+    bool m_depthTest;
+    GLenum m_depthFunc;
+    bool m_depthMask;
+    bool m_cullEnabled;
+    GLenum m_cullMode;
+    float m_lineWidth;
+    QOpenGLShaderProgram* m_program;
+    QOpenGLVertexArrayObject* m_vao;
+    QOpenGLTexture* m_texture;
+
+    int m_issued;
+    int m_skipped;
+    int m_drawCalls;
+    int m_triangles;
+};
+
+#endif  //  GL_STATE_H
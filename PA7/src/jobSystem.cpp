@@ -0,0 +1,483 @@
+#include "jobSystem.h"
+
+#include <QMutexLocker>
+#include <QtGlobal>
+
+namespace
+{
+    // Job system and deque of the current thread, workers set their own
+    thread_local const JobSystem* t_jobs = NULL;
+    thread_local int t_slot = 0;
+}
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the job system shared by the whole program, with a thread
+ *             for every core and at least one worker.
+ *
+ * @return     The job system.
+ */
+JobSystem& JobSystem::instance()
+{
+    static JobSystem jobs( QThread::idealThreadCount() );
+    return jobs;
+}
+
+/**
+ * @brief      Constructor for JobSystem. Starts the workers, all of them
+ *             active.
+ *
+ * @param[in]  maxThreads  The most threads to run jobs on, the waiting thread
+ *                         included. Raised to MIN_THREADS.
+ */
+JobSystem::JobSystem( int maxThreads )
+    :   m_queued( 0 ), m_stop( false )
+{
+    maxThreads = qBound( int( MIN_THREADS ), maxThreads, int( MAX_THREADS ) );
+    m_numThreads.store( maxThreads );
+
+    for( int slot = 0; slot < maxThreads; slot++ )
+        m_deques.push_back( new Deque() );
+
+    for( int slot = 1; slot < maxThreads; slot++ )
+    {
+        m_workers.push_back( new Worker( this, slot ) );
+        m_workers.back()->start();
+    }
+}
+
+/**
+ * @brief      Destructor for JobSystem. Stops the workers, jobs not started
+ *             yet are dropped.
+ */
+JobSystem::~JobSystem()
+{
+    m_stop.store( true );
+    m_sleepMutex.lock();
+    m_wake.wakeAll();
+    m_sleepMutex.unlock();
+
+    for( size_t i = 0; i < m_workers.size(); i++ )
+    {
+        m_workers[i]->wait();
+        delete m_workers[i];
+    }
+
+    for( size_t i = 0; i < m_deques.size(); i++ )
+        delete m_deques[i];
+}
+
+/**
+ * @brief      Constructor for Job. The job waits to be submitted.
+ *
+ * @param[in]  function   The function to run on each range.
+ * @param[in]  begin      The first index of the job.
+ * @param[in]  end        One past the last index of the job.
+ * @param[in]  grainSize  About how many indices to run at once.
+ */
+JobSystem::Job::Job( const RangeFunction& function, int begin, int end,
+    int grainSize )
+    :   m_function( function ), m_begin( begin ), m_end( end ),
+        m_grainSize( qMax( 1, grainSize ) ), m_blockers( 1 ),
+        m_remaining( 0 ), m_done( false )
+{
+}
+
+/**
+ * @brief      Constructor for Worker.
+ *
+ * @param      jobs   The job system the worker takes tasks from.
+ * @param[in]  slot   The deque of the worker.
+ */
+JobSystem::Worker::Worker( JobSystem* jobs, int slot )
+    :   m_jobs( jobs ), m_slot( slot )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the most threads jobs can run on.
+ *
+ * @return     The number of workers and the waiting thread.
+ */
+int JobSystem::maxThreads() const
+{
+    return m_deques.size();
+}
+
+/**
+ * @brief      Gets how many threads jobs run on.
+ *
+ * @return     The number of active workers and the waiting thread.
+ */
+int JobSystem::numThreads() const
+{
+    return m_numThreads.load();
+}
+
+/**
+ * @brief      Sets how many threads jobs run on, the rest of the workers
+ *             sleep. Not while a job runs.
+ *
+ * @param[in]  numThreads  The number of threads, clamped to what there is
+ *                         and to at least MIN_THREADS.
+ */
+void JobSystem::setNumThreads( int numThreads )
+{
+    m_numThreads.store( qBound( int( MIN_THREADS ), numThreads,
+        maxThreads() ) );
+}
+
+/**
+ * @brief      Creates a job running a function once.
+ *
+ * @param[in]  function  The function.
+ *
+ * @return     The job, to add dependencies to and submit.
+ */
+JobSystem::Handle JobSystem::create( const std::function<void()>& function )
+{
+    return Handle( new Job( [function]( int, int ){ function(); }, 0, 1, 1 ) );
+}
+
+/**
+ * @brief      Creates a job running a loop across the active threads.
+ *
+ * @param[in]  begin      The first index of the loop.
+ * @param[in]  end        One past the last index of the loop.
+ * @param[in]  grainSize  About how many indices to run at once.
+ * @param[in]  function   The body of the loop, run on each range.
+ *
+ * @return     The job, to add dependencies to and submit.
+ */
+JobSystem::Handle JobSystem::createFor( int begin, int end, int grainSize,
+    const RangeFunction& function )
+{
+    return Handle( new Job( function, begin, end, grainSize ) );
+}
+
+/**
+ * @brief      Makes a job wait for another one. Both have to be created by
+ *             this job system, and the job not submitted yet.
+ *
+ * @param[in]  job         The job to hold back.
+ * @param[in]  dependency  The job to wait for, which may be done already.
+ */
+void JobSystem::addDependency( const Handle& job, const Handle& dependency )
+{
+    QMutexLocker locker( &dependency->m_mutex );
+    if( dependency->m_done.load() )
+        return;
+
+    job->m_blockers.fetch_add( 1 );
+    dependency->m_dependents.push_back( job );
+}
+
+/**
+ * @brief      Submits a job, which starts once all of its dependencies are
+ *             done.
+ *
+ * @param[in]  job   The job.
+ */
+void JobSystem::submit( const Handle& job )
+{
+    if( job->m_blockers.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+        schedule( job );
+}
+
+/**
+ * @brief      Runs tasks until a submitted job is done. A worker may run tasks
+ *             of any job meanwhile, which only helps them along; a thread
+ *             outside the pool only runs tasks of this job.
+ *
+ * @param[in]  job   The job.
+ */
+void JobSystem::wait( const Handle& job )
+{
+    const int slot = currentSlot();
+    while( !job->isDone() )
+    {
+        Task task;
+        const bool found = slot == 0 ? take( job, task ) :
+            pop( slot, task ) || steal( slot, task );
+
+        if( found )
+            execute( task );
+        else
+            QThread::yieldCurrentThread();
+    }
+}
+
+/**
+ * @brief      Runs a function once on the pool, in the background.
+ *
+ * @param[in]  function  The function.
+ *
+ * @return     The job, to wait on.
+ */
+JobSystem::Handle JobSystem::run( const std::function<void()>& function )
+{
+    Handle job = create( function );
+    submit( job );
+    return job;
+}
+
+/**
+ * @brief      Runs a loop across the active threads and returns once all of
+ *             it is done. Loops of a single range run on the calling thread
+ *             right away.
+ *
+ * @param[in]  begin      The first index of the loop.
+ * @param[in]  end        One past the last index of the loop.
+ * @param[in]  grainSize  About how many indices to run at once.
+ * @param[in]  function   The body of the loop, run on each range.
+ */
+void JobSystem::parallelFor( int begin, int end, int grainSize,
+    const RangeFunction& function )
+{
+    if( end <= begin )
+        return;
+
+    if( end - begin <= grainSize )
+    {
+        function( begin, end );
+        return;
+    }
+
+    Handle job = createFor( begin, end, grainSize, function );
+    submit( job );
+    wait( job );
+}
+
+/**
+ * @brief      Checks whether the job and every task of it are done.
+ *
+ * @return     True once done.
+ */
+bool JobSystem::Job::isDone() const
+{
+    return m_done.load( std::memory_order_acquire );
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Deals a job with no dependencies left out as tasks, and wakes
+ *             the workers.
+ *
+ * @param[in]  job   The job.
+ */
+void JobSystem::schedule( const Handle& job )
+{
+    if( job->m_end <= job->m_begin )
+    {
+        finish( job );
+        return;
+    }
+
+    const int numThreads = m_numThreads.load();
+    const int slot = currentSlot();
+    const int grainSize = job->m_grainSize;
+    const int numTasks = ( job->m_end - job->m_begin + grainSize - 1 ) /
+        grainSize;
+    job->m_remaining.store( numTasks );
+
+    // Starting at the current thread's own deque, so it has work right away
+    for( int i = 0; i < numTasks; i++ )
+    {
+        Task task;
+        task.Owner = job;
+        task.Begin = job->m_begin + i * grainSize;
+        task.End = qMin( job->m_end, task.Begin + grainSize );
+
+        Deque* deque = m_deques[( slot + i ) % numThreads];
+        QMutexLocker locker( &deque->Mutex );
+        deque->Tasks.push_back( task );
+    }
+
+    m_queued.fetch_add( numTasks );
+    m_sleepMutex.lock();
+    m_wake.wakeAll();
+    m_sleepMutex.unlock();
+}
+
+/**
+ * @brief      Marks a job done, and schedules the jobs it was the last
+ *             dependency of.
+ *
+ * @param[in]  job   The job.
+ */
+void JobSystem::finish( const Handle& job )
+{
+    std::vector<Handle> dependents;
+    {
+        QMutexLocker locker( &job->m_mutex );
+        job->m_done.store( true, std::memory_order_release );
+        dependents.swap( job->m_dependents );
+    }
+
+    for( size_t i = 0; i < dependents.size(); i++ )
+        submit( dependents[i] );
+}
+
+/**
+ * @brief      Runs tasks until the job system is destroyed, sleeping whenever
+ *             there are none for a while or the worker is not active.
+ *
+ * @param[in]  slot  The deque of the worker.
+ */
+void JobSystem::work( int slot )
+{
+    t_jobs = this;
+    t_slot = slot;
+
+    int idle = 0;
+    while( !m_stop.load() )
+    {
+        Task task;
+        if( slot < m_numThreads.load() &&
+            ( pop( slot, task ) || steal( slot, task ) ) )
+        {
+            execute( task );
+            idle = 0;
+            continue;
+        }
+
+        if( ++idle < SPIN_COUNT )
+        {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+
+        // Checked under the lock the jobs wake through, so no wake is missed
+        QMutexLocker locker( &m_sleepMutex );
+        while( !m_stop.load() &&
+            ( m_queued.load() == 0 || slot >= m_numThreads.load() ) )
+            m_wake.wait( &m_sleepMutex );
+        idle = 0;
+    }
+}
+
+/**
+ * @brief      Gets the deque of the current thread.
+ *
+ * @return     The worker's own deque, or 0, shared by every thread outside
+ *             this job system's pool.
+ */
+int JobSystem::currentSlot() const
+{
+    return t_jobs == this ? t_slot : 0;
+}
+
+/**
+ * @brief      Takes the newest task of a thread's own deque.
+ *
+ * @param[in]  slot  The deque of the thread.
+ * @param[out] task  The task.
+ *
+ * @return     False if the deque was empty.
+ */
+bool JobSystem::pop( int slot, Task& task )
+{
+    Deque* deque = m_deques[slot];
+    QMutexLocker locker( &deque->Mutex );
+    if( deque->Tasks.empty() )
+        return false;
+
+    task = deque->Tasks.back();
+    deque->Tasks.pop_back();
+    m_queued.fetch_sub( 1 );
+    return true;
+}
+
+/**
+ * @brief      Takes the oldest task of the first other deque that has one.
+ *
+ * @param[in]  slot  The deque of the thread stealing.
+ * @param[out] task  The task.
+ *
+ * @return     False if every other deque was empty.
+ */
+bool JobSystem::steal( int slot, Task& task )
+{
+    const int numDeques = m_deques.size();
+    for( int i = 1; i < numDeques; i++ )
+    {
+        Deque* deque = m_deques[( slot + i ) % numDeques];
+        QMutexLocker locker( &deque->Mutex );
+        if( deque->Tasks.empty() )
+            continue;
+
+        task = deque->Tasks.front();
+        deque->Tasks.pop_front();
+        m_queued.fetch_sub( 1 );
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief      Takes the oldest task of a job from the first deque that has
+ *             one, for a thread outside the pool waiting on the job.
+ *
+ * @param[in]  job   The job.
+ * @param[out] task  The task.
+ *
+ * @return     False if none of the job's tasks are queued.
+ */
+bool JobSystem::take( const Handle& job, Task& task )
+{
+    for( size_t i = 0; i < m_deques.size(); i++ )
+    {
+        Deque* deque = m_deques[i];
+        QMutexLocker locker( &deque->Mutex );
+        for( std::deque<Task>::iterator it = deque->Tasks.begin();
+            it != deque->Tasks.end(); ++it )
+        {
+            if( it->Owner != job )
+                continue;
+
+            task = *it;
+            deque->Tasks.erase( it );
+            m_queued.fetch_sub( 1 );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief      Runs a task, and finishes its job if it was the last one.
+ *
+ * @param[in]  task  The task.
+ */
+void JobSystem::execute( const Task& task )
+{
+    Job* job = task.Owner.data();
+    job->m_function( task.Begin, task.End );
+
+    if( job->m_remaining.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+        finish( task.Owner );
+}
+
+//
+// WORKER //////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Works on the job system's tasks until it is destroyed.
+ */
+void JobSystem::Worker::run()
+{
+    m_jobs->work( m_slot );
+}
@@ -11,11 +11,12 @@ ModelLoader::ModelLoader()
  * @param[in]   filePath      The full path to the model source.
  * @param[out]  geometry      The geometry data of the model loaded.
  * @param[out]  numVertices   The number of vertices within the model.
+ * @param[out]  bounds        The bounds of the model, unless NULL.
  *
  * @return     True of the model loaded successfully, false otherwise.
  */
 bool ModelLoader::loadModel( QString filePath, Vertex*& geometry, 
-    int& numVertices )
+    int& numVertices, Bounds* bounds )
 {
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile( filePath.toStdString(), 
@@ -57,6 +58,13 @@ bool ModelLoader::loadModel( QString filePath, Vertex*& geometry,
 
     geo -= mesh->mNumFaces * 3;
 
+    if( bounds != NULL )
+    {
+        *bounds = Bounds();
+        for( int i = 0; i < numVertices; i++ )
+            bounds->expand( geo[i].position() );
+    }
+
     geometry = geo;
     return true;
 }
\ No newline at end of file
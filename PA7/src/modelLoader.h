@@ -4,6 +4,7 @@
 #include <QString>
 #include <QDebug>
 
+#include "bounds.h"
 #include "vertex.h"
 
 #include <assimp/Importer.hpp>
@@ -16,8 +17,8 @@ protected:
     ModelLoader();
 
 public:
-    bool loadModel( QString filePath, Vertex*& geometry, 
-        int& numVertices );
+    static bool loadModel( QString filePath, Vertex*& geometry, 
+        int& numVertices, Bounds* bounds = NULL );
 };
 
 #endif  //  MODEL_LOADER_H
\ No newline at end of file
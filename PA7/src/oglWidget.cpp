@@ -15,17 +15,6 @@ OGLWidget::OGLWidget()
 
     // Allows keyboard input to fall through
     setFocusPolicy( Qt::ClickFocus );
-
-    // Setup the Camera
-    camera.rotate( -40.0f, 1.0f, 0.0f, 0.0f );
-    camera.translate( 0.0f, 30.0f, 45.0f );
-
-    renderables.push_back( new Sun() );
-    renderables.push_back( new Skybox() );
-
-    // update the solar system once in the beginning
-    // this is so all the planets aren't stacked on top of each other
-    renderables[0]->update();
 }
 
 /**
@@ -46,12 +35,7 @@ void OGLWidget::initializeGL()
     // Init OpenGL Backend
     initializeOpenGLFunctions();
     printContextInfo();
-
-    QVectorIterator<Renderable*> i_renderable( renderables );
-    while( i_renderable.hasNext() )
-    {
-        ( i_renderable.next() )->initializeGL();
-    }
+    scene.initializeGL();
 }
 
 /**
@@ -62,11 +46,7 @@ void OGLWidget::initializeGL()
  */
 void OGLWidget::resizeGL( int width, int height )
 {
-    projection.setToIdentity();
-    projection.perspective( 55.0f,  // Field of view angle
-                            float( width ) / float( height ),   // Aspect Ratio
-                            0.01f,  // Near Plane (MUST BE GREATER THAN 0)
-                            1000.0f );  // Far Plane
+    scene.resizeGL( width, height );
 }
 
 /**
@@ -74,20 +54,7 @@ void OGLWidget::resizeGL( int width, int height )
  */
 void OGLWidget::paintGL()
 {
-    glEnable( GL_DEPTH_TEST );
-    glDepthFunc( GL_LEQUAL );
-    glDepthMask( GL_TRUE );
-    glEnable( GL_CULL_FACE );
-    glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
-
-    // Clear the screen
-    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
-
-    QVectorIterator<Renderable*> i_renderable( renderables );
-    while( i_renderable.hasNext() )
-    {
-        ( i_renderable.next() )->paintGL( camera, projection );
-    }
+    scene.paintGL();
 }
 
 /**
@@ -95,11 +62,7 @@ void OGLWidget::paintGL()
  */
 void OGLWidget::teardownGL()
 {
-    QVectorIterator<Renderable*> i_renderable( renderables );
-    while( i_renderable.hasNext() )
-    {
-        ( i_renderable.next() )->teardownGL();
-    }
+    scene.teardownGL();
 }
 
 //
@@ -119,6 +82,8 @@ void OGLWidget::update()
         static const float cameraTranslationSpeed = 0.3f;
         static const float cameraRotationSpeed = 0.1f;
 
+        Camera3D& camera = scene.camera();
+
         camera.rotate( -cameraRotationSpeed * Input::mouseDelta().x(), 
             Camera3D::LocalUp );
         camera.rotate( -cameraRotationSpeed * Input::mouseDelta().y(),
@@ -140,13 +105,7 @@ void OGLWidget::update()
         camera.translate( cameraTranslationSpeed * cameraTranslations );
     }
 
-    if( !paused )
-    {
-        for( auto renderable : renderables )
-        {
-            renderable->update();
-        }
-    }  
+    scene.update();
 
     QOpenGLWidget::update();
 }
@@ -156,18 +115,15 @@ void OGLWidget::update()
 */
 void OGLWidget::swapPause()
 {
-    paused = !paused;
+    scene.setPaused( !scene.isPaused() );
 }
 
+/**
+* @brief      Slot for swapping between the realistic and scaled views.
+*/
 void OGLWidget::swapScaledView()
 {
-    Planet::SCALED = !Planet::SCALED;
-
-    // want to see the scale change even if paused
-    if(paused)
-    {
-        renderables[0]->update();
-    }
+    scene.swapScaledView();
 }
 
 //
@@ -17,10 +17,7 @@
 #include <QString>
 
 #include "input.h"
-#include "camera3d.h"
-#include "renderable.h"
-#include "Planets/sun.h"
-#include "skybox.h"
+#include "scene.h"
 
 class OGLWidget    :    public QOpenGLWidget,
                         protected QOpenGLFunctions
@@ -51,14 +48,8 @@ protected:
 private:
     void printContextInfo();
 
-    // 3D Information
-    QVector<Renderable*> renderables;
-
-    QMatrix4x4 projection;
-    Camera3D camera;
-
-    // Control
-    bool paused = true;
+    // The solar system, shared with the benchmark
+    Scene scene;
 };
 
 #endif  //  OGL_WIDGET_H
\ No newline at end of file
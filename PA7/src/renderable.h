@@ -4,12 +4,14 @@
 #include <QOpenGLFunctions>
 #include <QMatrix4x4>
 #include "camera3d.h"
+#include "glState.h"
 
 class Renderable    :   protected QOpenGLFunctions
 {
 public:
     virtual void initializeGL() = 0;
-    virtual void paintGL( Camera3D& camera, QMatrix4x4& projection ) = 0;
+    virtual void paintGL( Camera3D& camera, QMatrix4x4& projection,
+        GLState& state ) = 0;
     virtual void update() = 0;
     virtual void teardownGL() = 0;
 };
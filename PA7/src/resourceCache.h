@@ -0,0 +1,50 @@
+#ifndef RESOURCE_CACHE_H
+#define RESOURCE_CACHE_H
+
+#include <QOpenGLBuffer>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+
+#include <QSharedPointer>
+#include <QString>
+
+#include "bounds.h"
+#include "textureCache.h"
+#include "vertex.h"
+
+/**
+ * @brief      Process wide cache of models, textures and shader programs.
+ * @details    Resources are keyed by their source paths and handed out as
+ * reference counted handles. The cache itself only holds weak references, so
+ * a resource is destroyed as soon as the last planet using it releases its
+ * handle. GL resources must therefore be released with the context current,
+ * which every teardownGL already guarantees.
+ *
+ * The CPU side functions are thread safe; the GPU side ones must run on the
+ * GUI thread.
+ */
+namespace ResourceCache
+{
+    struct Model
+    {
+        Model();
+        ~Model();
+        Q_DISABLE_COPY( Model )
+
+        Vertex* Vertices;
+        int NumVertices;
+        Bounds Box;
+    };
+
+    // CPU side data, safe to call from any thread
+    QSharedPointer<Model> model( const QString& modelPath );
+    QSharedPointer<TextureCache::MipChain> mipChain( const QString& imagePath );
+
+    // GPU side data, requires a current context
+    QSharedPointer<QOpenGLBuffer> vertexBuffer( const QString& modelPath );
+    QSharedPointer<QOpenGLTexture> texture( const QString& imagePath );
+    QSharedPointer<QOpenGLShaderProgram> program( const QString& vertexPath,
+        const QString& fragmentPath );
+};
+
+#endif  //  RESOURCE_CACHE_H
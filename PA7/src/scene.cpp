@@ -0,0 +1,163 @@
+#include "scene.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Scene. Starts paused, with the camera above the
+ *             sun.
+ */
+Scene::Scene()
+    :   m_paused( true )
+{
+    // Setup the Camera
+    m_camera.rotate( -40.0f, 1.0f, 0.0f, 0.0f );
+    m_camera.translate( 0.0f, 30.0f, 45.0f );
+
+    m_renderables.push_back( new Sun() );
+    m_renderables.push_back( new Skybox() );
+
+    // update the solar system once in the beginning
+    // this is so all the planets aren't stacked on top of each other
+    m_renderables[0]->update();
+}
+
+//
+// OPENGL FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Initializes the renderables. Requires a current context.
+ */
+void Scene::initializeGL()
+{
+    initializeOpenGLFunctions();
+    m_glState.initializeGL();
+
+    for( auto renderable : m_renderables )
+    {
+        renderable->initializeGL();
+    }
+}
+
+/**
+ * @brief      Sets the prespective whenever the surface is resized.
+ *
+ * @param[in]  width   The width of the new surface.
+ * @param[in]  height  The height of the new surface.
+ */
+void Scene::resizeGL( int width, int height )
+{
+    m_projection.setToIdentity();
+    m_projection.perspective( 55.0f,  // Field of view angle
+        float( width ) / float( height ),   // Aspect Ratio
+        0.01f,  // Near Plane (MUST BE GREATER THAN 0)
+        1000.0f );  // Far Plane
+}
+
+/**
+ * @brief      Draws the scene to the bound framebuffer. The renderables set
+ *             their state through glState, which starts each frame knowing
+ *             nothing, as Qt uses the context between frames.
+ */
+void Scene::paintGL()
+{
+    m_glState.invalidate();
+    m_glState.setDepthMask( true );
+    glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
+
+    // Clear the screen
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+    for( auto renderable : m_renderables )
+    {
+        renderable->paintGL( m_camera, m_projection, m_glState );
+    }
+
+    m_glState.releaseAll();
+}
+
+/**
+ * @brief      Destroys any OpenGL data.
+ */
+void Scene::teardownGL()
+{
+    for( auto renderable : m_renderables )
+    {
+        renderable->teardownGL();
+    }
+}
+
+//
+// SIMULATION FUNCTIONS ////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Moves the planets one step along their orbits, unless paused.
+ */
+void Scene::update()
+{
+    if( m_paused )
+        return;
+
+    for( auto renderable : m_renderables )
+    {
+        renderable->update();
+    }
+}
+
+/**
+ * @brief      Pauses or resumes the orbits.
+ *
+ * @param[in]  paused  Whether to pause.
+ */
+void Scene::setPaused( bool paused )
+{
+    m_paused = paused;
+}
+
+/**
+ * @brief      Checks whether the orbits are paused.
+ *
+ * @return     True if paused.
+ */
+bool Scene::isPaused() const
+{
+    return m_paused;
+}
+
+/**
+ * @brief      Swaps between the realistic and the scaled sizes and distances.
+ */
+void Scene::swapScaledView()
+{
+    Planet::SCALED = !Planet::SCALED;
+
+    // want to see the scale change even if paused
+    if( m_paused )
+    {
+        m_renderables[0]->update();
+    }
+}
+
+/**
+ * @brief      Gets the camera the scene is drawn from.
+ *
+ * @return     The camera.
+ */
+Camera3D& Scene::camera()
+{
+    return m_camera;
+}
+
+/**
+ * @brief      Gets the state tracker the renderables draw with, and its
+ *             counts of the calls and draws.
+ *
+ * @return     The state tracker.
+ */
+GLState& Scene::glState()
+{
+    return m_glState;
+}
@@ -0,0 +1,52 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <QOpenGLFunctions>
+#include <QVector>
+#include <QMatrix4x4>
+
+#include "camera3d.h"
+#include "renderable.h"
+#include "glState.h"
+#include "Planets/sun.h"
+#include "skybox.h"
+
+/**
+ * @brief      The solar system and the camera looking at it, without the
+ *             window, so it can be driven by the widget or by the benchmark.
+ */
+class Scene :   protected QOpenGLFunctions
+{
+public:
+    Scene();
+
+    // OpenGL Functions
+    void initializeGL();
+    void resizeGL( int width, int height );
+    void paintGL();
+    void teardownGL();
+
+    // Simulation Functions
+    void update();
+    void setPaused( bool paused );
+    bool isPaused() const;
+    void swapScaledView();
+
+    Camera3D& camera();
+    GLState& glState();
+
+private:
+    // 3D Information
+    QVector<Renderable*> m_renderables;
+
+    QMatrix4x4 m_projection;
+    Camera3D m_camera;
+
+    // Skips the state the renderables set again and again
+    GLState m_glState;
+
+    // Control
+    bool m_paused;
+};
+
+#endif  //  SCENE_H
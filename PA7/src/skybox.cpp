@@ -6,8 +6,9 @@
 
 
 Skybox::Skybox()
+    :   vao( NULL ), modelClip( -1 )
 {
-    loadModel( MODEL_PATH, model, numVertices );
+    model = ResourceCache::model( MODEL_PATH );
     transform.setScale( 500.0f );
 }
 
@@ -27,34 +28,18 @@ Skybox::~Skybox()
 void Skybox::initializeGL()
 {
     initializeOpenGLFunctions();
-    // Create the shader this planet will be using
-    program = new QOpenGLShaderProgram();
-    program->addShaderFromSourceFile( QOpenGLShader::Vertex, 
-        V_SHADER_PATH );
-    program->addShaderFromSourceFile( QOpenGLShader::Fragment, 
-        F_SHADER_PATH );
-    program->link();
-    program->bind();
-        
+
+    // Same program as the planets
+    program = ResourceCache::program( V_SHADER_PATH, F_SHADER_PATH );
+    texture = ResourceCache::texture( TEXTURE_PATH );
+    vbo = ResourceCache::vertexBuffer( MODEL_PATH );
+
     // Cache the Uniform Locations
-    modelWorld = program->uniformLocation( "model_to_world" );
-    worldEye = program->uniformLocation( "world_to_eye" );
-    eyeClip = program->uniformLocation( "eye_to_clip" );
-
-    // Create Texture Buffer Object
-    texture = new QOpenGLTexture( QImage( TEXTURE_PATH ).mirrored() );
-    
-    texture->setMinificationFilter( QOpenGLTexture::LinearMipMapLinear );
-    texture->setMagnificationFilter( QOpenGLTexture::Linear );
-
-    // Create the Vertex Buffer Object only if it's not already created
-    vbo = new QOpenGLBuffer();
-    vbo->create();
-    vbo->bind();
-    vbo->setUsagePattern( QOpenGLBuffer::StaticDraw );
-    vbo->allocate( model, numVertices * sizeof( model[0] ) );
+    modelClip = program->uniformLocation( "model_to_clip" );
 
-    // Create the Vertex Array Object only if it's not already created
+    // Create the Vertex Array Object
+    program->bind();
+    vbo->bind();
     vao = new QOpenGLVertexArrayObject();
     vao->create();
     vao->bind();
@@ -74,32 +59,26 @@ void Skybox::initializeGL()
     // Release all in order
     vao->release();
     vbo->release();
-    texture->release();
     program->release();
 }
 
-void Skybox::paintGL( Camera3D& camera, QMatrix4x4& projection )
+void Skybox::paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state )
 {
-    glEnable( GL_DEPTH_TEST );
-    glDepthFunc( GL_LEQUAL );
-    glDepthMask( GL_TRUE );
-    glDisable( GL_CULL_FACE );
-
-    program->bind();
-
-    program->setUniformValue( worldEye, camera.toMatrix() );
-    program->setUniformValue( eyeClip, projection );
+    const QMatrix4x4 worldToClip = projection * camera.toMatrix();
 
-    vao->bind();
-    texture->bind();
+    state.setDepthTest( true );
+    state.setDepthFunc( GL_LEQUAL );
+    state.setDepthMask( true );
+    state.setCullFace( GL_NONE );
 
-    program->setUniformValue( modelWorld, transform.toMatrix() );
+    state.useProgram( program.data() );
+    state.bindVAO( vao );
+    state.bindTexture( texture.data() );
 
-    glDrawArrays( GL_TRIANGLES, 0, numVertices );
+    program->setUniformValue( modelClip, worldToClip * transform.toMatrix() );
 
-    texture->release();
-    vao->release();
-    program->release();
+    glDrawArrays( GL_TRIANGLES, 0, model->NumVertices );
+    state.countDrawCall( model->NumVertices / 3 );
 }
 
 void Skybox::update()
@@ -108,9 +87,10 @@ void Skybox::update()
 
 void Skybox::teardownGL()
 {
-    delete vbo;
-    delete vao;;
-    delete program;
-    delete model;
-    delete texture;
-}
\ No newline at end of file
+    delete vao;
+    vao = NULL;
+
+    texture.clear();
+    vbo.clear();
+    program.clear();
+}
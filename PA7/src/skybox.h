@@ -6,50 +6,47 @@
 #include <QOpenGLVertexArrayObject>
 #include <QOpenGLTexture>
 #include <QOpenGLShaderProgram>
+#include <QSharedPointer>
 #include <QDebug>
 
 #include "renderable.h"
-#include "modelLoader.h"
+#include "resourceCache.h"
 #include "transform3d.h"
 #include "camera3d.h"
 #include "vertex.h"
 
 class QOpenGLShaderProgram;
 
-class Skybox    :   public Renderable,
-                    protected ModelLoader
+class Skybox    :   public Renderable
 {
 public:
     Skybox();
     ~Skybox();
 
     void initializeGL();
-    void paintGL( Camera3D& camera, QMatrix4x4& projection );
+    void paintGL( Camera3D& camera, QMatrix4x4& projection, GLState& state );
     void update();
     void teardownGL();
 private:
     Transform3D transform;
     
-    // OpenGL State Information
-    QOpenGLBuffer* vbo;
+    // OpenGL State Information, shared through the ResourceCache
+    QSharedPointer<QOpenGLBuffer> vbo;
     QOpenGLVertexArrayObject* vao;
-    QOpenGLShaderProgram* program;
+    QSharedPointer<QOpenGLShaderProgram> program;
 
     // Model Information
     const QString MODEL_PATH = "models/skybox.obj";
-    Vertex* model;
-    int numVertices;
+    QSharedPointer<ResourceCache::Model> model;
 
     // Texture Information
     const QString TEXTURE_PATH = ":/texture/skybox.jpg";
-    QOpenGLTexture* texture;
+    QSharedPointer<QOpenGLTexture> texture;
 
     // Shader Information
     const QString V_SHADER_PATH = ":/shader/simple.vs";
     const QString F_SHADER_PATH = ":/shader/simple.fs";
-    int modelWorld;
-    int worldEye;
-    int eyeClip;
+    int modelClip;
 };
 
 #endif  //  SKYBOX_H
\ No newline at end of file
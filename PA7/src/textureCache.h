@@ -0,0 +1,67 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+
+#include <vector>
+
+/**
+ * @brief      Binary cache of textures ready to be uploaded to the GPU.
+ * @details    Each image gets a "<image>.tex" file holding a small header
+ * followed by a full mip chain that is already flipped for OpenGL. The chain
+ * is stored either as raw RGBA or DXT1 compressed; opaque images default to
+ * DXT1, which is an eighth of the size on disk and on the GPU. Contexts
+ * without S3TC support get an RGBA chain built from the source image instead,
+ * so they do not inherit the compression artifacts, cached once in a
+ * "<image>.rgba.tex". A stale or foreign cache is simply ignored.
+ *
+ * The solar system's images are compiled in as resources, which cannot be
+ * written to, so their caches live under the user's cache directory instead
+ * of next to them. The header records the size and time of the resource, so
+ * a rebuilt binary with new textures rebuilds its caches.
+ */
+namespace TextureCache
+{
+    const quint32 VERSION = 1;
+
+    enum Format
+    {
+        RGBA8,
+        DXT1
+    };
+
+    // The usual cache picks its format by the image, the uncompressed one is
+    // kept next to it for contexts without S3TC
+    enum Variant
+    {
+        Preferred,
+        Uncompressed
+    };
+
+    struct MipLevel
+    {
+        int Width;
+        int Height;
+        QByteArray Data;
+    };
+
+    struct MipChain
+    {
+        Format PixelFormat;
+        std::vector<MipLevel> Levels;
+    };
+
+    QString cachePath( QString sourcePath, Variant variant = Preferred );
+
+    bool load( QString sourcePath, MipChain& chain,
+        Variant variant = Preferred );
+    bool save( QString sourcePath, const MipChain& chain,
+        Variant variant = Preferred );
+
+    bool build( const QImage& image, Format format, MipChain& chain );
+    void decompress( const MipChain& chain, MipChain& rgba );
+};
+
+#endif  //  TEXTURE_CACHE_H
@@ -33,6 +33,7 @@ HEADERS += \
     ../src/3D/transform3d.h \
     ../src/3D/vertex.h \
     #Controls
+    ../src/Controls/benchmark.h \
     ../src/Controls/camera3d.h \
     ../src/Controls/input.h \
     #Entity
@@ -41,6 +42,7 @@ HEADERS += \
     ../src/Entity/board.h \
     ../src/Entity/cube.h \
     ../src/Entity/cylindar.h \
+    ../src/Entity/scene.h \
     ../src/Entity/sphere.h \
     #UI
     ../src/UI/mainWindow.h \
@@ -53,6 +55,7 @@ SOURCES += \
     ../src/3D/transform3d.cpp \
     ../src/3D/vertex.cpp \
     #Controls
+    ../src/Controls/benchmark.cpp \
     ../src/Controls/camera3d.cpp \
     ../src/Controls/input.cpp \
     #Entity
@@ -61,6 +64,7 @@ SOURCES += \
     ../src/Entity/board.cpp \
     ../src/Entity/cube.cpp \
     ../src/Entity/cylindar.cpp \
+    ../src/Entity/scene.cpp \
     ../src/Entity/sphere.cpp \
     #UI
     ../src/UI/mainWindow.cpp \
@@ -2,18 +2,23 @@
 
 /**
  * @brief       Loads a model based on a file path.
+ * @details     When a collision mesh is asked for, it is filled from the same
+ * import. Assimp has already joined the identical vertices, so the mesh gets
+ * each of them once and its triangles index into them, rather than a copy of
+ * every corner.
  *
- * @param[in]   filePath      The full path to the model source.
- * @param[out]  geometry      The geometry data of the model loaded.
- * @param[out]  numVertices   The number of vertices within the model.
+ * @param[in]   filePath       The full path to the model source.
+ * @param[out]  geometry       The geometry data of the model loaded.
+ * @param[out]  numVertices    The number of vertices within the model.
+ * @param[out]  collisionMesh  The collision mesh of the model, unless NULL.
  *
  * @return     True of the model loaded successfully, false otherwise.
  */
-bool ModelLoader::loadModel( QString filePath, Vertex*& geometry, 
-    int& numVertices )
+bool ModelLoader::loadModel( QString filePath, Vertex*& geometry,
+    int& numVertices, btTriangleMesh** collisionMesh )
 {
     Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile( filePath.toStdString(), 
+    const aiScene* scene = importer.ReadFile( filePath.toStdString(),
         aiProcess_GenSmoothNormals |
         aiProcess_CalcTangentSpace |
         aiProcess_Triangulate |
@@ -38,60 +43,44 @@ bool ModelLoader::loadModel( QString filePath, Vertex*& geometry,
         for( unsigned int j = 0; j < 3; j++ )
         {
             aiVector3D pos = mesh->mVertices[ face.mIndices[j] ];
-            QVector3D position( pos.x, pos.y, pos.z) ;
+            QVector3D position( pos.x, pos.y, pos.z );
 
             aiVector3D uv = mesh->mTextureCoords[0][face.mIndices[j]];
             QVector2D uv_coords( uv.x, uv.y );
-            
+
             geo->setPosition( position );
             geo->setUV( uv_coords );
-            
+
             geo++;
         }
     }
 
-    geo -= mesh->mNumFaces * 3;
-
-    geometry = geo;
-    return true;
-}
+    geo -= numVertices;
 
-bool ModelLoader::loadTriMesh( QString filePath, btTriangleMesh*& triMesh )
-{
-    Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile( filePath.toStdString(), 
-        aiProcess_GenSmoothNormals |
-        aiProcess_CalcTangentSpace |
-        aiProcess_Triangulate |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_SortByPType );
-
-    if( scene == NULL )
+    if( collisionMesh != NULL )
     {
-        qDebug() << importer.GetErrorString();
-        return false;
-    }
-
-    aiMesh* mesh = scene->mMeshes[0];
-
-    btTriangleMesh* tempTriMesh = new btTriangleMesh();
-    btVector3* triMeshVertices = new btVector3[3];
+        btTriangleMesh* triMesh = new btTriangleMesh();
+        triMesh->preallocateVertices( mesh->mNumVertices );
+        triMesh->preallocateIndices( mesh->mNumFaces * 3 );
 
-    for( unsigned int i = 0; i < mesh->mNumFaces; i++ )
-    {
-        const aiFace& face = mesh->mFaces[i];
+        for( unsigned int i = 0; i < mesh->mNumVertices; i++ )
+        {
+            const aiVector3D& pos = mesh->mVertices[i];
+            triMesh->findOrAddVertex( btVector3( pos.x, pos.y, pos.z ),
+                false );
+        }
 
-        for( unsigned int j = 0; j < 3; j++ )
+        for( unsigned int i = 0; i < mesh->mNumFaces; i++ )
         {
-            aiVector3D pos = mesh->mVertices[ face.mIndices[j] ];
-            triMeshVertices[j] = btVector3( pos.x, pos.y, pos.z );
+            const aiFace& face = mesh->mFaces[i];
+            for( unsigned int j = 0; j < 3; j++ )
+                triMesh->addIndex( face.mIndices[j] );
         }
+        triMesh->getIndexedMeshArray()[0].m_numTriangles = mesh->mNumFaces;
 
-        tempTriMesh->addTriangle( triMeshVertices[0], triMeshVertices[1], 
-            triMeshVertices[2] );
+        *collisionMesh = triMesh;
     }
 
-    triMesh = tempTriMesh;
+    geometry = geo;
     return true;
 }
-
@@ -14,8 +14,8 @@
 
 namespace ModelLoader
 {
-    bool loadModel( QString filePath, Vertex*& geometry, int& numVertices );
-    bool loadTriMesh( QString filePath, btTriangleMesh*& collisionMesh );
+    bool loadModel( QString filePath, Vertex*& geometry, int& numVertices,
+        btTriangleMesh** collisionMesh = NULL );
 };
 
 #endif  //  MODEL_LOADER_H
\ No newline at end of file
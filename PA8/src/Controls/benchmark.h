@@ -0,0 +1,34 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QString>
+#include <QTextStream>
+
+#include <vector>
+
+#include "Entity/scene.h"
+
+/**
+ * @brief      Runs the board without a window and reports its frame timings.
+ * @details    The scene is drawn into a framebuffer object on an offscreen
+ * surface, stepping the Bullet world once a frame like the window does, while
+ * a script pushes the cube around in place of the arrow keys. Every run draws
+ * exactly the same frames, so runs can be compared against each other.
+ */
+class Benchmark
+{
+public:
+    Benchmark( int numFrames, int width = 1280, int height = 720 );
+
+    int run();
+
+private:
+    void cubeScript( Scene& scene, int frame );
+    void report( QTextStream& out, const QString& name,
+        std::vector<double> values );
+
+    int m_numFrames;
+    int m_width, m_height;
+};
+
+#endif  //  BENCHMARK_H
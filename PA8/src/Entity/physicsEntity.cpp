@@ -10,8 +10,8 @@ PhysicsEntity::PhysicsEntity( QString pathToModel, QString pathToTexture,
     :   m_pathToModel( pathToModel ), m_pathToTexture( pathToTexture ),
         m_mass( mass )
 {
-    ModelLoader::loadModel( pathToModel, m_model, m_numVertices );
-    ModelLoader::loadTriMesh( pathToModel, m_triMesh );
+    ModelLoader::loadModel( pathToModel, m_model, m_numVertices,
+        &m_triMesh );
 
     // Initialize Bullet
     if( mass == 0 )
@@ -0,0 +1,214 @@
+#include "scene.h"
+
+#define BIT(x) (1<<(x))
+const short COL_TABLE = BIT(0);
+const short COL_CUBE = BIT(1);
+
+short tableCollidesWith = COL_CUBE;
+short cubeCollidesWith = COL_TABLE;
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Scene. Places the objects above the board and
+ *             the camera in front of it.
+ */
+Scene::Scene()
+    :   m_broadphase( NULL ), m_collisionConfig( NULL ), m_dispatcher( NULL ),
+        m_solver( NULL ), m_dynamicsWorld( NULL )
+{
+    // Default camera view
+    m_camera.rotate( -25.0f, 1.0f, 0.0f, 0.0f );
+    m_camera.translate( 0.0f, 8.0f, 15.0f );
+
+    renderables["Cube"] = new Cube();
+    renderables["Cylindar"] = new Cylindar();
+    ((BaseEntity*)renderables["Cylindar"])->Transform.translate( -3, 3, 0 );
+    renderables["Sphere"] = new Sphere();
+    ((BaseEntity*)renderables["Sphere"])->Transform.translate( 3, 3, 0 );
+    renderables["Board"] = new Board();
+}
+
+/**
+ * @brief      Destructor for Scene, destroying the Bullet world.
+ */
+Scene::~Scene()
+{
+    teardownBullet();
+}
+
+//
+// OPENGL FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Initializes the renderables and adds the physics objects to a
+ *             new Bullet world. Requires a current context.
+ */
+void Scene::initializeGL()
+{
+    initializeOpenGLFunctions();
+    initializeBullet();
+
+    for( QMap<QString, Renderable*>::iterator iter = renderables.begin();
+        iter != renderables.end(); iter++ )
+    {
+        (*iter)->initializeGL();
+    }
+
+    m_dynamicsWorld->addRigidBody(
+        ((Board*)renderables["Board"])->RigidBody, COL_TABLE, tableCollidesWith );
+    m_dynamicsWorld->addRigidBody(
+        ((Cube*)renderables["Cube"])->RigidBody, COL_CUBE, cubeCollidesWith );
+}
+
+/**
+ * @brief      Sets the prespective whenever the surface is resized.
+ *
+ * @param[in]  width   The width of the new surface.
+ * @param[in]  height  The height of the new surface.
+ */
+void Scene::resizeGL( int width, int height )
+{
+    projection.setToIdentity();
+    projection.perspective( 55.0f,  // Field of view angle
+                            float( width ) / float( height ),   // Aspect Ratio
+                            0.001f,  // Near Plane (MUST BE GREATER THAN 0)
+                            1500.0f );  // Far Plane
+}
+
+/**
+ * @brief      Draws the scene to the bound framebuffer.
+ */
+void Scene::paintGL()
+{
+    // Set the default OpenGL states
+    glEnable( GL_DEPTH_TEST );
+    glDepthFunc( GL_LEQUAL );
+    glDepthMask( GL_TRUE );
+    glEnable( GL_CULL_FACE );
+    glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
+
+    // Clear the screen
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+    for( QMap<QString, Renderable*>::iterator iter = renderables.begin();
+        iter != renderables.end(); iter++ )
+    {
+        (*iter)->paintGL( m_camera, projection );
+    }
+}
+
+/**
+ * @brief      Destroys any OpenGL data.
+ */
+void Scene::teardownGL()
+{
+    for( QMap<QString, Renderable*>::iterator iter = renderables.begin();
+        iter != renderables.end(); iter++ )
+    {
+        (*iter)->teardownGL();
+    }
+}
+
+//
+// SIMULATION FUNCTIONS ////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Updates the renderables.
+ */
+void Scene::update()
+{
+    for( QMap<QString, Renderable*>::iterator iter = renderables.begin();
+        iter != renderables.end(); iter++ )
+    {
+        (*iter)->update();
+    }
+}
+
+/**
+ * @brief      Steps the Bullet world once and moves the physics objects to
+ *             where it left them.
+ */
+void Scene::stepSimulation()
+{
+    m_dynamicsWorld->stepSimulation( 1, 10 );
+
+    syncTransform( "Cube" );
+    syncTransform( "Board" );
+}
+
+/**
+ * @brief      Pushes the cube, as the arrow keys do.
+ *
+ * @param[in]  impulse  The impulse to apply to the cube's center.
+ */
+void Scene::pushCube( const btVector3& impulse )
+{
+    ((PhysicsEntity*)renderables["Cube"])->RigidBody->applyCentralImpulse(
+        impulse );
+}
+
+/**
+ * @brief      Gets the camera the scene is drawn from.
+ *
+ * @return     The camera.
+ */
+Camera3D& Scene::camera()
+{
+    return m_camera;
+}
+
+/**
+ * @brief      Gets the number of draw calls a frame makes, one per renderable.
+ *
+ * @return     The number of draw calls.
+ */
+int Scene::drawCalls() const
+{
+    return renderables.size();
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+void Scene::initializeBullet()
+{
+    m_broadphase = new btDbvtBroadphase();
+    m_collisionConfig = new btDefaultCollisionConfiguration();
+    m_dispatcher = new btCollisionDispatcher( m_collisionConfig );
+    m_solver = new btSequentialImpulseConstraintSolver();
+    m_dynamicsWorld = new btDiscreteDynamicsWorld( m_dispatcher, m_broadphase,
+        m_solver, m_collisionConfig );
+
+    m_dynamicsWorld->setGravity( btVector3( 0, -0.5, 0 ) );
+}
+
+void Scene::teardownBullet()
+{
+    delete m_dynamicsWorld;
+    delete m_solver;
+    delete m_dispatcher;
+    delete m_collisionConfig;
+    delete m_broadphase;
+}
+
+/**
+ * @brief      Copies a physics object's Bullet transform to its model matrix.
+ *
+ * @param[in]  name  The name of the physics object.
+ */
+void Scene::syncTransform( const QString& name )
+{
+    PhysicsEntity* entity = (PhysicsEntity*)renderables[name];
+
+    btScalar rawMatrix[16];
+    entity->RigidBody->getWorldTransform().getOpenGLMatrix( rawMatrix );
+
+    QMatrix4x4 newMatrix = QMatrix4x4( rawMatrix );
+    entity->Transform = newMatrix.transposed();
+}
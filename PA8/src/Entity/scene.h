@@ -0,0 +1,63 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <QOpenGLFunctions>
+#include <QMap>
+#include <QMatrix4x4>
+#include <QString>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "Controls/camera3d.h"
+#include "3D/renderable.h"
+#include "Entity/cube.h"
+#include "Entity/cylindar.h"
+#include "Entity/sphere.h"
+#include "Entity/board.h"
+
+/**
+ * @brief      The board, its objects and their Bullet world, along with the
+ *             camera looking at them, without the window, so it can be driven
+ *             by the widget or by the benchmark.
+ */
+class Scene :   protected QOpenGLFunctions
+{
+public:
+    Scene();
+    ~Scene();
+
+    // OpenGL Functions
+    void initializeGL();
+    void resizeGL( int width, int height );
+    void paintGL();
+    void teardownGL();
+
+    // Simulation Functions
+    void update();
+    void stepSimulation();
+    void pushCube( const btVector3& impulse );
+
+    Camera3D& camera();
+    int drawCalls() const;
+
+private:
+    void initializeBullet();
+    void teardownBullet();
+    void syncTransform( const QString& name );
+
+    // OpenGL Objects
+    QMap<QString, Renderable*> renderables;
+
+    // 3D data
+    QMatrix4x4 projection;
+    Camera3D m_camera;
+
+    // Bullet data
+    btBroadphaseInterface* m_broadphase;
+    btDefaultCollisionConfiguration* m_collisionConfig;
+    btCollisionDispatcher* m_dispatcher;
+    btSequentialImpulseConstraintSolver* m_solver;
+    btDiscreteDynamicsWorld* m_dynamicsWorld;
+};
+
+#endif  //  SCENE_H
@@ -1,18 +1,5 @@
 #include "oglWidget.h"
 
-
-
-
-
-
-#define BIT(x) (1<<(x))
-const short COL_TABLE = BIT(0);
-const short COL_CUBE = BIT(1);
-
-short tableCollidesWith = COL_CUBE;
-short cubeCollidesWith = COL_TABLE;
-
-
 //
 // CONSTRUCTORS ////////////////////////////////////////////////////////////////
 // 
@@ -28,17 +15,6 @@ OGLWidget::OGLWidget()
 
     // Allows keyboard input to fall through
     setFocusPolicy( Qt::ClickFocus );
-
-    // Default camera view
-    camera.rotate( -25.0f, 1.0f, 0.0f, 0.0f );
-    camera.translate( 0.0f, 8.0f, 15.0f );
-
-    renderables["Cube"] = new Cube();
-    renderables["Cylindar"] = new Cylindar();
-    ((BaseEntity*)renderables["Cylindar"])->Transform.translate( -3, 3, 0 );
-    renderables["Sphere"] = new Sphere();
-    ((BaseEntity*)renderables["Sphere"])->Transform.translate( 3, 3, 0 );
-    renderables["Board"] = new Board();
 }
 
 /**
@@ -48,7 +24,6 @@ OGLWidget::~OGLWidget()
 {
     makeCurrent();
     teardownGL();
-    teardownBullet();
 }
 
 //
@@ -63,18 +38,8 @@ void OGLWidget::initializeGL()
     // Init OpenGL Backend
     initializeOpenGLFunctions();
     printContextInfo();
-    initializeBullet();
 
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
-    {
-        (*iter)->initializeGL();
-    }
-
-    m_dynamicsWorld->addRigidBody(
-        ((Board*)renderables["Board"])->RigidBody, COL_TABLE, tableCollidesWith );
-    m_dynamicsWorld->addRigidBody( 
-        ((Cube*)renderables["Cube"])->RigidBody, COL_CUBE, cubeCollidesWith );
+    scene.initializeGL();
 }
 
 /**
@@ -85,11 +50,7 @@ void OGLWidget::initializeGL()
  */
 void OGLWidget::resizeGL( int width, int height )
 {
-    projection.setToIdentity();
-    projection.perspective( 55.0f,  // Field of view angle
-                            float( width ) / float( height ),   // Aspect Ratio
-                            0.001f,  // Near Plane (MUST BE GREATER THAN 0)
-                            1500.0f );  // Far Plane
+    scene.resizeGL( width, height );
 }
 
 /**
@@ -97,22 +58,7 @@ void OGLWidget::resizeGL( int width, int height )
  */
 void OGLWidget::paintGL()
 {
-    // Set the default OpenGL states
-    glEnable( GL_DEPTH_TEST );
-    glDepthFunc( GL_LEQUAL );
-    glDepthMask( GL_TRUE );
-    glEnable( GL_CULL_FACE );
-    glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
-
-    // Clear the screen
-    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
-
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
-    {
-        (*iter)->paintGL( camera, projection );
-    }
-
+    scene.paintGL();
 }
 
 /**
@@ -120,11 +66,7 @@ void OGLWidget::paintGL()
  */
 void OGLWidget::teardownGL()
 {
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
-    {
-        (*iter)->teardownGL();
-    }
+    scene.teardownGL();
 }
 
 //
@@ -141,47 +83,16 @@ void OGLWidget::update()
     flyThroughCamera();
 
     if( Input::keyPressed( Qt::Key_Up ) )
-        ((PhysicsEntity*)renderables["Cube"])->RigidBody->applyCentralImpulse(
-            btVector3( 0, 0, -.2 ) );
+        scene.pushCube( btVector3( 0, 0, -.2 ) );
     if( Input::keyPressed( Qt::Key_Down ) )
-        ((PhysicsEntity*)renderables["Cube"])->RigidBody->applyCentralImpulse(
-            btVector3( 0, 0, .2 ) );
+        scene.pushCube( btVector3( 0, 0, .2 ) );
     if( Input::keyPressed( Qt::Key_Left ) )
-        ((PhysicsEntity*)renderables["Cube"])->RigidBody->applyCentralImpulse(
-            btVector3( -.2, 0, 0 ) );
+        scene.pushCube( btVector3( -.2, 0, 0 ) );
     if( Input::keyPressed( Qt::Key_Right ) )
-        ((PhysicsEntity*)renderables["Cube"])->RigidBody->applyCentralImpulse(
-            btVector3( .2, 0, 0 ) );
-
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
-    {
-        (*iter)->update();
-    }
-
-    m_dynamicsWorld->stepSimulation( 1, 10 );
-
-{
-    btScalar rawMatrix[16];
-    ((PhysicsEntity*)renderables["Cube"])->
-        RigidBody->getWorldTransform().getOpenGLMatrix(rawMatrix);
-
-    QMatrix4x4 newMatrix = QMatrix4x4(rawMatrix);
-    newMatrix = newMatrix.transposed();
-
-    ((PhysicsEntity*)renderables["Cube"])->Transform = newMatrix;
-}
-
-{
-    btScalar rawMatrix[16];
-    ((PhysicsEntity*)renderables["Board"])->
-        RigidBody->getWorldTransform().getOpenGLMatrix(rawMatrix);
+        scene.pushCube( btVector3( .2, 0, 0 ) );
 
-    QMatrix4x4 newMatrix = QMatrix4x4(rawMatrix);
-    newMatrix = newMatrix.transposed();
-
-    ((PhysicsEntity*)renderables["Board"])->Transform = newMatrix;
-}
+    scene.update();
+    scene.stepSimulation();
 
     QOpenGLWidget::update();
 }
@@ -245,32 +156,13 @@ void OGLWidget::mouseReleaseEvent( QMouseEvent* event )
 // PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
 //
 
-void OGLWidget::initializeBullet()
-{
-    m_broadphase = new btDbvtBroadphase();
-    m_collisionConfig = new btDefaultCollisionConfiguration();
-    m_dispatcher = new btCollisionDispatcher( m_collisionConfig );
-    m_solver = new btSequentialImpulseConstraintSolver();
-    m_dynamicsWorld = new btDiscreteDynamicsWorld( m_dispatcher, m_broadphase,
-        m_solver, m_collisionConfig );
-
-    m_dynamicsWorld->setGravity( btVector3( 0, -0.5, 0 ) );
-}
-
-void OGLWidget::teardownBullet()
-{
-    delete m_dynamicsWorld;
-    delete m_solver;
-    delete m_dispatcher;
-    delete m_collisionConfig;
-    delete m_broadphase;
-}
-
 /**
  * @brief      Updates the main camera to behave like a Fly-Through Camera.
  */
 void OGLWidget::flyThroughCamera()
 {
+    Camera3D& camera = scene.camera();
+
     static const float cameraTranslationSpeed = 0.03f;
     static const float cameraRotationSpeed = 0.2f;
 
@@ -8,21 +8,12 @@
 #include <QKeyEvent>
 #include <QMouseEvent>
 
-#include <QMap>
-#include <QMatrix4x4>
-
 #include <QDebug>
 #include <QString>
 
-#include <btBulletDynamicsCommon.h>
-
 #include "Controls/input.h"
 #include "Controls/camera3d.h"
-#include "3D/renderable.h"
-#include "Entity/cube.h"
-#include "Entity/cylindar.h"
-#include "Entity/sphere.h"
-#include "Entity/board.h"
+#include "Entity/scene.h"
 
 class OGLWidget    :    public QOpenGLWidget,
                         protected QOpenGLFunctions
@@ -49,8 +40,6 @@ protected:
     void mouseReleaseEvent( QMouseEvent* event );
 
 private:
-    void initializeBullet();
-    void teardownBullet();
     void flyThroughCamera();
     void controlObject();
     void printContextInfo();
@@ -58,19 +47,8 @@ private:
     // Object Control Flag
     bool selectedObject = true; // true starts at sphere
 
-    // OpenGL Objects
-    QMap<QString, Renderable*> renderables;
-
-    // 3D data
-    QMatrix4x4 projection;
-    Camera3D camera;
-
-    // Bullet data
-    btBroadphaseInterface* m_broadphase;
-    btDefaultCollisionConfiguration* m_collisionConfig;
-    btCollisionDispatcher* m_dispatcher;
-    btSequentialImpulseConstraintSolver* m_solver;
-    btDiscreteDynamicsWorld* m_dynamicsWorld;
+    // The objects, their world and the camera
+    Scene scene;
 };
 
 #endif  //  OGL_WIDGET_H
\ No newline at end of file
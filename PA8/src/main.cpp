@@ -1,9 +1,25 @@
 #include <QApplication>
+#include <QCommandLineParser>
+#include "Controls/benchmark.h"
 #include "UI/mainWindow.h"
 
 int main( int argc, char** argv )
 {
     QApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption benchmarkOption( "benchmark",
+        "Runs <frames> frames without a window and prints their timings.",
+        "frames" );
+    parser.addOption( benchmarkOption );
+    parser.process( app );
+
+    if( parser.isSet( benchmarkOption ) )
+    {
+        Benchmark benchmark( parser.value( benchmarkOption ).toInt() );
+        return benchmark.run();
+    }
     
     MainWindow mainWindow;
     mainWindow.resize( QSize( 800, 600 ) );
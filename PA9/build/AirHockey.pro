@@ -29,56 +29,86 @@ INCLUDEPATH = ../src/ /usr/include/bullet
 #A list of filenames of header (.h) files used when building the project.
 HEADERS += \
     #3D
+    ../src/3D/assetLoader.h \
+    ../src/3D/bounds.h \
+    ../src/3D/frustum.h \
+    ../src/3D/glState.h \
+    ../src/3D/mesh.h \
+    ../src/3D/meshCache.h \
     ../src/3D/modelLoader.h \
     ../src/3D/renderable.h \
+    ../src/3D/renderQueue.h \
+    ../src/3D/resourceCache.h \
+    ../src/3D/textureCache.h \
     ../src/3D/transform3d.h \
     ../src/3D/colorVertex.h \
     ../src/3D/uvVertex.h \
     #Controls
+    ../src/Controls/benchmark.h \
     ../src/Controls/camera3d.h \
+    ../src/Controls/fixedTimestep.h \
     ../src/Controls/input.h \
+    ../src/Controls/jobSystem.h \
+    ../src/Controls/physicsBenchmark.h \
+    ../src/Controls/physicsThread.h \
+    ../src/Controls/physicsWorld.h \
+    ../src/Controls/profiler.h \
+    ../src/Controls/spscQueue.h \
+    ../src/Controls/taskScheduler.h \
+    ../src/Controls/time.h \
+    ../src/Controls/tripleBuffer.h \
     #Entity
-    ../src/Entity/colorEntity.h \
-    ../src/Entity/colorPhysicsEntity.h \
-    ../src/Entity/uvEntity.h \
-    ../src/Entity/uvPhysicsEntity.h \
+    ../src/Entity/componentArray.h \
+    ../src/Entity/entityRegistry.h \
+    ../src/Entity/physicsState.h \
+    ../src/Entity/systems.h \
     #GameObjects
-    ../src/GameObjects/hockeyTable.h \
-    ../src/GameObjects/hockeyPuck.h \
-    ../src/GameObjects/hockeyPaddle.h \
-    ../src/GameObjects/skybox.h \
-    ../src/GameObjects/wall.h \
+    ../src/GameObjects/hockeyObjects.h \
     #UI
     ../src/UI/mainMenuWidget.h \
     ../src/UI/mainWindow.h \
     ../src/UI/oglWidget.h \
+    ../src/UI/renderThread.h \
     ../src/UI/teamSelectWidget.h
 
 #A list of source code files to be used when building the project.
 SOURCES += \
     #3D
+    ../src/3D/assetLoader.cpp \
+    ../src/3D/bounds.cpp \
+    ../src/3D/frustum.cpp \
+    ../src/3D/glState.cpp \
+    ../src/3D/meshCache.cpp \
     ../src/3D/modelLoader.cpp \
+    ../src/3D/renderQueue.cpp \
+    ../src/3D/resourceCache.cpp \
+    ../src/3D/textureCache.cpp \
     ../src/3D/transform3d.cpp \
     ../src/3D/colorVertex.cpp \
     ../src/3D/uvVertex.cpp \
     #Controls
+    ../src/Controls/benchmark.cpp \
     ../src/Controls/camera3d.cpp \
+    ../src/Controls/fixedTimestep.cpp \
     ../src/Controls/input.cpp \
+    ../src/Controls/jobSystem.cpp \
+    ../src/Controls/physicsBenchmark.cpp \
+    ../src/Controls/physicsThread.cpp \
+    ../src/Controls/physicsWorld.cpp \
+    ../src/Controls/profiler.cpp \
+    ../src/Controls/taskScheduler.cpp \
+    ../src/Controls/time.cpp \
     #Entity
-    ../src/Entity/colorEntity.cpp \
-    ../src/Entity/colorPhysicsEntity.cpp \
-    ../src/Entity/uvEntity.cpp \
-    ../src/Entity/uvPhysicsEntity.cpp \
+    ../src/Entity/entityRegistry.cpp \
+    ../src/Entity/physicsState.cpp \
+    ../src/Entity/systems.cpp \
     #GameObjects
-    ../src/GameObjects/hockeyTable.cpp \
-    ../src/GameObjects/hockeyPuck.cpp \
-    ../src/GameObjects/hockeyPaddle.cpp \
-    ../src/GameObjects/skybox.cpp \
-    ../src/GameObjects/wall.cpp \
+    ../src/GameObjects/hockeyObjects.cpp \
     #UI
     ../src/UI/mainMenuWidget.cpp \
     ../src/UI/mainWindow.cpp \
     ../src/UI/oglWidget.cpp \
+    ../src/UI/renderThread.cpp \
     ../src/UI/teamSelectWidget.cpp \
     #Main
     ../src/main.cpp
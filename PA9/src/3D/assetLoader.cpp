@@ -0,0 +1,139 @@
+#include "assetLoader.h"
+
+#include <QMutexLocker>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for AssetLoader.
+ *
+ * @param      parent  The parent object.
+ */
+AssetLoader::AssetLoader( QObject* parent )
+    :   QObject( parent ), m_loaded( 0 ), m_total( 0 )
+{
+}
+
+/**
+ * @brief      Destructor for AssetLoader. Waits for any running loads, then
+ *             releases the loader's handles to the assets.
+ */
+AssetLoader::~AssetLoader()
+{
+    for( const JobSystem::Handle& job : m_jobs )
+        JobSystem::instance().wait( job );
+}
+
+//
+// LOADER FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Queues a UV-based model to be decoded.
+ *
+ * @param[in]  modelPath  The path to the model source.
+ */
+void AssetLoader::addUVModel( const QString& modelPath )
+{
+    m_queued.push_back( [this, modelPath]{
+        keep( ResourceCache::uvMesh( modelPath ), m_uvMeshes );
+    } );
+}
+
+/**
+ * @brief      Queues a material-based model to be decoded.
+ *
+ * @param[in]  modelPath  The path to the model source.
+ */
+void AssetLoader::addColorModel( const QString& modelPath )
+{
+    m_queued.push_back( [this, modelPath]{
+        keep( ResourceCache::colorMesh( modelPath ), m_colorMeshes );
+    } );
+}
+
+/**
+ * @brief      Queues the mip chain of a texture to be loaded.
+ *
+ * @param[in]  imagePath  The path to the texture's image.
+ */
+void AssetLoader::addTexture( const QString& imagePath )
+{
+    m_queued.push_back( [this, imagePath]{
+        keep( ResourceCache::mipChain( imagePath ), m_mipChains );
+    } );
+}
+
+/**
+ * @brief      Starts decoding every queued asset. Progress is reported on the
+ *             loader's thread as each asset finishes.
+ */
+void AssetLoader::start()
+{
+    // Before any job reads a texture, so it reads the one the GPU can take
+    ResourceCache::checkTextureCompression();
+
+    m_loaded = 0;
+    m_total = m_queued.size();
+    emit progress( m_loaded, m_total );
+
+    if( m_queued.empty() )
+    {
+        QMetaObject::invokeMethod( this, "finished", Qt::QueuedConnection );
+        return;
+    }
+
+    for( const std::function<void()>& load : m_queued )
+        m_jobs.push_back( JobSystem::instance().run( load ) );
+    m_queued.clear();
+}
+
+/**
+ * @brief      Gets the number of assets being loaded.
+ *
+ * @return     The number of assets.
+ */
+int AssetLoader::total() const
+{
+    return m_total;
+}
+
+//
+// PRIVATE SLOTS ///////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Called on the loader's thread each time a load finishes.
+ */
+void AssetLoader::assetLoaded()
+{
+    m_loaded++;
+    emit progress( m_loaded, m_total );
+
+    if( m_loaded == m_total )
+        emit finished();
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Stores a decoded asset and reports it. Called from a job.
+ *
+ * @param[in]  asset  The decoded asset.
+ * @param      list   The list of handles to keep it in.
+ */
+template <typename T>
+void AssetLoader::keep( const QSharedPointer<T>& asset,
+    QList< QSharedPointer<T> >& list )
+{
+    {
+        QMutexLocker lock( &m_mutex );
+        list.append( asset );
+    }
+
+    QMetaObject::invokeMethod( this, "assetLoaded", Qt::QueuedConnection );
+}
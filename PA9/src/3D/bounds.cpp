@@ -0,0 +1,132 @@
+#include "bounds.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for an empty Bounds.
+ */
+Bounds::Bounds()
+    :   Min( FLT_MAX, FLT_MAX, FLT_MAX ), Max( -FLT_MAX, -FLT_MAX, -FLT_MAX )
+{
+}
+
+/**
+ * @brief      Constructor for Bounds between two corners.
+ *
+ * @param[in]  min   The corner with the smallest coordinates.
+ * @param[in]  max   The corner with the largest coordinates.
+ */
+Bounds::Bounds( const QVector3D& min, const QVector3D& max )
+    :   Min( min ), Max( max )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Grows the box to fit a point.
+ *
+ * @param[in]  point  The point to fit.
+ */
+void Bounds::expand( const QVector3D& point )
+{
+    Min = QVector3D( std::min( Min.x(), point.x() ),
+        std::min( Min.y(), point.y() ), std::min( Min.z(), point.z() ) );
+    Max = QVector3D( std::max( Max.x(), point.x() ),
+        std::max( Max.y(), point.y() ), std::max( Max.z(), point.z() ) );
+}
+
+/**
+ * @brief      Grows the box to fit another one. Empty boxes are skipped.
+ *
+ * @param[in]  bounds  The box to fit.
+ */
+void Bounds::expand( const Bounds& bounds )
+{
+    if( bounds.isEmpty() )
+        return;
+
+    expand( bounds.Min );
+    expand( bounds.Max );
+}
+
+/**
+ * @brief      Gets the box around this one once it is transformed, such as
+ *             from model to world space. Each axis of the new box gathers the
+ *             absolute reach of every transformed axis of the old one.
+ *
+ * @param[in]  transform  The affine transform to apply.
+ *
+ * @return     The transformed box, which is never smaller than the original.
+ */
+Bounds Bounds::transformed( const QMatrix4x4& transform ) const
+{
+    if( isEmpty() )
+        return Bounds();
+
+    const QVector3D center = transform.map( this->center() );
+    const QVector3D extents = this->extents();
+
+    QVector3D reach;
+    for( int row = 0; row < 3; row++ )
+    {
+        reach[row] = std::fabs( transform( row, 0 ) ) * extents.x() +
+            std::fabs( transform( row, 1 ) ) * extents.y() +
+            std::fabs( transform( row, 2 ) ) * extents.z();
+    }
+
+    return Bounds( center - reach, center + reach );
+}
+
+//
+// ACCESSORS ///////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Checks if nothing has been added to the box.
+ *
+ * @return     True if the box is empty.
+ */
+bool Bounds::isEmpty() const
+{
+    return Min.x() > Max.x() || Min.y() > Max.y() || Min.z() > Max.z();
+}
+
+/**
+ * @brief      Gets the center of the box, which is also the center of its
+ *             sphere.
+ *
+ * @return     The center.
+ */
+QVector3D Bounds::center() const
+{
+    return ( Min + Max ) * 0.5f;
+}
+
+/**
+ * @brief      Gets half the size of the box along each axis.
+ *
+ * @return     The half extents.
+ */
+QVector3D Bounds::extents() const
+{
+    return ( Max - Min ) * 0.5f;
+}
+
+/**
+ * @brief      Gets the radius of the sphere through the corners of the box.
+ *
+ * @return     The radius of the bounding sphere.
+ */
+float Bounds::radius() const
+{
+    return extents().length();
+}
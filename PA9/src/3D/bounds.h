@@ -0,0 +1,31 @@
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <QMatrix4x4>
+#include <QVector3D>
+
+/**
+ * @brief      Axis aligned bounding box, along with the sphere around it.
+ * @details    A default box is empty, with its minimum above its maximum, and
+ * grows to fit whatever is added to it.
+ */
+class Bounds
+{
+public:
+    Bounds();
+    Bounds( const QVector3D& min, const QVector3D& max );
+
+    void expand( const QVector3D& point );
+    void expand( const Bounds& bounds );
+    Bounds transformed( const QMatrix4x4& transform ) const;
+
+    bool isEmpty() const;
+    QVector3D center() const;
+    QVector3D extents() const;
+    float radius() const;
+
+    QVector3D Min;
+    QVector3D Max;
+};
+
+#endif  //  BOUNDS_H
@@ -0,0 +1,136 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <qopengl.h>
+#include <QByteArray>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "bounds.h"
+#include "uvVertex.h"
+#include "colorVertex.h"
+
+/**
+ * @brief      Indexed triangle list for a vertex type.
+ * @details    Indices are kept as 32-bit values while loading and packed down
+ * to 16-bit on upload whenever every vertex can be addressed by them. The
+ * bounds of the vertices outlive them, for culling once the mesh is on the GPU,
+ * and so does the face culling the mesh can be drawn with.
+ */
+template <typename Vertex>
+struct Mesh
+{
+    std::vector<Vertex> Vertices;
+    std::vector<GLuint> Indices;
+    Bounds Box;
+
+    // GL_BACK for closed meshes, GL_NONE when both sides may be seen
+    GLenum CullFace;
+
+    Mesh() : CullFace( GL_NONE ) {}
+
+    /**
+     * @brief      Fits the bounds around every vertex.
+     */
+    void computeBounds()
+    {
+        Box = Bounds();
+        for( const Vertex& vertex : Vertices )
+            Box.expand( vertex.position() );
+    }
+
+    /**
+     * @brief      Checks whether the back faces can be culled. They can when
+     *             the mesh is closed, every edge being shared by a triangle
+     *             going the other way along it, so no back face is ever seen
+     *             from outside. Vertices are matched by position, as UV seams
+     *             split them.
+     */
+    void computeCullFace()
+    {
+        std::map< std::tuple<float, float, float>, GLuint > positions;
+        std::vector<GLuint> ids( Vertices.size() );
+        for( unsigned int i = 0; i < Vertices.size(); ++i )
+        {
+            const QVector3D position = Vertices[i].position();
+            ids[i] = positions.insert( std::make_pair( std::make_tuple(
+                position.x(), position.y(), position.z() ),
+                (GLuint)positions.size() ) ).first->second;
+        }
+
+        std::vector< std::pair<GLuint, GLuint> > edges, reversed;
+        for( unsigned int i = 0; i + 2 < Indices.size(); i += 3 )
+        {
+            for( int j = 0; j < 3; ++j )
+            {
+                const GLuint from = ids[ Indices[i + j] ];
+                const GLuint to = ids[ Indices[i + ( j + 1 ) % 3] ];
+                edges.push_back( std::make_pair( from, to ) );
+                reversed.push_back( std::make_pair( to, from ) );
+            }
+        }
+        std::sort( edges.begin(), edges.end() );
+        std::sort( reversed.begin(), reversed.end() );
+
+        CullFace = !edges.empty() && edges == reversed ? GL_BACK : GL_NONE;
+    }
+
+    /**
+     * @brief      The smallest index type able to address every vertex.
+     *
+     * @return     GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+     */
+    GLenum indexType() const
+    {
+        return Vertices.size() <= 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+
+    /**
+     * @brief      The size in bytes of a single packed index.
+     *
+     * @return     2 or 4.
+     */
+    int indexSize() const
+    {
+        return indexType() == GL_UNSIGNED_SHORT ?
+            sizeof( GLushort ) : sizeof( GLuint );
+    }
+
+    /**
+     * @brief      Packs the indices into indexType() for an index buffer.
+     *
+     * @return     The packed index data.
+     */
+    QByteArray packedIndices() const
+    {
+        if( indexType() == GL_UNSIGNED_INT )
+            return QByteArray( reinterpret_cast<const char*>( Indices.data() ),
+                Indices.size() * sizeof( GLuint ) );
+
+        QByteArray packed( Indices.size() * sizeof( GLushort ), 0 );
+        GLushort* shortIndices = reinterpret_cast<GLushort*>( packed.data() );
+        for( unsigned int i = 0; i < Indices.size(); ++i )
+            shortIndices[i] = static_cast<GLushort>( Indices[i] );
+
+        return packed;
+    }
+
+    /**
+     * @brief      Frees the CPU copy of the mesh once it lives on the GPU. The
+     *             bounds are kept.
+     */
+    void clear()
+    {
+        std::vector<Vertex>().swap( Vertices );
+        std::vector<GLuint>().swap( Indices );
+    }
+};
+
+typedef Mesh<UVVertex> UVMesh;
+typedef Mesh<ColorVertex> ColorMesh;
+
+#endif  //  MESH_H
\ No newline at end of file
@@ -0,0 +1,347 @@
+#include "resourceCache.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QWeakPointer>
+
+#include <atomic>
+
+#include "modelLoader.h"
+
+//
+// PRIVATE HELPERS /////////////////////////////////////////////////////////////
+//
+
+namespace
+{
+    QHash< QString, QWeakPointer<UVMesh> > uvMeshes;
+    QHash< QString, QWeakPointer<ColorMesh> > colorMeshes;
+    QHash< QString, QWeakPointer<TextureCache::MipChain> > mipChains;
+    QHash< QString, QWeakPointer<ResourceCache::MeshBuffers> > uvBufferCache;
+    QHash< QString, QWeakPointer<ResourceCache::MeshBuffers> > colorBufferCache;
+    QHash< QString, QWeakPointer<QOpenGLTexture> > textures;
+    QHash< QString, QWeakPointer<QOpenGLShaderProgram> > programs;
+
+    // Guards every cache above, never held while a resource is created
+    QMutex cacheMutex;
+
+    // Whether the GPU takes S3TC textures, -1 until it has been checked
+    std::atomic<int> s3tcSupport( -1 );
+
+    /**
+     * @brief      Returns the live resource for a key, creating it if needed.
+     * @details    Two threads missing on the same key may both create the
+     * resource; the first one stored wins and the other copy is dropped.
+     *
+     * @param      cache   The weak references of one resource type.
+     * @param[in]  key     The key of the resource.
+     * @param[in]  create  Creates the resource on a cache miss.
+     *
+     * @return     A handle to the resource.
+     */
+    template <typename T, typename Factory>
+    QSharedPointer<T> acquire( QHash< QString, QWeakPointer<T> >& cache,
+        const QString& key, Factory create )
+    {
+        {
+            QMutexLocker lock( &cacheMutex );
+            QSharedPointer<T> resource = cache.value( key ).toStrongRef();
+            if( !resource.isNull() )
+                return resource;
+        }
+
+        QSharedPointer<T> created( create() );
+
+        QMutexLocker lock( &cacheMutex );
+        QSharedPointer<T> resource = cache.value( key ).toStrongRef();
+        if( resource.isNull() )
+        {
+            resource = created;
+            cache.insert( key, resource.toWeakRef() );
+        }
+
+        return resource;
+    }
+
+    /**
+     * @brief      Uploads a mesh into a vertex and index buffer pair.
+     *
+     * @param[in]  mesh  The mesh to upload.
+     *
+     * @return     The GPU copy of the mesh.
+     */
+    template <typename Vertex>
+    ResourceCache::MeshBuffers* upload( const Mesh<Vertex>& mesh )
+    {
+        ResourceCache::MeshBuffers* buffers = new ResourceCache::MeshBuffers();
+
+        buffers->Vertices.create();
+        buffers->Vertices.bind();
+        buffers->Vertices.setUsagePattern( QOpenGLBuffer::StaticDraw );
+        buffers->Vertices.allocate( mesh.Vertices.data(),
+            mesh.Vertices.size() * sizeof( Vertex ) );
+        buffers->Vertices.release();
+
+        buffers->NumIndices = mesh.Indices.size();
+        buffers->IndexType = mesh.indexType();
+        buffers->Indices.create();
+        buffers->Indices.bind();
+        buffers->Indices.setUsagePattern( QOpenGLBuffer::StaticDraw );
+        buffers->Indices.allocate( mesh.packedIndices().constData(),
+            buffers->NumIndices * mesh.indexSize() );
+        buffers->Indices.release();
+
+        return buffers;
+    }
+}
+
+//
+// MESH BUFFERS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor for MeshBuffers.
+ */
+ResourceCache::MeshBuffers::MeshBuffers()
+    :   Vertices( QOpenGLBuffer::VertexBuffer ),
+        Indices( QOpenGLBuffer::IndexBuffer ),
+        NumIndices( 0 ), IndexType( GL_UNSIGNED_SHORT )
+{
+}
+
+//
+// CPU RESOURCES ///////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the shared UV-based mesh of a model.
+ *
+ * @param[in]  modelPath  The path to the model source.
+ *
+ * @return     A handle to the mesh.
+ */
+QSharedPointer<UVMesh> ResourceCache::uvMesh( const QString& modelPath )
+{
+    return acquire( uvMeshes, modelPath, [&modelPath]{
+        UVMesh* mesh = new UVMesh();
+        ModelLoader::loadUVModel( modelPath, *mesh );
+        return mesh;
+    } );
+}
+
+/**
+ * @brief      Gets the shared material-based mesh of a model.
+ *
+ * @param[in]  modelPath  The path to the model source.
+ *
+ * @return     A handle to the mesh.
+ */
+QSharedPointer<ColorMesh> ResourceCache::colorMesh( const QString& modelPath )
+{
+    return acquire( colorMeshes, modelPath, [&modelPath]{
+        ColorMesh* mesh = new ColorMesh();
+        ModelLoader::loadColorModel( modelPath, *mesh );
+        return mesh;
+    } );
+}
+
+/**
+ * @brief      Gets the shared mip chain of an image, flipped for OpenGL.
+ * @details    The chain is read from the image's TextureCache file when one is
+ * up to date. Otherwise the image is decoded and its chain is built and
+ * cached, DXT1 compressed unless the image has an alpha channel.
+ *
+ * Once checkTextureCompression has found a GPU without S3TC, the chain is an
+ * RGBA one instead, read from and written to the uncompressed cache. A usual
+ * cache that already holds RGBA is taken as is, and a compressed one is only
+ * decompressed if the source cannot be decoded.
+ *
+ * @param[in]  imagePath  The path to the image.
+ *
+ * @return     A handle to the mip chain.
+ */
+QSharedPointer<TextureCache::MipChain> ResourceCache::mipChain(
+    const QString& imagePath )
+{
+    const TextureCache::Variant variant = s3tcSupport == 0 ?
+        TextureCache::Uncompressed : TextureCache::Preferred;
+    const QString key = TextureCache::cachePath( imagePath, variant );
+    return acquire( mipChains, key, [&imagePath, variant]{
+        TextureCache::MipChain* chain = new TextureCache::MipChain();
+        if( TextureCache::load( imagePath, *chain, variant ) )
+            return chain;
+
+        TextureCache::MipChain cached;
+        if( variant == TextureCache::Uncompressed &&
+            TextureCache::load( imagePath, cached ) &&
+            cached.PixelFormat == TextureCache::RGBA8 )
+        {
+            *chain = cached;
+            return chain;
+        }
+
+        QImage image( imagePath );
+        TextureCache::Format format =
+            variant == TextureCache::Uncompressed || image.hasAlphaChannel() ?
+            TextureCache::RGBA8 : TextureCache::DXT1;
+
+        if( TextureCache::build( image, format, *chain ) )
+            TextureCache::save( imagePath, *chain, variant );
+        else if( !cached.Levels.empty() )
+            TextureCache::decompress( cached, *chain );
+        return chain;
+    } );
+}
+
+//
+// GPU RESOURCES ///////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Checks once whether the GPU takes S3TC compressed textures, so
+ *             mipChain can pick the cache the textures will be uploaded from.
+ * @details    Uses the current context or, while the game loads without one,
+ * a throwaway context of the default format, which has to be made on the GUI
+ * thread.
+ */
+void ResourceCache::checkTextureCompression()
+{
+    if( s3tcSupport != -1 )
+        return;
+
+    QOpenGLContext* current = QOpenGLContext::currentContext();
+    if( current != NULL )
+    {
+        s3tcSupport = current->hasExtension(
+            "GL_EXT_texture_compression_s3tc" );
+        return;
+    }
+
+    QOpenGLContext context;
+    if( !context.create() )
+        return;
+
+    QOffscreenSurface surface;
+    surface.setFormat( context.format() );
+    surface.create();
+    if( context.makeCurrent( &surface ) )
+    {
+        s3tcSupport = context.hasExtension(
+            "GL_EXT_texture_compression_s3tc" );
+        context.doneCurrent();
+    }
+}
+
+/**
+ * @brief      Gets the shared GPU buffers of a UV-based model.
+ *
+ * @param[in]  modelPath  The path to the model source.
+ *
+ * @return     A handle to the buffers.
+ */
+QSharedPointer<ResourceCache::MeshBuffers> ResourceCache::uvBuffers(
+    const QString& modelPath )
+{
+    return acquire( uvBufferCache, modelPath, [&modelPath]{
+        return upload( *uvMesh( modelPath ) );
+    } );
+}
+
+/**
+ * @brief      Gets the shared GPU buffers of a material-based model.
+ *
+ * @param[in]  modelPath  The path to the model source.
+ *
+ * @return     A handle to the buffers.
+ */
+QSharedPointer<ResourceCache::MeshBuffers> ResourceCache::colorBuffers(
+    const QString& modelPath )
+{
+    return acquire( colorBufferCache, modelPath, [&modelPath]{
+        return upload( *colorMesh( modelPath ) );
+    } );
+}
+
+/**
+ * @brief      Gets the shared mipmapped texture of an image.
+ * @details    Uploads the chain mipChain gives for the context, checking the
+ * context for S3TC first if the loader has not.
+ *
+ * @param[in]  imagePath  The path to the image.
+ *
+ * @return     A handle to the texture.
+ */
+QSharedPointer<QOpenGLTexture> ResourceCache::texture(
+    const QString& imagePath )
+{
+    checkTextureCompression();
+
+    return acquire( textures, imagePath, [&imagePath]{
+        QSharedPointer<TextureCache::MipChain> cached = mipChain( imagePath );
+        const TextureCache::MipChain* chain = cached.data();
+
+        QOpenGLTexture* texture = new QOpenGLTexture(
+            QOpenGLTexture::Target2D );
+        if( chain->Levels.empty() )
+        {
+            qWarning() << "Could not load texture" << imagePath;
+            return texture;
+        }
+
+        texture->setSize( chain->Levels[0].Width, chain->Levels[0].Height );
+        texture->setMipLevels( chain->Levels.size() );
+
+        if( chain->PixelFormat == TextureCache::DXT1 )
+        {
+            texture->setFormat( QOpenGLTexture::RGB_DXT1 );
+            texture->allocateStorage();
+            for( unsigned i = 0; i < chain->Levels.size(); i++ )
+            {
+                texture->setCompressedData( i, chain->Levels[i].Data.size(),
+                    chain->Levels[i].Data.constData() );
+            }
+        }
+        else
+        {
+            texture->setFormat( QOpenGLTexture::RGBA8_UNorm );
+            texture->allocateStorage( QOpenGLTexture::RGBA,
+                QOpenGLTexture::UInt8 );
+            for( unsigned i = 0; i < chain->Levels.size(); i++ )
+            {
+                texture->setData( i, QOpenGLTexture::RGBA,
+                    QOpenGLTexture::UInt8, chain->Levels[i].Data.constData() );
+            }
+        }
+
+        texture->setMinificationFilter( QOpenGLTexture::LinearMipMapLinear );
+        texture->setMagnificationFilter( QOpenGLTexture::Linear );
+        return texture;
+    } );
+}
+
+/**
+ * @brief      Gets the shared, linked shader program of a shader pair.
+ *
+ * @param[in]  vertexPath    The path to the vertex shader.
+ * @param[in]  fragmentPath  The path to the fragment shader.
+ *
+ * @return     A handle to the program.
+ */
+QSharedPointer<QOpenGLShaderProgram> ResourceCache::program(
+    const QString& vertexPath, const QString& fragmentPath )
+{
+    return acquire( programs, vertexPath + "|" + fragmentPath,
+        [&vertexPath, &fragmentPath]{
+            QOpenGLShaderProgram* program = new QOpenGLShaderProgram();
+            program->addShaderFromSourceFile( QOpenGLShader::Vertex,
+                vertexPath );
+            program->addShaderFromSourceFile( QOpenGLShader::Fragment,
+                fragmentPath );
+            program->link();
+            return program;
+        } );
+}
\ No newline at end of file
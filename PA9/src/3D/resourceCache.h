@@ -0,0 +1,53 @@
+#ifndef RESOURCE_CACHE_H
+#define RESOURCE_CACHE_H
+
+#include <QOpenGLBuffer>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+
+#include <QSharedPointer>
+#include <QString>
+
+#include "mesh.h"
+#include "textureCache.h"
+
+/**
+ * @brief      Process wide cache of meshes, textures and shader programs.
+ * @details    Resources are keyed by their source paths and handed out as
+ * reference counted handles. The cache itself only holds weak references, so
+ * a resource is destroyed as soon as the last entity using it releases its
+ * handle. GL resources must therefore be released with the context current,
+ * which every teardownGL already guarantees.
+ *
+ * The CPU side functions are thread safe so assets can be decoded on worker
+ * threads (see AssetLoader); the GPU side ones must run on the GUI thread.
+ */
+namespace ResourceCache
+{
+    struct MeshBuffers
+    {
+        MeshBuffers();
+
+        QOpenGLBuffer Vertices;
+        QOpenGLBuffer Indices;
+        int NumIndices;
+        GLenum IndexType;
+    };
+
+    // CPU side data, safe to call from any thread
+    QSharedPointer<UVMesh> uvMesh( const QString& modelPath );
+    QSharedPointer<ColorMesh> colorMesh( const QString& modelPath );
+    QSharedPointer<TextureCache::MipChain> mipChain( const QString& imagePath );
+
+    // Requires a current context, or the GUI thread
+    void checkTextureCompression();
+
+    // GPU side data, requires a current context
+    QSharedPointer<MeshBuffers> uvBuffers( const QString& modelPath );
+    QSharedPointer<MeshBuffers> colorBuffers( const QString& modelPath );
+    QSharedPointer<QOpenGLTexture> texture( const QString& imagePath );
+    QSharedPointer<QOpenGLShaderProgram> program( const QString& vertexPath,
+        const QString& fragmentPath );
+};
+
+#endif  //  RESOURCE_CACHE_H
\ No newline at end of file
@@ -12,7 +12,7 @@ const QVector3D Transform3D::LocalRight( 1.0f, 0.0f, 0.0f );
  * @brief      Default constructor, sets the scale to 1.
  */
 Transform3D::Transform3D()
-    :   m_scale( 1.0f, 1.0f, 1.0f )
+    :   m_scale( 1.0f, 1.0f, 1.0f ), m_dirty( true )
 {
 }
 
@@ -28,6 +28,7 @@ Transform3D::Transform3D()
 void Transform3D::translate( const QVector3D& dt )
 {
     m_translation += dt;
+    m_dirty = true;
 }
 
 /**
@@ -51,6 +52,7 @@ void Transform3D::translate( float dx, float dy, float dz )
 void Transform3D::scale( const QVector3D& ds )
 {
     m_scale *= ds;
+    m_dirty = true;
 }
 
 /**
@@ -85,6 +87,7 @@ void Transform3D::scale( float factor )
 void Transform3D::rotate( const QQuaternion& dr )
 {
     m_rotation = dr * m_rotation;
+    m_dirty = true;
 }
 
 /**
@@ -125,6 +128,7 @@ void Transform3D::rotate( float angle, float ax, float ay, float az )
 void Transform3D::setTranslation( const QVector3D& t )
 {
     m_translation = t;
+    m_dirty = true;
 }
 
 /**
@@ -148,6 +152,7 @@ void Transform3D::setTranslation( float x, float y, float z )
 void Transform3D::setScale( const QVector3D& s )
 {
     m_scale = s;
+    m_dirty = true;
 }
 
 /**
@@ -182,6 +187,7 @@ void Transform3D::setScale( float k )
 void Transform3D::setRotation( const QQuaternion& r )
 {
     m_rotation = r;
+    m_dirty = true;
 }
 
 /**
@@ -245,16 +251,21 @@ const QQuaternion& Transform3D::rotation() const
 }
 
 /**
- * @brief      Getter function for m_world.
+ * @brief      Getter function for m_world. The matrix is only rebuilt after
+ *             the transform has changed.
  *
  * @return     The full matrix with current translations.
  */
 const QMatrix4x4& Transform3D::toMatrix()
 {
-    m_world.setToIdentity();
-    m_world.translate( m_translation );
-    m_world.rotate( m_rotation );
-    m_world.scale( m_scale );
+    if( m_dirty )
+    {
+        m_world.setToIdentity();
+        m_world.translate( m_translation );
+        m_world.rotate( m_rotation );
+        m_world.scale( m_scale );
+        m_dirty = false;
+    }
 
     return m_world;
 }
@@ -0,0 +1,212 @@
+#include "benchmark.h"
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QSurfaceFormat>
+
+#include "3D/renderQueue.h"
+#include "Controls/camera3d.h"
+#include "Controls/fixedTimestep.h"
+#include "Controls/profiler.h"
+#include "Entity/systems.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Benchmark.
+ *
+ * @param[in]  numFrames       The number of frames to run.
+ * @param[in]  stressPucks     Extra pucks dropped on the table.
+ * @param[in]  backend         The backend of the dynamics world.
+ * @param[in]  physicsThreads  The threads of the multithreaded backend, 0 for
+ *                             every core.
+ * @param[in]  width           The width of the offscreen framebuffer.
+ * @param[in]  height          The height of the offscreen framebuffer.
+ */
+Benchmark::Benchmark( int numFrames, int stressPucks,
+    PhysicsWorld::Backend backend, int physicsThreads, int width, int height )
+    :   m_numFrames( numFrames ), m_stressPucks( stressPucks ),
+        m_backend( backend ), m_physicsThreads( physicsThreads ),
+        m_width( width ), m_height( height )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Builds the game, runs every frame and prints the results.
+ *
+ * @return     The exit code of the program.
+ */
+int Benchmark::run()
+{
+    QTextStream out( stdout );
+
+    // Same context the game window asks for
+    QSurfaceFormat format;
+    format.setDepthBufferSize( 24 );
+    format.setRenderableType( QSurfaceFormat::OpenGL );
+    format.setProfile( QSurfaceFormat::NoProfile );
+    format.setVersion( 2,1 );
+
+    QOpenGLContext context;
+    context.setFormat( format );
+    if( !context.create() )
+    {
+        out << "Could not create an OpenGL context" << endl;
+        return 1;
+    }
+
+    QOffscreenSurface surface;
+    surface.setFormat( context.format() );
+    surface.create();
+    if( !context.makeCurrent( &surface ) )
+    {
+        out << "Could not make the OpenGL context current" << endl;
+        return 1;
+    }
+
+    QOpenGLFramebufferObject framebuffer( m_width, m_height,
+        QOpenGLFramebufferObject::Depth );
+    framebuffer.bind();
+
+    QOpenGLFunctions* gl = context.functions();
+    out << "OpenGL " << reinterpret_cast<const char*>(
+        gl->glGetString( GL_RENDERER ) ) << ", " << m_numFrames
+        << " frames at " << m_width << "x" << m_height << ", "
+        << m_stressPucks << " extra pucks" << endl;
+
+    // Everything is loaded up front, loading is not part of the run
+    EntityRegistry registry;
+    const HockeyObjects::Rink rink = HockeyObjects::createRink( registry );
+    HockeyObjects::createStressPucks( registry, m_stressPucks,
+        btVector3( 0, 35, 0 ) );
+    registry.sound( rink.Table )->Player->stop();
+    registry.initializeGL();
+
+    PhysicsWorld physics( m_backend, m_physicsThreads );
+    btDiscreteDynamicsWorld* world = physics.world();
+    world->setGravity( btVector3( 0, -9.8, 0 ) );
+    Systems::addBodies( registry, world );
+
+    // The game's side view
+    Camera3D camera;
+    camera.setRotation( -45.0f, 1.0f, 0.0f, 0.0f );
+    camera.setTranslation( 1.7f, 70.0f, 50.0f );
+    QMatrix4x4 projection;
+    projection.perspective( 55.0f, float( m_width ) / float( m_height ),
+        0.001f, 1500.0f );
+
+    RenderQueue renderQueue;
+    renderQueue.initializeGL();
+
+    Profiler profiler( m_numFrames + 1 );
+    profiler.initializeGL();
+    const int profileInput = profiler.addSection( "Input" );
+    const int profilePhysics = profiler.addSection( "Physics" );
+    const int profileUpdate = profiler.addSection( "Update" );
+    const int profileDraw = profiler.addSection( "Draw" );
+    const int profileFinish = profiler.addSection( "Finish" );
+
+    // Fixed frame time, so every run simulates the same ticks and frames
+    FixedTimestep timestep( 60.0f, 20 );
+    const float dt = 1.0f / 60.0f;
+    for( int frame = 0; frame < m_numFrames; frame++ )
+    {
+        profiler.nextFrame();
+
+        profiler.begin( profileInput );
+        paddleScript( registry, rink, frame );
+        profiler.end( profileInput );
+
+        const int ticks = timestep.advance( dt * SIMULATION_SPEED );
+        for( int tick = 0; tick < ticks; tick++ )
+        {
+            profiler.begin( profilePhysics );
+            world->stepSimulation( timestep.step(), 0 );
+            profiler.end( profilePhysics );
+
+            Profiler::Scope scope( profiler, profileUpdate );
+            Systems::recordBodies( registry );
+        }
+        Systems::interpolateBodies( registry, timestep.alpha() );
+
+        gl->glEnable( GL_DEPTH_TEST );
+        gl->glDepthFunc( GL_LEQUAL );
+        gl->glDepthMask( GL_TRUE );
+        gl->glEnable( GL_CULL_FACE );
+        gl->glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
+        gl->glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+        profiler.beginGPU();
+        profiler.begin( profileDraw );
+        renderQueue.begin( camera, projection );
+        Systems::submitModels( registry, renderQueue );
+        renderQueue.flush();
+        profiler.end( profileDraw );
+        profiler.endGPU();
+
+        // Wait for the GPU, so the frame time includes the draw itself
+        Profiler::Scope scope( profiler, profileFinish );
+        gl->glFinish();
+    }
+    profiler.nextFrame();
+
+    out << qSetFieldWidth( 10 ) << left << "" << right << "mean" << "p50"
+        << "p99" << "max" << qSetFieldWidth( 0 ) << "  (ms)" << endl;
+    Profiler::printSeries( out, "Frame", profiler.frameTimes() );
+    for( int i = 0; i < profiler.sections().size(); i++ )
+    {
+        Profiler::printSeries( out, profiler.sections()[i],
+            profiler.sectionTimes( i ) );
+    }
+    Profiler::printSeries( out, "GPU", profiler.gpuTimes() );
+
+    out << qSetFieldWidth( 10 ) << left << "" << right << "mean" << "p50"
+        << "p99" << "max" << qSetFieldWidth( 0 ) << endl;
+    Profiler::printSeries( out, "Draws", profiler.drawCalls() );
+    Profiler::printSeries( out, "Triangles", profiler.triangles() );
+    Profiler::printSeries( out, "Drawn", profiler.objectsDrawn() );
+    Profiler::printSeries( out, "Culled", profiler.objectsCulled() );
+    Profiler::printSeries( out, "State", profiler.stateCalls() );
+    Profiler::printSeries( out, "Skipped", profiler.stateSkipped() );
+
+    Systems::removeBodies( registry, world );
+    profiler.teardownGL();
+    registry.teardownGL();
+
+    framebuffer.release();
+    context.doneCurrent();
+    return 0;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Stands in for the players, driving each paddle forward, across,
+ *             back and across again for half a second each, the second one
+ *             mirroring the first.
+ *
+ * @param      registry  The registry of the paddles.
+ * @param[in]  rink      The entities of the game.
+ * @param[in]  frame     The frame being run.
+ */
+void Benchmark::paddleScript( EntityRegistry& registry,
+    const HockeyObjects::Rink& rink, int frame )
+{
+    // Same speed as the arrow keys move a paddle at
+    static const btVector3 MOVES[] = { btVector3( 5, 0, 0 ),
+        btVector3( 0, 0, 5 ), btVector3( -5, 0, 0 ), btVector3( 0, 0, -5 ) };
+
+    const btVector3& move = MOVES[( frame / 30 ) % 4];
+    registry.body( rink.Paddle )->RigidBody->setLinearVelocity( move );
+    registry.body( rink.Paddle2 )->RigidBody->setLinearVelocity( -move );
+}
@@ -0,0 +1,38 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "Controls/physicsWorld.h"
+#include "Entity/entityRegistry.h"
+#include "GameObjects/hockeyObjects.h"
+
+/**
+ * @brief      Runs the game without a window and reports its frame timings.
+ * @details    The table is drawn into a framebuffer object on an offscreen
+ * surface at a fixed 60 frames per second, while a script drives both paddles
+ * in a fixed pattern. Every run simulates and draws exactly the same frames,
+ * so runs can be compared against each other.
+ */
+class Benchmark
+{
+public:
+    Benchmark( int numFrames, int stressPucks = 0,
+        PhysicsWorld::Backend backend = PhysicsWorld::Serial,
+        int physicsThreads = 0, int width = 1280, int height = 720 );
+
+    int run();
+
+private:
+    void paddleScript( EntityRegistry& registry,
+        const HockeyObjects::Rink& rink, int frame );
+
+    // The game's pace, see OGLWidget
+    const float SIMULATION_SPEED = 10.0f;
+
+    int m_numFrames;
+    int m_stressPucks;
+    PhysicsWorld::Backend m_backend;
+    int m_physicsThreads;
+    int m_width, m_height;
+};
+
+#endif  //  BENCHMARK_H
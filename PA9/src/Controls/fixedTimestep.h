@@ -0,0 +1,22 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+class FixedTimestep
+{
+public:
+    FixedTimestep( float tickRate = 60.0f, int maxTicks = 8 );
+
+    void setTickRate( float tickRate );
+    void setMaxTicks( int maxTicks );
+
+    int advance( float dt );
+    float step() const;
+    float alpha() const;
+
+private:
+    double m_step;
+    double m_accumulator;
+    int m_maxTicks;
+};
+
+#endif  //  FIXED_TIMESTEP_H
@@ -0,0 +1,96 @@
+#include "physicsBenchmark.h"
+
+#include <QElapsedTimer>
+
+#include "Controls/profiler.h"
+#include "Controls/taskScheduler.h"
+#include "Entity/entityRegistry.h"
+#include "Entity/systems.h"
+#include "GameObjects/hockeyObjects.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for PhysicsBenchmark.
+ *
+ * @param[in]  numBodies  The number of pucks to drop.
+ * @param[in]  numSteps   The number of 1/60 s steps of each run.
+ */
+PhysicsBenchmark::PhysicsBenchmark( int numBodies, int numSteps )
+    :   m_numBodies( numBodies ), m_numSteps( numSteps )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Runs the serial world, then the multithreaded one on every
+ *             thread count, and prints the step times of each.
+ *
+ * @return     The exit code of the program.
+ */
+int PhysicsBenchmark::run()
+{
+    QTextStream out( stdout );
+
+    const int maxThreads = TaskScheduler::instance().getMaxNumThreads();
+    out << m_numBodies << " bodies, " << m_numSteps << " steps of 1/60 s, "
+        << "up to " << maxThreads << " threads, speedup over the serial "
+        << "world as the 1 thread baseline" << endl;
+
+    out << qSetFieldWidth( 10 ) << left << "" << right << "mean" << "p50"
+        << "p99" << "max" << "speedup" << qSetFieldWidth( 0 ) << "  (ms)"
+        << endl;
+
+    // The serial world is the 1 thread baseline, the multithreaded one on a
+    // single thread shows what scheduling the loops costs
+    const double serial = Profiler::printSeries( out, "Serial",
+        stepTimes( PhysicsWorld::Serial, 1 ) );
+    for( int threads = 1; threads <= maxThreads; threads++ )
+    {
+        Profiler::printSeries( out, QString( "%1 thr" ).arg( threads ),
+            stepTimes( PhysicsWorld::Multithreaded, threads ), serial );
+    }
+
+    return 0;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Builds the scene in a new world and times every step of it.
+ *
+ * @param[in]  backend     The backend of the world.
+ * @param[in]  numThreads  The number of threads of the multithreaded backend.
+ *
+ * @return     The time of every step, in milliseconds.
+ */
+std::vector<double> PhysicsBenchmark::stepTimes(
+    PhysicsWorld::Backend backend, int numThreads )
+{
+    EntityRegistry registry;
+    HockeyObjects::createStressScene( registry, m_numBodies );
+
+    PhysicsWorld physics( backend, numThreads );
+    btDiscreteDynamicsWorld* world = physics.world();
+    world->setGravity( btVector3( 0, -9.8, 0 ) );
+    Systems::addBodies( registry, world );
+
+    std::vector<double> times;
+    QElapsedTimer timer;
+    for( int step = 0; step < m_numSteps; step++ )
+    {
+        timer.start();
+        world->stepSimulation( 1.0f / 60.0f, 0 );
+        times.push_back( timer.nsecsElapsed() / 1e6 );
+    }
+
+    Systems::removeBodies( registry, world );
+    return times;
+}
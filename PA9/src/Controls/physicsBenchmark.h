@@ -0,0 +1,32 @@
+#ifndef PHYSICS_BENCHMARK_H
+#define PHYSICS_BENCHMARK_H
+
+#include <vector>
+
+#include "Controls/physicsWorld.h"
+
+/**
+ * @brief      Steps a stack of pucks without a window and reports how the
+ *             step time scales with the number of threads.
+ * @details    The same scene, thousands of pucks dropped into a pit, is built
+ * and stepped once with the serial world and once with the multithreaded one
+ * for every thread count from 1 to the number of cores. Every run starts from
+ * the same state and steps the same ticks, so the runs only differ in the
+ * backend and the threads.
+ */
+class PhysicsBenchmark
+{
+public:
+    PhysicsBenchmark( int numBodies, int numSteps );
+
+    int run();
+
+private:
+    std::vector<double> stepTimes( PhysicsWorld::Backend backend,
+        int numThreads );
+
+    int m_numBodies;
+    int m_numSteps;
+};
+
+#endif  //  PHYSICS_BENCHMARK_H
@@ -0,0 +1,207 @@
+#include "physicsThread.h"
+
+#include <QtGlobal>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for PhysicsThread. The thread does not run until
+ *             started.
+ *
+ * @param      world      The world to step, with every body already in it.
+ * @param      registry   The registry of the bodies.
+ * @param[in]  timestep   The tick rate and the most ticks to run at once.
+ * @param[in]  speed      Simulated seconds per real second.
+ * @param[in]  afterStep  Run on the thread after every step, such as to test
+ *                        for contacts.
+ */
+PhysicsThread::PhysicsThread( btDynamicsWorld* world, EntityRegistry& registry,
+    const FixedTimestep& timestep, float speed,
+    std::function<void()> afterStep )
+    :   m_world( world ), m_afterStep( afterStep ), m_speed( speed ),
+        m_timestep( timestep ), m_paused( false ), m_stop( false )
+{
+    for( int i = 0; i < registry.Bodies.size(); i++ )
+    {
+        m_bodies.push_back( registry.Bodies[i].RigidBody );
+        m_states.push_back( registry.Bodies[i].State );
+    }
+
+    m_tickNanos = 1e9 * m_timestep.step() / m_speed;
+    m_clock.start();
+    publish();
+}
+
+/**
+ * @brief      Destructor for PhysicsThread. Stops the thread.
+ */
+PhysicsThread::~PhysicsThread()
+{
+    stop();
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Queues a command for the thread to carry out before its next
+ *             step. GUI thread only.
+ *
+ * @param[in]  command  The command.
+ *
+ * @return     False if the queue was full and the command was dropped.
+ */
+bool PhysicsThread::send( const Command& command )
+{
+    return m_commands.push( command );
+}
+
+/**
+ * @brief      Takes the next event the thread posted. GUI thread only.
+ *
+ * @param[out] event  The event.
+ *
+ * @return     False if there was none.
+ */
+bool PhysicsThread::receive( int& event )
+{
+    return m_events.pop( event );
+}
+
+/**
+ * @brief      Copies the latest published states into the registry's bodies,
+ *             and works out how far the frame is past them. GUI thread only.
+ *
+ * @param      registry  The registry of the bodies.
+ *
+ * @return     How far the frame is between the last two states, from 0 to 1,
+ *             for Systems::interpolateBodies.
+ */
+float PhysicsThread::read( EntityRegistry& registry )
+{
+    const bool updated = m_snapshots.update();
+    const Snapshot& snapshot = m_snapshots.front();
+    if( updated )
+    {
+        for( int i = 0; i < registry.Bodies.size(); i++ )
+            registry.Bodies[i].State = snapshot.States[i];
+    }
+
+    const double sinceTick = m_clock.nsecsElapsed() - snapshot.Time;
+    return qBound( 0.0f, float( sinceTick / m_tickNanos ), 1.0f );
+}
+
+/**
+ * @brief      Pauses or resumes the simulation. Time spent paused is not
+ *             caught up on. GUI thread only.
+ *
+ * @param[in]  paused  Whether to pause.
+ */
+void PhysicsThread::setPaused( bool paused )
+{
+    m_paused.store( paused );
+}
+
+/**
+ * @brief      Stops the thread and waits for it to finish its tick. The world
+ *             is the GUI thread's again afterwards.
+ */
+void PhysicsThread::stop()
+{
+    m_stop.store( true );
+    wait();
+}
+
+/**
+ * @brief      Posts an event for the GUI thread. Physics thread only.
+ *
+ * @param[in]  event  The event.
+ *
+ * @return     False if the queue was full and the event was dropped.
+ */
+bool PhysicsThread::post( int event )
+{
+    return m_events.push( event );
+}
+
+/**
+ * @brief      Resets a body's recorded states to where it is now, so a body
+ *             that was moved by hand is not drawn sliding there. Physics
+ *             thread only.
+ *
+ * @param[in]  body  The body, one of the registry's.
+ */
+void PhysicsThread::snap( const btRigidBody* body )
+{
+    for( size_t i = 0; i < m_bodies.size(); i++ )
+    {
+        if( m_bodies[i] == body )
+            m_states[i].reset( body->getWorldTransform() );
+    }
+}
+
+//
+// PROTECTED FUNCTIONS /////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Carries out the commands, runs the ticks that are due and
+ *             publishes the states, then sleeps until the next tick.
+ */
+void PhysicsThread::run()
+{
+    qint64 last = m_clock.nsecsElapsed();
+    while( !m_stop.load() )
+    {
+        const qint64 now = m_clock.nsecsElapsed();
+        const float dt = ( now - last ) / 1e9f;
+        last = now;
+
+        Command command;
+        while( m_commands.pop( command ) )
+            command.Body->setLinearVelocity( command.LinearVelocity );
+
+        // Consumed even while paused, so resuming does not catch up on it
+        if( !m_paused.load() )
+        {
+            const int ticks = m_timestep.advance( dt * m_speed );
+            for( int tick = 0; tick < ticks; tick++ )
+            {
+                m_world->stepSimulation( m_timestep.step(), 0 );
+
+                for( size_t i = 0; i < m_bodies.size(); i++ )
+                    m_states[i].record( m_bodies[i]->getWorldTransform() );
+
+                m_afterStep();
+            }
+
+            if( ticks > 0 )
+                publish();
+        }
+
+        const double untilTick = ( 1.0 - m_timestep.alpha() ) * m_tickNanos;
+        usleep( (unsigned long)qMax( 1.0, untilTick / 1e3 ) );
+    }
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Publishes the states of every body for the GUI thread.
+ */
+void PhysicsThread::publish()
+{
+    Snapshot& snapshot = m_snapshots.back();
+    snapshot.States = m_states;
+
+    // The clock is already past the latest state by what is left over in the
+    // accumulator
+    snapshot.Time = m_clock.nsecsElapsed() -
+        qint64( m_timestep.alpha() * m_tickNanos );
+    m_snapshots.publish();
+}
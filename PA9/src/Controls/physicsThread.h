@@ -0,0 +1,92 @@
+#ifndef PHYSICS_THREAD_H
+#define PHYSICS_THREAD_H
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "Controls/fixedTimestep.h"
+#include "Controls/spscQueue.h"
+#include "Controls/tripleBuffer.h"
+#include "Entity/entityRegistry.h"
+
+/**
+ * @brief      Steps a dynamics world on its own thread at a fixed tick.
+ * @details    Once started, the thread is the only one touching the world and
+ * its bodies. The GUI thread talks to it through three lock-free channels:
+ * commands for the bodies go in through one queue, events the thread raises,
+ * such as a goal, come back through another, and after every batch of ticks
+ * the last two states of every body are published through a triple buffer.
+ * The GUI thread reads the latest states into the registry and draws between
+ * them, so a slow step never holds up input or painting, and drawing and
+ * stepping run side by side on separate cores.
+ *
+ * The registry's bodies must not be added or removed while the thread runs.
+ */
+class PhysicsThread :   public QThread
+{
+public:
+    // Sets a body's linear velocity before the next step
+    struct Command
+    {
+        btRigidBody* Body;
+        btVector3 LinearVelocity;
+    };
+
+    PhysicsThread( btDynamicsWorld* world, EntityRegistry& registry,
+        const FixedTimestep& timestep, float speed,
+        std::function<void()> afterStep );
+    ~PhysicsThread();
+
+    // GUI thread
+    bool send( const Command& command );
+    bool receive( int& event );
+    float read( EntityRegistry& registry );
+    void setPaused( bool paused );
+    void stop();
+
+    // Physics thread, from afterStep
+    bool post( int event );
+    void snap( const btRigidBody* body );
+
+protected:
+    void run();
+
+private:
+    // States of every body, in the order of the registry's bodies
+    struct Snapshot
+    {
+        std::vector<PhysicsState> States;
+
+        // When the latest state was stepped to, on m_clock
+        qint64 Time;
+    };
+
+    void publish();
+
+    btDynamicsWorld* m_world;
+    std::vector<btRigidBody*> m_bodies;
+    std::vector<PhysicsState> m_states;
+    std::function<void()> m_afterStep;
+
+    // Simulated seconds per real second, and real nanoseconds per tick
+    float m_speed;
+    double m_tickNanos;
+    FixedTimestep m_timestep;
+    QElapsedTimer m_clock;
+
+    // Channels between the threads
+    SpscQueue<Command, 256> m_commands;
+    SpscQueue<int, 64> m_events;
+    TripleBuffer<Snapshot> m_snapshots;
+
+    std::atomic<bool> m_paused;
+    std::atomic<bool> m_stop;
+};
+
+#endif  //  PHYSICS_THREAD_H
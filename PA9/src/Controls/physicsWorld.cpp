@@ -0,0 +1,86 @@
+#include "physicsWorld.h"
+
+#include "Controls/taskScheduler.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for PhysicsWorld. Builds an empty world without
+ *             gravity.
+ *
+ * @param[in]  backend     Whether to step the world on one thread or many.
+ * @param[in]  numThreads  The number of threads of the multithreaded backend,
+ *                         0 for every core. Every multithreaded world shares
+ *                         TaskScheduler's threads, so the last one built sets
+ *                         it; the rest of the game's jobs are not limited.
+ */
+PhysicsWorld::PhysicsWorld( Backend backend, int numThreads )
+    :   m_backend( backend ), m_solver( NULL ), m_solverPool( NULL )
+{
+    m_broadphase = new btDbvtBroadphase();
+    m_collisionConfig = new btDefaultCollisionConfiguration();
+
+    if( m_backend == Serial )
+    {
+        m_dispatcher = new btCollisionDispatcher( m_collisionConfig );
+        m_solver = new btSequentialImpulseConstraintSolver();
+        m_world = new btDiscreteDynamicsWorld( m_dispatcher, m_broadphase,
+            m_solver, m_collisionConfig );
+        return;
+    }
+
+    // Bullet has to be given the scheduler on the GUI thread, before any other
+    // thread calls into it
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    scheduler.setNumThreads( numThreads > 0 ? numThreads :
+        scheduler.getMaxNumThreads() );
+    btSetTaskScheduler( &scheduler );
+
+    // One solver per thread, so every thread can solve an island at once. The
+    // dispatcher sizes its batches to every thread Bullet may number
+    m_dispatcher = new btCollisionDispatcherMt( m_collisionConfig );
+    m_solverPool = new btConstraintSolverPoolMt(
+        scheduler.getMaxNumThreads() );
+    m_world = new btDiscreteDynamicsWorldMt( m_dispatcher, m_broadphase,
+        m_solverPool, NULL, m_collisionConfig );
+}
+
+/**
+ * @brief      Destructor for PhysicsWorld. The bodies in the world are not
+ *             freed, and have to be removed first.
+ */
+PhysicsWorld::~PhysicsWorld()
+{
+    delete m_world;
+    delete m_solver;
+    delete m_solverPool;
+    delete m_dispatcher;
+    delete m_collisionConfig;
+    delete m_broadphase;
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the dynamics world.
+ *
+ * @return     The world.
+ */
+btDiscreteDynamicsWorld* PhysicsWorld::world() const
+{
+    return m_world;
+}
+
+/**
+ * @brief      Gets which backend the world was built with.
+ *
+ * @return     The backend.
+ */
+PhysicsWorld::Backend PhysicsWorld::backend() const
+{
+    return m_backend;
+}
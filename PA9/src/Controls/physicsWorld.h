@@ -0,0 +1,48 @@
+#ifndef PHYSICS_WORLD_H
+#define PHYSICS_WORLD_H
+
+#include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+
+/**
+ * @brief      A dynamics world and everything it is built from.
+ * @details    The serial backend is the usual btDiscreteDynamicsWorld. The
+ * multithreaded one is btDiscreteDynamicsWorldMt, with a collision dispatcher
+ * finding contacts in parallel and a pool of solvers solving the simulation
+ * islands in parallel, both running on the shared TaskScheduler. Either
+ * backend is stepped and filled the same way.
+ *
+ * The multithreaded backend needs Bullet built with BT_THREADSAFE, without it
+ * Bullet runs every parallel loop serially.
+ */
+class PhysicsWorld
+{
+public:
+    enum Backend
+    {
+        Serial,
+        Multithreaded
+    };
+
+    PhysicsWorld( Backend backend = Serial, int numThreads = 0 );
+    ~PhysicsWorld();
+
+    btDiscreteDynamicsWorld* world() const;
+    Backend backend() const;
+
+private:
+    Backend m_backend;
+
+    btBroadphaseInterface* m_broadphase;
+    btDefaultCollisionConfiguration* m_collisionConfig;
+    btCollisionDispatcher* m_dispatcher;
+
+    // Only one of the two is used, depending on the backend
+    btSequentialImpulseConstraintSolver* m_solver;
+    btConstraintSolverPoolMt* m_solverPool;
+
+    btDiscreteDynamicsWorld* m_world;
+};
+
+#endif  //  PHYSICS_WORLD_H
@@ -0,0 +1,83 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+
+/**
+ * @brief      Fixed size queue from one thread to another, without locking.
+ * @details    A ring buffer where only the producer moves the tail and only
+ * the consumer moves the head, so each index has a single writer and a push
+ * or pop is one atomic store. Pushing to a full queue fails rather than
+ * waiting.
+ *
+ * Exactly one thread may push and one thread may pop. CAPACITY must be a
+ * power of two.
+ */
+template <typename T, unsigned CAPACITY>
+class SpscQueue
+{
+public:
+    SpscQueue();
+
+    bool push( const T& item );
+    bool pop( T& item );
+
+private:
+    static_assert( ( CAPACITY & ( CAPACITY - 1 ) ) == 0,
+        "The capacity must be a power of two" );
+
+    T m_items[CAPACITY];
+
+    // Free running, wrapped into the ring when indexing
+    std::atomic<unsigned> m_head;
+    std::atomic<unsigned> m_tail;
+};
+
+/**
+ * @brief      Constructor for SpscQueue. The queue starts empty.
+ */
+template <typename T, unsigned CAPACITY>
+SpscQueue<T, CAPACITY>::SpscQueue()
+    :   m_head( 0 ), m_tail( 0 )
+{
+}
+
+/**
+ * @brief      Adds an item to the back of the queue. Producer only.
+ *
+ * @param[in]  item  The item.
+ *
+ * @return     False if the queue was full and the item was dropped.
+ */
+template <typename T, unsigned CAPACITY>
+bool SpscQueue<T, CAPACITY>::push( const T& item )
+{
+    const unsigned tail = m_tail.load( std::memory_order_relaxed );
+    if( tail - m_head.load( std::memory_order_acquire ) == CAPACITY )
+        return false;
+
+    m_items[ tail & ( CAPACITY - 1 ) ] = item;
+    m_tail.store( tail + 1, std::memory_order_release );
+    return true;
+}
+
+/**
+ * @brief      Takes the item at the front of the queue. Consumer only.
+ *
+ * @param[out] item  The item.
+ *
+ * @return     False if the queue was empty.
+ */
+template <typename T, unsigned CAPACITY>
+bool SpscQueue<T, CAPACITY>::pop( T& item )
+{
+    const unsigned head = m_head.load( std::memory_order_relaxed );
+    if( head == m_tail.load( std::memory_order_acquire ) )
+        return false;
+
+    item = m_items[ head & ( CAPACITY - 1 ) ];
+    m_head.store( head + 1, std::memory_order_release );
+    return true;
+}
+
+#endif  //  SPSC_QUEUE_H
@@ -0,0 +1,113 @@
+#include "taskScheduler.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the scheduler shared by every dynamics world, with a
+ *             thread for every core.
+ *
+ * @return     The scheduler.
+ */
+TaskScheduler& TaskScheduler::instance()
+{
+    static TaskScheduler scheduler( QThread::idealThreadCount() );
+    return scheduler;
+}
+
+/**
+ * @brief      Constructor for TaskScheduler. Starts its workers.
+ *
+ * @param[in]  maxThreads  The most threads to run loops on, the stepping
+ *                         thread included.
+ */
+TaskScheduler::TaskScheduler( int maxThreads )
+    :   btITaskScheduler( "JobSystem" ), m_jobs( maxThreads, 1 )
+{
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the most threads loops can run on.
+ *
+ * @return     The number of workers and the stepping thread.
+ */
+int TaskScheduler::getMaxNumThreads() const
+{
+    return m_jobs.maxThreads();
+}
+
+/**
+ * @brief      Gets how many threads Bullet may see run its code, which it
+ *             sizes its per-thread data to. This does not drop with
+ *             setNumThreads, as a worker keeps its number once it has one.
+ *
+ * @return     The number of workers and the threads outside the pool.
+ */
+int TaskScheduler::getNumThreads() const
+{
+    return m_jobs.maxThreads() - 1 + OUTSIDE_THREADS;
+}
+
+/**
+ * @brief      Sets how many threads loops run on, the stepping thread
+ *             included. Only Bullet's loops are limited, 1 runs them on the
+ *             stepping thread alone.
+ *
+ * @param[in]  numThreads  The number of threads, clamped to what there is.
+ */
+void TaskScheduler::setNumThreads( int numThreads )
+{
+    m_jobs.setNumThreads( numThreads );
+}
+
+/**
+ * @brief      Runs a loop across the active threads and returns once all of
+ *             it is done.
+ *
+ * @param[in]  iBegin     The first index of the loop.
+ * @param[in]  iEnd       One past the last index of the loop.
+ * @param[in]  grainSize  About how many indices to run at once.
+ * @param[in]  body       The body of the loop.
+ */
+void TaskScheduler::parallelFor( int iBegin, int iEnd, int grainSize,
+    const btIParallelForBody& body )
+{
+    m_jobs.parallelFor( iBegin, iEnd, grainSize, [&body]( int begin, int end ){
+        body.forLoop( begin, end );
+    } );
+}
+
+/**
+ * @brief      Runs a loop across the active threads and adds up what each
+ *             range of it returns.
+ *
+ * @param[in]  iBegin     The first index of the loop.
+ * @param[in]  iEnd       One past the last index of the loop.
+ * @param[in]  grainSize  About how many indices to run at once.
+ * @param[in]  body       The body of the loop.
+ *
+ * @return     The sum of every range.
+ */
+btScalar TaskScheduler::parallelSum( int iBegin, int iEnd, int grainSize,
+    const btIParallelSumBody& body )
+{
+    QMutex mutex;
+    btScalar sum = 0;
+    m_jobs.parallelFor( iBegin, iEnd, grainSize, [&]( int begin, int end ){
+        const btScalar partial = body.sumLoop( begin, end );
+
+        QMutexLocker locker( &mutex );
+        sum += partial;
+    } );
+
+    return sum;
+}
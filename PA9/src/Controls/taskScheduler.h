@@ -0,0 +1,48 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <LinearMath/btThreads.h>
+
+#include "Controls/jobSystem.h"
+
+/**
+ * @brief      Runs Bullet's parallel loops on a JobSystem of their own.
+ * @details    Bullet's multithreaded world runs several short loops per step,
+ * finding contacts, solving islands and integrating bodies. Each one becomes a
+ * parallelFor on the scheduler's job system, which only its own workers and
+ * the thread stepping the world take tasks from.
+ *
+ * Bullet numbers every thread the first time it runs Bullet's code, and sizes
+ * per-thread data such as the collision dispatcher's manifold batches to
+ * getNumThreads when it is built. The game's job system is shared with
+ * culling, entity updates and asset decoding, whose waiting threads would get
+ * numbers past the end. Here only the workers, the GUI thread giving Bullet
+ * the scheduler and the stepping thread ever run Bullet's code, so
+ * getNumThreads reports all of them, however many take part. setNumThreads
+ * limits the loops without throttling the rest of the game.
+ */
+class TaskScheduler :   public btITaskScheduler
+{
+public:
+    static TaskScheduler& instance();
+
+    TaskScheduler( int maxThreads );
+
+    // btITaskScheduler
+    int getMaxNumThreads() const;
+    int getNumThreads() const;
+    void setNumThreads( int numThreads );
+    void parallelFor( int iBegin, int iEnd, int grainSize,
+        const btIParallelForBody& body );
+    btScalar parallelSum( int iBegin, int iEnd, int grainSize,
+        const btIParallelSumBody& body );
+
+private:
+    // Threads outside the pool Bullet numbers: the GUI thread, which gives
+    // Bullet the scheduler, and the physics thread stepping the world
+    enum { OUTSIDE_THREADS = 2 };
+
+    JobSystem m_jobs;
+};
+
+#endif  //  TASK_SCHEDULER_H
@@ -0,0 +1,101 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+/**
+ * @brief      Hands the latest of a stream of values from one thread to
+ *             another without locking.
+ * @details    The writer fills the back buffer and publishes it, the reader
+ * takes the latest published buffer as its front one. The third buffer sits
+ * between them and is only ever swapped atomically, so neither thread waits
+ * on the other or sees a half written value. Values the reader did not get to
+ * in time are overwritten, only the latest one matters.
+ *
+ * Exactly one thread may write and one thread may read.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer();
+
+    // Writer
+    T& back();
+    void publish();
+
+    // Reader
+    bool update();
+    T& front();
+
+private:
+    // Set on the middle index while it holds a value the reader has not taken
+    enum { INDEX = 3, FRESH = 4 };
+
+    T m_buffers[3];
+    std::atomic<int> m_middle;
+    int m_back;
+    int m_front;
+};
+
+/**
+ * @brief      Constructor for TripleBuffer. Every buffer starts value
+ *             initialized, and none is fresh.
+ */
+template <typename T>
+TripleBuffer<T>::TripleBuffer()
+    :   m_buffers(), m_middle( 1 ), m_back( 0 ), m_front( 2 )
+{
+}
+
+/**
+ * @brief      Gets the buffer to write the next value to. Writer only.
+ *
+ * @return     The back buffer.
+ */
+template <typename T>
+T& TripleBuffer<T>::back()
+{
+    return m_buffers[m_back];
+}
+
+/**
+ * @brief      Publishes the back buffer, and takes the middle one to write
+ *             the next value to. Writer only.
+ */
+template <typename T>
+void TripleBuffer<T>::publish()
+{
+    m_back = m_middle.exchange( m_back | FRESH, std::memory_order_acq_rel ) &
+        INDEX;
+}
+
+/**
+ * @brief      Takes the latest published value as the front buffer, if there
+ *             is one the reader has not taken yet. Reader only.
+ *
+ * @return     True if the front buffer changed.
+ */
+template <typename T>
+bool TripleBuffer<T>::update()
+{
+    if( !( m_middle.load( std::memory_order_acquire ) & FRESH ) )
+        return false;
+
+    m_front = m_middle.exchange( m_front, std::memory_order_acq_rel ) & INDEX;
+    return true;
+}
+
+/**
+ * @brief      Gets the value last taken by update. Reader only, and the reader
+ *             may change it until its next update.
+ *
+ * @return     The front buffer.
+ */
+template <typename T>
+T& TripleBuffer<T>::front()
+{
+    return m_buffers[m_front];
+}
+
+#endif  //  TRIPLE_BUFFER_H
@@ -0,0 +1,198 @@
+#ifndef COMPONENT_ARRAY_H
+#define COMPONENT_ARRAY_H
+
+#include <QtGlobal>
+
+#include <vector>
+
+/**
+ * @brief      Packed storage of one kind of component, as a sparse set.
+ * @details    Components sit back to back in one array whatever entities they
+ * belong to, so a system walks them in order without skipping over entities
+ * that lack them. A second array maps each entity index to its component's
+ * slot, so finding an entity's component is a single lookup. Removing a
+ * component moves the last one into its slot, which keeps the array packed
+ * but changes the order, so slots must not be held onto across a removal.
+ */
+template <typename T>
+class ComponentArray
+{
+public:
+    T& add( quint32 entity, const T& component );
+    void remove( quint32 entity );
+    void clear();
+
+    bool has( quint32 entity ) const;
+    T* find( quint32 entity );
+    const T* find( quint32 entity ) const;
+
+    // Packed access, in no particular order
+    int size() const;
+    T& operator[]( int slot );
+    const T& operator[]( int slot ) const;
+    quint32 entityAt( int slot ) const;
+
+private:
+    // Slot of each entity index, or NO_SLOT
+    enum { NO_SLOT = -1 };
+    std::vector<int> m_slots;
+
+    // Components and the entity index of each
+    std::vector<T> m_components;
+    std::vector<quint32> m_entities;
+};
+
+/**
+ * @brief      Adds a component to an entity, replacing the one it had.
+ *
+ * @param[in]  entity     The entity index.
+ * @param[in]  component  The component.
+ *
+ * @return     The stored component.
+ */
+template <typename T>
+T& ComponentArray<T>::add( quint32 entity, const T& component )
+{
+    if( entity >= m_slots.size() )
+        m_slots.resize( entity + 1, NO_SLOT );
+
+    int& slot = m_slots[entity];
+    if( slot != NO_SLOT )
+    {
+        m_components[slot] = component;
+        return m_components[slot];
+    }
+
+    slot = m_components.size();
+    m_components.push_back( component );
+    m_entities.push_back( entity );
+    return m_components.back();
+}
+
+/**
+ * @brief      Removes an entity's component, if it has one. The last
+ *             component is moved into its slot.
+ *
+ * @param[in]  entity  The entity index.
+ */
+template <typename T>
+void ComponentArray<T>::remove( quint32 entity )
+{
+    if( !has( entity ) )
+        return;
+
+    const int slot = m_slots[entity];
+    const int last = m_components.size() - 1;
+    if( slot != last )
+    {
+        m_components[slot] = m_components[last];
+        m_entities[slot] = m_entities[last];
+        m_slots[ m_entities[slot] ] = slot;
+    }
+
+    m_components.pop_back();
+    m_entities.pop_back();
+    m_slots[entity] = NO_SLOT;
+}
+
+/**
+ * @brief      Removes every component.
+ */
+template <typename T>
+void ComponentArray<T>::clear()
+{
+    m_slots.clear();
+    m_components.clear();
+    m_entities.clear();
+}
+
+/**
+ * @brief      Checks if an entity has a component.
+ *
+ * @param[in]  entity  The entity index.
+ *
+ * @return     True if it has one.
+ */
+template <typename T>
+bool ComponentArray<T>::has( quint32 entity ) const
+{
+    return entity < m_slots.size() && m_slots[entity] != NO_SLOT;
+}
+
+/**
+ * @brief      Finds an entity's component.
+ *
+ * @param[in]  entity  The entity index.
+ *
+ * @return     The component, or NULL if the entity has none.
+ */
+template <typename T>
+T* ComponentArray<T>::find( quint32 entity )
+{
+    return has( entity ) ? &m_components[ m_slots[entity] ] : NULL;
+}
+
+/**
+ * @brief      Finds an entity's component.
+ *
+ * @param[in]  entity  The entity index.
+ *
+ * @return     The component, or NULL if the entity has none.
+ */
+template <typename T>
+const T* ComponentArray<T>::find( quint32 entity ) const
+{
+    return has( entity ) ? &m_components[ m_slots[entity] ] : NULL;
+}
+
+/**
+ * @brief      Gets the number of components.
+ *
+ * @return     The number of entities with the component.
+ */
+template <typename T>
+int ComponentArray<T>::size() const
+{
+    return m_components.size();
+}
+
+/**
+ * @brief      Gets a component by its slot.
+ *
+ * @param[in]  slot  The slot, from 0 to size().
+ *
+ * @return     The component.
+ */
+template <typename T>
+T& ComponentArray<T>::operator[]( int slot )
+{
+    return m_components[slot];
+}
+
+/**
+ * @brief      Gets a component by its slot.
+ *
+ * @param[in]  slot  The slot, from 0 to size().
+ *
+ * @return     The component.
+ */
+template <typename T>
+const T& ComponentArray<T>::operator[]( int slot ) const
+{
+    return m_components[slot];
+}
+
+/**
+ * @brief      Gets the entity a slot's component belongs to.
+ *
+ * @param[in]  slot  The slot, from 0 to size().
+ *
+ * @return     The entity index.
+ */
+template <typename T>
+quint32 ComponentArray<T>::entityAt( int slot ) const
+{
+    return m_entities[slot];
+}
+
+#endif  //  COMPONENT_ARRAY_H
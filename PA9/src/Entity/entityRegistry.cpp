@@ -0,0 +1,524 @@
+#include "entityRegistry.h"
+
+#include <QFileInfo>
+#include <QUrl>
+
+#include "3D/modelLoader.h"
+
+//
+// COMPONENTS //////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for Entity. A default handle refers to no entity.
+ */
+EntityRegistry::Entity::Entity()
+    :   Index( 0xFFFFFFFF ), Generation( 0 )
+{
+}
+
+/**
+ * @brief      Constructor for Model.
+ */
+EntityRegistry::Model::Model()
+    :   DrawPass( RenderQueue::Opaque ), CullFace( GL_NONE ), VAO( NULL ),
+        ModelClip( -1 )
+{
+}
+
+/**
+ * @brief      Constructor for Body.
+ *
+ * @param[in]  startingState  The starting location and rotation of the body.
+ */
+EntityRegistry::Body::Body( const btTransform& startingState )
+    :   RigidBody( NULL ), Shape( NULL ), MotionState( NULL ), TriMesh( NULL ),
+        Group( btBroadphaseProxy::DefaultFilter ),
+        Mask( btBroadphaseProxy::AllFilter ), State( startingState )
+{
+}
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for EntityRegistry.
+ */
+EntityRegistry::EntityRegistry()
+    :   m_initialized( false )
+{
+}
+
+/**
+ * @brief      Destructor for EntityRegistry. Frees the bodies and sounds, which
+ *             must already be out of any dynamics world. The GL data must
+ *             already be torn down.
+ */
+EntityRegistry::~EntityRegistry()
+{
+    for( int i = 0; i < Bodies.size(); i++ )
+        releaseBody( Bodies[i] );
+
+    for( int i = 0; i < Sounds.size(); i++ )
+        delete Sounds[i].Player;
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Creates an entity with no components, reusing a free index when
+ *             there is one.
+ *
+ * @return     The handle of the entity.
+ */
+EntityRegistry::Entity EntityRegistry::create()
+{
+    Entity entity;
+    if( m_free.empty() )
+    {
+        entity.Index = m_generations.size();
+        m_generations.push_back( 1 );
+    }
+    else
+    {
+        entity.Index = m_free.back();
+        m_free.pop_back();
+    }
+    entity.Generation = m_generations[entity.Index];
+
+    return entity;
+}
+
+/**
+ * @brief      Destroys an entity along with its components. Its body must
+ *             already be out of any dynamics world, and a model needs a
+ *             current context to be released.
+ *
+ * @param[in]  entity  The entity to destroy.
+ */
+void EntityRegistry::destroy( Entity entity )
+{
+    if( !isAlive( entity ) )
+        return;
+
+    if( Model* found = Models.find( entity.Index ) )
+        teardownModel( *found );
+    if( Body* found = Bodies.find( entity.Index ) )
+        releaseBody( *found );
+    if( Sound* found = Sounds.find( entity.Index ) )
+        delete found->Player;
+
+    Transforms.remove( entity.Index );
+    Models.remove( entity.Index );
+    Bodies.remove( entity.Index );
+    Sounds.remove( entity.Index );
+
+    // Outdates every handle to the entity
+    m_generations[entity.Index]++;
+    m_free.push_back( entity.Index );
+}
+
+/**
+ * @brief      Checks if a handle still refers to an entity.
+ *
+ * @param[in]  entity  The handle.
+ *
+ * @return     True if the entity has not been destroyed.
+ */
+bool EntityRegistry::isAlive( Entity entity ) const
+{
+    return entity.Index < m_generations.size() &&
+        m_generations[entity.Index] == entity.Generation;
+}
+
+/**
+ * @brief      Gets the number of entities.
+ *
+ * @return     The number of entities alive.
+ */
+int EntityRegistry::size() const
+{
+    return m_generations.size() - m_free.size();
+}
+
+/**
+ * @brief      Places an entity.
+ *
+ * @param[in]  entity        The entity.
+ * @param[in]  modelToWorld  Where the entity is drawn.
+ *
+ * @return     The component.
+ */
+EntityRegistry::Transform& EntityRegistry::addTransform( Entity entity,
+    const QMatrix4x4& modelToWorld )
+{
+    Transform transform;
+    transform.ModelToWorld = modelToWorld;
+    return Transforms.add( entity.Index, transform );
+}
+
+/**
+ * @brief      Gives an entity a material-based model to draw.
+ *
+ * @param[in]  entity     The entity.
+ * @param[in]  modelPath  The path to the model.
+ *
+ * @return     The component.
+ */
+EntityRegistry::Model& EntityRegistry::addColorModel( Entity entity,
+    const QString& modelPath )
+{
+    Model model;
+    model.ModelPath = modelPath;
+    model.PendingColor = ResourceCache::colorMesh( modelPath );
+    model.Box = model.PendingColor->Box;
+    model.CullFace = model.PendingColor->CullFace;
+
+    if( Model* found = Models.find( entity.Index ) )
+        teardownModel( *found );
+    Model& added = Models.add( entity.Index, model );
+    if( m_initialized )
+        initializeModel( added );
+
+    return added;
+}
+
+/**
+ * @brief      Gives an entity a textured model to draw.
+ *
+ * @param[in]  entity       The entity.
+ * @param[in]  modelPath    The path to the model.
+ * @param[in]  texturePath  The path to the texture.
+ *
+ * @return     The component.
+ */
+EntityRegistry::Model& EntityRegistry::addUVModel( Entity entity,
+    const QString& modelPath, const QString& texturePath )
+{
+    Model model;
+    model.ModelPath = modelPath;
+    model.TexturePath = texturePath;
+    model.PendingUV = ResourceCache::uvMesh( modelPath );
+    model.Box = model.PendingUV->Box;
+    model.CullFace = model.PendingUV->CullFace;
+
+    if( Model* found = Models.find( entity.Index ) )
+        teardownModel( *found );
+    Model& added = Models.add( entity.Index, model );
+    if( m_initialized )
+        initializeModel( added );
+
+    return added;
+}
+
+/**
+ * @brief      Gives an entity a body shaped like a model. Static bodies are
+ *             kinematic triangle meshes, dynamic ones convex hulls.
+ *
+ * @param[in]  entity         The entity.
+ * @param[in]  modelPath      The path to the material-based model.
+ * @param[in]  startingState  The location and rotation of the body.
+ * @param[in]  mass           The mass of the body, 0 for a static one.
+ *
+ * @return     The component.
+ */
+EntityRegistry::Body& EntityRegistry::addMeshBody( Entity entity,
+    const QString& modelPath, const btTransform& startingState,
+    btScalar mass )
+{
+    Body body( startingState );
+
+    // Collide against the mesh the model already loaded instead of reimporting
+    body.Mesh = ResourceCache::colorMesh( modelPath );
+    body.TriMesh = ModelLoader::createTriMesh( *body.Mesh );
+
+    if( mass == 0 )
+        body.Shape = new btBvhTriangleMeshShape( body.TriMesh, true );
+    else
+        body.Shape = new btConvexTriangleMeshShape( body.TriMesh );
+
+    btVector3 inertia( 0, 0, 0 );
+    body.Shape->calculateLocalInertia( mass, inertia );
+    body.MotionState = new btDefaultMotionState( startingState );
+
+    btRigidBody::btRigidBodyConstructionInfo rigidBodyCI( mass,
+        body.MotionState, body.Shape, inertia );
+    rigidBodyCI.m_restitution = 0.95f;
+    body.RigidBody = new btRigidBody( rigidBodyCI );
+
+    if( mass == 0 )
+    {
+        body.RigidBody->setCollisionFlags( body.RigidBody->getCollisionFlags() |
+            btCollisionObject::CF_KINEMATIC_OBJECT );
+        body.RigidBody->setActivationState( DISABLE_DEACTIVATION );
+    }
+
+    if( Body* found = Bodies.find( entity.Index ) )
+        releaseBody( *found );
+    return Bodies.add( entity.Index, body );
+}
+
+/**
+ * @brief      Gives an entity a static box body.
+ *
+ * @param[in]  entity         The entity.
+ * @param[in]  halfExtents    Half the size of the box.
+ * @param[in]  startingState  The location and rotation of the box.
+ *
+ * @return     The component.
+ */
+EntityRegistry::Body& EntityRegistry::addBoxBody( Entity entity,
+    const btVector3& halfExtents, const btTransform& startingState )
+{
+    return addShapeBody( entity, new btBoxShape( halfExtents ), startingState,
+        0 );
+}
+
+/**
+ * @brief      Gives an entity a body of a primitive shape, static when it has
+ *             no mass.
+ *
+ * @param[in]  entity         The entity.
+ * @param      shape          The shape of the body, owned by the registry
+ *                            from here on.
+ * @param[in]  startingState  The location and rotation of the body.
+ * @param[in]  mass           The mass of the body.
+ *
+ * @return     The component.
+ */
+EntityRegistry::Body& EntityRegistry::addShapeBody( Entity entity,
+    btCollisionShape* shape, const btTransform& startingState,
+    btScalar mass )
+{
+    Body body( startingState );
+    body.Shape = shape;
+    body.MotionState = new btDefaultMotionState( startingState );
+
+    btVector3 inertia( 0, 0, 0 );
+    if( mass != 0 )
+        body.Shape->calculateLocalInertia( mass, inertia );
+
+    btRigidBody::btRigidBodyConstructionInfo rigidBodyCI( mass,
+        body.MotionState, body.Shape, inertia );
+    body.RigidBody = new btRigidBody( rigidBodyCI );
+
+    if( Body* found = Bodies.find( entity.Index ) )
+        releaseBody( *found );
+    return Bodies.add( entity.Index, body );
+}
+
+/**
+ * @brief      Gives an entity a sound, which starts playing right away.
+ *
+ * @param[in]  entity     The entity.
+ * @param[in]  soundPath  The path to the sound.
+ * @param[in]  volume     The volume of the sound.
+ * @param[in]  loop       Whether the sound starts over when it ends.
+ *
+ * @return     The component.
+ */
+EntityRegistry::Sound& EntityRegistry::addSound( Entity entity,
+    const QString& soundPath, int volume, bool loop )
+{
+    Sound sound;
+    sound.Player = new QMediaPlayer();
+    sound.Player->setMedia( QUrl::fromLocalFile(
+        QFileInfo( soundPath ).absoluteFilePath() ) );
+    sound.Player->setVolume( volume );
+    sound.Player->play();
+    sound.Loop = loop;
+
+    if( Sound* found = Sounds.find( entity.Index ) )
+        delete found->Player;
+    return Sounds.add( entity.Index, sound );
+}
+
+/**
+ * @brief      Finds an entity's transform.
+ *
+ * @param[in]  entity  The entity.
+ *
+ * @return     The component, or NULL if there is none.
+ */
+EntityRegistry::Transform* EntityRegistry::transform( Entity entity )
+{
+    return isAlive( entity ) ? Transforms.find( entity.Index ) : NULL;
+}
+
+/**
+ * @brief      Finds an entity's model.
+ *
+ * @param[in]  entity  The entity.
+ *
+ * @return     The component, or NULL if there is none.
+ */
+EntityRegistry::Model* EntityRegistry::model( Entity entity )
+{
+    return isAlive( entity ) ? Models.find( entity.Index ) : NULL;
+}
+
+/**
+ * @brief      Finds an entity's body.
+ *
+ * @param[in]  entity  The entity.
+ *
+ * @return     The component, or NULL if there is none.
+ */
+EntityRegistry::Body* EntityRegistry::body( Entity entity )
+{
+    return isAlive( entity ) ? Bodies.find( entity.Index ) : NULL;
+}
+
+/**
+ * @brief      Finds an entity's sound.
+ *
+ * @param[in]  entity  The entity.
+ *
+ * @return     The component, or NULL if there is none.
+ */
+EntityRegistry::Sound* EntityRegistry::sound( Entity entity )
+{
+    return isAlive( entity ) ? Sounds.find( entity.Index ) : NULL;
+}
+
+/**
+ * @brief      Uploads every model. Models added afterwards are uploaded as
+ *             they are added.
+ */
+void EntityRegistry::initializeGL()
+{
+    for( int i = 0; i < Models.size(); i++ )
+        initializeModel( Models[i] );
+
+    m_initialized = true;
+}
+
+/**
+ * @brief      Releases the OpenGL data of every model.
+ */
+void EntityRegistry::teardownGL()
+{
+    for( int i = 0; i < Models.size(); i++ )
+        teardownModel( Models[i] );
+
+    m_initialized = false;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Initializes the OpenGL data for drawing a model.
+ *
+ * @param      model  The model to upload.
+ */
+void EntityRegistry::initializeModel( Model& model )
+{
+    const bool textured = !model.TexturePath.isEmpty();
+
+    // Get the shader this model will use
+    if( textured )
+        model.Program = ResourceCache::program( PATH_TO_UV_V_SHADER,
+            PATH_TO_UV_F_SHADER );
+    else
+        model.Program = ResourceCache::program( PATH_TO_COLOR_V_SHADER,
+            PATH_TO_COLOR_F_SHADER );
+    model.Program->bind();
+
+    // Cache the Uniform Location
+    model.ModelClip = model.Program->uniformLocation( "model_to_clip" );
+
+    // Get the Texture, Vertex and Index Buffer Objects
+    if( textured )
+    {
+        model.Texture = ResourceCache::texture( model.TexturePath );
+        model.Buffers = ResourceCache::uvBuffers( model.ModelPath );
+    }
+    else
+        model.Buffers = ResourceCache::colorBuffers( model.ModelPath );
+    model.Buffers->Vertices.bind();
+
+    // Create the Vertex Array Object, bound while it records the buffers
+    model.VAO = new QOpenGLVertexArrayObject();
+    model.VAO->create();
+    model.VAO->bind();
+    model.Buffers->Indices.bind();
+
+    model.Program->enableAttributeArray( 0 );
+    model.Program->enableAttributeArray( 1 );
+    if( textured )
+    {
+        model.Program->setAttributeBuffer(  0,
+                                            GL_FLOAT,
+                                            UVVertex::positionOffset(),
+                                            UVVertex::PositionTupleSize,
+                                            UVVertex::stride() );
+        model.Program->setAttributeBuffer(  1,
+                                            GL_FLOAT,
+                                            UVVertex::uvOffset(),
+                                            UVVertex::UVTupleSize,
+                                            UVVertex::stride() );
+    }
+    else
+    {
+        model.Program->setAttributeBuffer(  0,
+                                            GL_FLOAT,
+                                            ColorVertex::positionOffset(),
+                                            ColorVertex::PositionTupleSize,
+                                            ColorVertex::stride() );
+        model.Program->setAttributeBuffer(  1,
+                                            GL_FLOAT,
+                                            ColorVertex::colorOffset(),
+                                            ColorVertex::ColorTupleSize,
+                                            ColorVertex::stride() );
+    }
+
+    // Release all in order
+    model.VAO->release();
+    model.Buffers->Indices.release();
+    model.Buffers->Vertices.release();
+    model.Program->release();
+
+    // The GPU owns the geometry now, bodies hold on to what they collide with
+    model.PendingUV.clear();
+    model.PendingColor.clear();
+}
+
+/**
+ * @brief      Deletes the OpenGL data of a model.
+ *
+ * @param      model  The model to release.
+ */
+void EntityRegistry::teardownModel( Model& model )
+{
+    delete model.VAO;
+    model.VAO = NULL;
+
+    // Shared resources are freed once their last user lets go of them
+    model.Buffers.clear();
+    model.Program.clear();
+    model.Texture.clear();
+}
+
+/**
+ * @brief      Frees what a body owns.
+ *
+ * @param      body  The body to free.
+ */
+void EntityRegistry::releaseBody( Body& body )
+{
+    delete body.RigidBody;
+    delete body.MotionState;
+    delete body.Shape;
+    delete body.TriMesh;
+    body.Mesh.clear();
+
+    body.RigidBody = NULL;
+    body.MotionState = NULL;
+    body.Shape = NULL;
+    body.TriMesh = NULL;
+}
@@ -0,0 +1,163 @@
+#ifndef ENTITY_REGISTRY_H
+#define ENTITY_REGISTRY_H
+
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QOpenGLVertexArrayObject>
+
+#include <QMatrix4x4>
+#include <QMediaPlayer>
+#include <QSharedPointer>
+#include <QString>
+
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "3D/bounds.h"
+#include "3D/colorVertex.h"
+#include "3D/renderQueue.h"
+#include "3D/resourceCache.h"
+#include "3D/uvVertex.h"
+#include "Entity/componentArray.h"
+#include "Entity/physicsState.h"
+
+/**
+ * @brief      Owns every entity of a scene and their components.
+ * @details    An entity is only a handle. What it is made of lives in one
+ * packed array per kind of component, so each system (see Systems) walks one
+ * or two arrays from start to end instead of chasing objects around the heap.
+ * Any entity can have any mix of components, so a drawn body, a drawn prop
+ * and an invisible wall need no class of their own.
+ *
+ * Handles carry the generation of their index, so a handle kept after its
+ * entity was destroyed finds nothing rather than whatever reused the index.
+ */
+class EntityRegistry
+{
+public:
+    struct Entity
+    {
+        Entity();
+
+        quint32 Index;
+        quint32 Generation;
+    };
+
+    // Where the entity is drawn
+    struct Transform
+    {
+        QMatrix4x4 ModelToWorld;
+    };
+
+    // A mesh to draw, textured when it has a texture path
+    struct Model
+    {
+        Model();
+
+        QString ModelPath;
+        QString TexturePath;
+        RenderQueue::Pass DrawPass;
+        GLenum CullFace;
+
+        // Bounds of the mesh in model space
+        Bounds Box;
+
+        // Held from creation until uploaded, so the model is imported once
+        QSharedPointer<UVMesh> PendingUV;
+        QSharedPointer<ColorMesh> PendingColor;
+
+        // OpenGL State Data, set by initializeGL
+        QSharedPointer<ResourceCache::MeshBuffers> Buffers;
+        QOpenGLVertexArrayObject* VAO;
+        QSharedPointer<QOpenGLShaderProgram> Program;
+        QSharedPointer<QOpenGLTexture> Texture;
+        int ModelClip;
+    };
+
+    // A rigid body, owned by the registry
+    struct Body
+    {
+        Body( const btTransform& startingState );
+
+        btRigidBody* RigidBody;
+        btCollisionShape* Shape;
+        btDefaultMotionState* MotionState;
+
+        // Triangle mesh shapes read the mesh in place, NULL for other shapes
+        btTriangleIndexVertexArray* TriMesh;
+        QSharedPointer<ColorMesh> Mesh;
+
+        // Collision group of the body and the groups it collides with
+        short Group;
+        short Mask;
+
+        // Last two fixed step states, blended when drawing
+        PhysicsState State;
+    };
+
+    // A sound the entity plays, owned by the registry
+    struct Sound
+    {
+        QMediaPlayer* Player;
+        bool Loop;
+    };
+
+    EntityRegistry();
+    ~EntityRegistry();
+
+    Entity create();
+    void destroy( Entity entity );
+    bool isAlive( Entity entity ) const;
+    int size() const;
+
+    // Adding Components
+    Transform& addTransform( Entity entity, const QMatrix4x4& modelToWorld );
+    Model& addColorModel( Entity entity, const QString& modelPath );
+    Model& addUVModel( Entity entity, const QString& modelPath,
+        const QString& texturePath );
+    Body& addMeshBody( Entity entity, const QString& modelPath,
+        const btTransform& startingState, btScalar mass );
+    Body& addBoxBody( Entity entity, const btVector3& halfExtents,
+        const btTransform& startingState );
+    Body& addShapeBody( Entity entity, btCollisionShape* shape,
+        const btTransform& startingState, btScalar mass );
+    Sound& addSound( Entity entity, const QString& soundPath, int volume,
+        bool loop );
+
+    // Finding Components, NULL if the entity has none or is gone
+    Transform* transform( Entity entity );
+    Model* model( Entity entity );
+    Body* body( Entity entity );
+    Sound* sound( Entity entity );
+
+    // Models are uploaded and released together
+    void initializeGL();
+    void teardownGL();
+
+    // Components, packed for the systems to walk
+    ComponentArray<Transform> Transforms;
+    ComponentArray<Model> Models;
+    ComponentArray<Body> Bodies;
+    ComponentArray<Sound> Sounds;
+
+private:
+    void initializeModel( Model& model );
+    void teardownModel( Model& model );
+    static void releaseBody( Body& body );
+
+    // Shader Information
+    const QString PATH_TO_UV_V_SHADER = ":/shader/uvShader.vs";
+    const QString PATH_TO_UV_F_SHADER = ":/shader/uvShader.fs";
+    const QString PATH_TO_COLOR_V_SHADER = ":/shader/colorShader.vs";
+    const QString PATH_TO_COLOR_F_SHADER = ":/shader/colorShader.fs";
+
+    // Generation of each index, and the indices free to reuse
+    std::vector<quint32> m_generations;
+    std::vector<quint32> m_free;
+
+    // Models added after initializeGL are uploaded right away
+    bool m_initialized;
+};
+
+#endif  //  ENTITY_REGISTRY_H
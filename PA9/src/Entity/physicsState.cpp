@@ -0,0 +1,79 @@
+#include "physicsState.h"
+
+/**
+ * @brief      Constructor for PhysicsState.
+ * @details    Keeps the last two fixed step states of a rigid body, so it can
+ * be drawn between them when frames and physics steps do not line up.
+ *
+ * @param[in]  startingState  The starting location and rotation of the body.
+ */
+PhysicsState::PhysicsState( const btTransform& startingState )
+    :   m_previous( startingState ), m_current( startingState )
+{
+}
+
+/**
+ * @brief      Records the state after a physics step.
+ *
+ * @param[in]  state  The body's new location and rotation.
+ */
+void PhysicsState::record( const btTransform& state )
+{
+    m_previous = m_current;
+    m_current = state;
+}
+
+/**
+ * @brief      Moves the body straight to a state, such as when it is put back
+ *             after a goal, so it is not drawn sliding there.
+ *
+ * @param[in]  state  The body's new location and rotation.
+ */
+void PhysicsState::reset( const btTransform& state )
+{
+    m_previous = state;
+    m_current = state;
+}
+
+/**
+ * @brief      Gets the latest recorded state.
+ *
+ * @return     The model to world matrix of the latest state.
+ */
+QMatrix4x4 PhysicsState::current() const
+{
+    return toMatrix( m_current );
+}
+
+/**
+ * @brief      Blends the last two recorded states.
+ *
+ * @param[in]  alpha  0 for the previous state, 1 for the latest.
+ *
+ * @return     The model to world matrix of the blended state.
+ */
+QMatrix4x4 PhysicsState::interpolate( float alpha ) const
+{
+    btTransform state;
+    state.setOrigin( m_previous.getOrigin().lerp( m_current.getOrigin(),
+        alpha ) );
+    state.setRotation( m_previous.getRotation().slerp(
+        m_current.getRotation(), alpha ) );
+
+    return toMatrix( state );
+}
+
+/**
+ * @brief      Converts a Bullet transform to a matrix OpenGL can use.
+ *
+ * @param[in]  state  The transform to convert.
+ *
+ * @return     The matrix of the transform.
+ */
+QMatrix4x4 PhysicsState::toMatrix( const btTransform& state )
+{
+    btScalar rawMatrix[16];
+    state.getOpenGLMatrix( rawMatrix );
+
+    return QMatrix4x4( rawMatrix ).transposed();
+}
@@ -0,0 +1,24 @@
+#ifndef PHYSICS_STATE_H
+#define PHYSICS_STATE_H
+
+#include <QMatrix4x4>
+#include <btBulletDynamicsCommon.h>
+
+class PhysicsState
+{
+public:
+    PhysicsState( const btTransform& startingState );
+
+    void record( const btTransform& state );
+    void reset( const btTransform& state );
+    QMatrix4x4 current() const;
+    QMatrix4x4 interpolate( float alpha ) const;
+
+private:
+    static QMatrix4x4 toMatrix( const btTransform& state );
+
+    btTransform m_previous;
+    btTransform m_current;
+};
+
+#endif  //  PHYSICS_STATE_H
@@ -0,0 +1,229 @@
+#include "systems.h"
+
+#include "Controls/jobSystem.h"
+#include "Controls/profiler.h"
+
+namespace
+{
+    // Bodies and models per task, small batches are not worth a thread
+    const int BODY_GRAIN = 256;
+    const int CULL_GRAIN = 256;
+}
+
+//
+// PHYSICS /////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Adds every body to a dynamics world, in its collision group.
+ *
+ * @param      registry  The registry of the bodies.
+ * @param      world     The world to add them to.
+ */
+void Systems::addBodies( EntityRegistry& registry, btDynamicsWorld* world )
+{
+    for( int i = 0; i < registry.Bodies.size(); i++ )
+    {
+        const EntityRegistry::Body& body = registry.Bodies[i];
+        world->addRigidBody( body.RigidBody, body.Group, body.Mask );
+    }
+}
+
+/**
+ * @brief      Removes every body from a dynamics world.
+ *
+ * @param      registry  The registry of the bodies.
+ * @param      world     The world to remove them from.
+ */
+void Systems::removeBodies( EntityRegistry& registry, btDynamicsWorld* world )
+{
+    for( int i = 0; i < registry.Bodies.size(); i++ )
+        world->removeRigidBody( registry.Bodies[i].RigidBody );
+}
+
+/**
+ * @brief      Records the state of every body after a step of the dynamics
+ *             world they are in, in batches on the job system.
+ *
+ * @param      registry  The registry of the bodies.
+ */
+void Systems::recordBodies( EntityRegistry& registry )
+{
+    JobSystem::instance().parallelFor( 0, registry.Bodies.size(), BODY_GRAIN,
+        [&registry]( int begin, int end )
+    {
+        for( int i = begin; i < end; i++ )
+        {
+            EntityRegistry::Body& body = registry.Bodies[i];
+            body.State.record( body.RigidBody->getWorldTransform() );
+        }
+    } );
+}
+
+/**
+ * @brief      Places every body with a transform between its last two recorded
+ *             states, in batches on the job system.
+ *
+ * @param      registry  The registry of the bodies.
+ * @param[in]  alpha     How far the frame is between the two states, from 0
+ *                       to 1.
+ */
+void Systems::interpolateBodies( EntityRegistry& registry, float alpha )
+{
+    JobSystem::instance().parallelFor( 0, registry.Bodies.size(), BODY_GRAIN,
+        [&registry, alpha]( int begin, int end )
+    {
+        for( int i = begin; i < end; i++ )
+        {
+            EntityRegistry::Transform* transform =
+                registry.Transforms.find( registry.Bodies.entityAt( i ) );
+            if( transform != NULL )
+            {
+                transform->ModelToWorld =
+                    registry.Bodies[i].State.interpolate( alpha );
+            }
+        }
+    } );
+}
+
+//
+// DRAWING /////////////////////////////////////////////////////////////////////
+//
+
+namespace
+{
+    /**
+     * @brief      Tests every model against the view in batches on the job
+     *             system, then queues the ones in view in their order.
+     *
+     * @param[in]  models       The models.
+     * @param[in]  count        The number of models to draw.
+     * @param[in]  transformOf  Gets where the model of an index is drawn.
+     * @param      queue        The queue of the frame.
+     */
+    template <typename TransformOf>
+    void submitVisible( const ComponentArray<EntityRegistry::Model>& models,
+        int count, TransformOf transformOf, RenderQueue& queue )
+    {
+        std::vector<char> visible( count );
+        const Frustum& frustum = queue.frustum();
+        JobSystem::instance().parallelFor( 0, count, CULL_GRAIN,
+            [&]( int begin, int end )
+        {
+            for( int i = begin; i < end; i++ )
+            {
+                const EntityRegistry::Model& model = models[i];
+                visible[i] = model.VAO != NULL && frustum.intersects(
+                    model.Box.transformed( transformOf( i ) ) );
+            }
+        } );
+
+        // The queue is not thread safe, so only the test is split up
+        int drawn = 0;
+        for( int i = 0; i < count; i++ )
+        {
+            if( !visible[i] )
+                continue;
+
+            const EntityRegistry::Model& model = models[i];
+            const QMatrix4x4& modelToWorld = transformOf( i );
+
+            RenderQueue::Item item;
+            item.DrawPass = model.DrawPass;
+            item.Program = model.Program.data();
+            item.VAO = model.VAO;
+            item.Texture = model.Texture.data();
+            item.CullFace = model.CullFace;
+            item.ModelClip = model.ModelClip;
+            item.Transform = modelToWorld;
+            item.Center = modelToWorld.map( model.Box.center() );
+            item.Count = model.Buffers->NumIndices;
+            item.IndexType = model.Buffers->IndexType;
+            queue.submit( item );
+            drawn++;
+        }
+
+        Profiler::countCulling( drawn, count - drawn );
+    }
+}
+
+/**
+ * @brief      Queues every uploaded model in view, where its transform puts
+ *             it. Models without a transform are drawn where they were
+ *             modeled.
+ *
+ * @param      registry  The registry of the models.
+ * @param      queue     The queue of the frame.
+ */
+void Systems::submitModels( EntityRegistry& registry, RenderQueue& queue )
+{
+    const QMatrix4x4 identity;
+    submitVisible( registry.Models, registry.Models.size(),
+        [&registry, &identity]( int i ) -> const QMatrix4x4&
+    {
+        const EntityRegistry::Transform* transform =
+            registry.Transforms.find( registry.Models.entityAt( i ) );
+        return transform != NULL ? transform->ModelToWorld : identity;
+    }, queue );
+}
+
+/**
+ * @brief      Copies where every model is drawn, so the models can be queued
+ *             later or on another thread while the transforms keep moving.
+ *
+ * @param      registry    The registry of the models.
+ * @param[out] transforms  The model to world matrix of each model, in the
+ *                         order of the registry's models.
+ */
+void Systems::gatherTransforms( EntityRegistry& registry,
+    std::vector<QMatrix4x4>& transforms )
+{
+    transforms.resize( registry.Models.size() );
+    for( int i = 0; i < registry.Models.size(); i++ )
+    {
+        const EntityRegistry::Transform* transform =
+            registry.Transforms.find( registry.Models.entityAt( i ) );
+        if( transform != NULL )
+            transforms[i] = transform->ModelToWorld;
+        else
+            transforms[i].setToIdentity();
+    }
+}
+
+/**
+ * @brief      Queues every uploaded model in view, where gatherTransforms
+ *             found it.
+ *
+ * @param[in]  models      The models.
+ * @param[in]  transforms  The model to world matrix of each model.
+ * @param      queue       The queue of the frame.
+ */
+void Systems::submitModels(
+    const ComponentArray<EntityRegistry::Model>& models,
+    const std::vector<QMatrix4x4>& transforms, RenderQueue& queue )
+{
+    submitVisible( models, qMin( models.size(), int( transforms.size() ) ),
+        [&transforms]( int i ) -> const QMatrix4x4&
+    {
+        return transforms[i];
+    }, queue );
+}
+
+//
+// AUDIO ///////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Starts the looping sounds over once they end.
+ *
+ * @param      registry  The registry of the sounds.
+ */
+void Systems::loopSounds( EntityRegistry& registry )
+{
+    for( int i = 0; i < registry.Sounds.size(); i++ )
+    {
+        const EntityRegistry::Sound& sound = registry.Sounds[i];
+        if( sound.Loop && sound.Player->state() == QMediaPlayer::StoppedState )
+            sound.Player->play();
+    }
+}
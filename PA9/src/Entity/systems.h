@@ -0,0 +1,39 @@
+#ifndef SYSTEMS_H
+#define SYSTEMS_H
+
+#include <QMatrix4x4>
+
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "3D/renderQueue.h"
+#include "Entity/entityRegistry.h"
+
+/**
+ * @brief      The per frame work on a registry's components.
+ * @details    Each system walks the packed array of the one component it is
+ * about, and looks up another component of the same entity only when it needs
+ * it, such as the transform a body moves. None of them care what the entities
+ * are, so the cost grows with the number of components and nothing else.
+ */
+namespace Systems
+{
+    // Physics
+    void addBodies( EntityRegistry& registry, btDynamicsWorld* world );
+    void removeBodies( EntityRegistry& registry, btDynamicsWorld* world );
+    void recordBodies( EntityRegistry& registry );
+    void interpolateBodies( EntityRegistry& registry, float alpha );
+
+    // Drawing
+    void submitModels( EntityRegistry& registry, RenderQueue& queue );
+    void gatherTransforms( EntityRegistry& registry,
+        std::vector<QMatrix4x4>& transforms );
+    void submitModels( const ComponentArray<EntityRegistry::Model>& models,
+        const std::vector<QMatrix4x4>& transforms, RenderQueue& queue );
+
+    // Audio
+    void loopSounds( EntityRegistry& registry );
+};
+
+#endif  //  SYSTEMS_H
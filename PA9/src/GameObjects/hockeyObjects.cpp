@@ -0,0 +1,288 @@
+#include "hockeyObjects.h"
+
+
+namespace
+{
+    // Every model of the game
+    const char* const TABLE_MODEL = "models/HockeyTable.obj";
+    const char* const PUCK_MODEL = "models/Puck150.obj";
+    const char* const RED_PADDLE_MODEL = "models/Paddle250r.obj";
+    const char* const BLUE_PADDLE_MODEL = "models/Paddle250b.obj";
+    const char* const SKYBOX_MODEL = "models/skybox.obj";
+    const char* const SKYBOX_TEXTURE = "textures/room.jpg";
+
+    const char* const COLOR_MODELS[] = { TABLE_MODEL, PUCK_MODEL,
+        RED_PADDLE_MODEL, BLUE_PADDLE_MODEL };
+    const int NUM_COLOR_MODELS = sizeof( COLOR_MODELS ) /
+        sizeof( COLOR_MODELS[0] );
+}
+
+/**
+ * @brief      Queues every model and texture of the game, so creating the
+ *             entities only finds them in the cache.
+ *
+ * @param      loader  The loader to queue the assets on.
+ */
+void HockeyObjects::queueAssets( AssetLoader& loader )
+{
+    for( int i = 0; i < NUM_COLOR_MODELS; i++ )
+        loader.addColorModel( COLOR_MODELS[i] );
+    loader.addUVModel( SKYBOX_MODEL );
+    loader.addTexture( SKYBOX_TEXTURE );
+}
+
+/**
+ * @brief      Creates the table, puck, paddles and skybox, and the invisible
+ *             walls keeping the paddles on their sides and catching goals.
+ *
+ * @param      registry  The registry to create them in.
+ *
+ * @return     The entities of the game.
+ */
+HockeyObjects::Rink HockeyObjects::createRink( EntityRegistry& registry )
+{
+    Rink rink;
+    rink.Table = createTable( registry );
+    rink.Puck = createPuck( registry );
+    rink.Paddle = createPaddle( registry, "Red" );
+    rink.Paddle2 = createPaddle( registry, "Blue" );
+    rink.Skybox = createSkybox( registry );
+
+    // Note: Actual height of the table is around 30.5
+    // So all of these walls are underneath the table but are really tall
+    const btVector3 goalSize = btVector3( 0.5, 35, 4.5 );
+    // red goal
+    rink.Goal = createWall( registry, goalSize, btVector3( -30.5, 0, 1 ),
+        COL_GOAL, GOAL_COLLIDES_WITH );
+    // blue goal
+    rink.Goal2 = createWall( registry, goalSize, btVector3( 33.5, 0, 1 ),
+        COL_GOAL, GOAL_COLLIDES_WITH );
+    // invisible wall in the middle is offset just a little bit to be in
+    // table's center
+    rink.Middle = createWall( registry, btVector3( 0.5, 35, 20 ),
+        btVector3( 1, 0, 0 ), COL_MIDDLE, MIDDLE_COLLIDES_WITH );
+
+    return rink;
+}
+
+/**
+ * @brief      Creates the table. It is static, and hums to simulate air.
+ *
+ * @param      registry  The registry to create it in.
+ *
+ * @return     The table.
+ */
+EntityRegistry::Entity HockeyObjects::createTable( EntityRegistry& registry )
+{
+    const QString model = TABLE_MODEL;
+    const btTransform startingState( btQuaternion( 0, 0, 0, 1 ),
+        btVector3( 0, 0, 0 ) );
+
+    EntityRegistry::Entity table = registry.create();
+    registry.addColorModel( table, model );
+    EntityRegistry::Body& body = registry.addMeshBody( table, model,
+        startingState, 0 );
+    registry.addTransform( table, body.State.current() );
+    body.Group = COL_TABLE;
+    body.Mask = TABLE_COLLIDES_WITH;
+    registry.addSound( table, "sounds/hum.mp3", 800, true );
+
+    return table;
+}
+
+/**
+ * @brief      Creates the puck, in the middle of the table.
+ *
+ * @param      registry  The registry to create it in.
+ *
+ * @return     The puck.
+ */
+EntityRegistry::Entity HockeyObjects::createPuck( EntityRegistry& registry )
+{
+    const QString model = PUCK_MODEL;
+
+    EntityRegistry::Entity puck = registry.create();
+    registry.addColorModel( puck, model );
+    EntityRegistry::Body& body = registry.addMeshBody( puck, model,
+        puckStart(), 0.5 );
+    registry.addTransform( puck, body.State.current() );
+    body.Group = COL_PUCK;
+    body.Mask = PUCK_COLLIDES_WITH;
+
+    // limit movement to x and z
+    body.RigidBody->setLinearFactor( btVector3( 1, 0, 1 ) );
+
+    // limit rotation to y
+    body.RigidBody->setAngularFactor( btVector3( 0, 1, 0 ) );
+
+    return puck;
+}
+
+/**
+ * @brief      Creates a paddle, on its side of the table.
+ *
+ * @param      registry  The registry to create it in.
+ * @param[in]  color     The color of the paddle, Red or Blue.
+ *
+ * @return     The paddle.
+ */
+EntityRegistry::Entity HockeyObjects::createPaddle( EntityRegistry& registry,
+    const QString& color )
+{
+    const bool red = color == "Red";
+    const QString model = red ? RED_PADDLE_MODEL : BLUE_PADDLE_MODEL;
+    const btTransform startingState( btQuaternion( 0, 0, 0, 1 ),
+        red ? btVector3( -25, 30.5f, 0 ) : btVector3( 25, 30.5f, 0 ) );
+
+    EntityRegistry::Entity paddle = registry.create();
+    registry.addColorModel( paddle, model );
+    EntityRegistry::Body& body = registry.addMeshBody( paddle, model,
+        startingState, 5 );
+    registry.addTransform( paddle, body.State.current() );
+    body.Group = COL_PADDLE;
+    body.Mask = PADDLE_COLLIDES_WITH;
+
+    // limit movement to x and z
+    body.RigidBody->setLinearFactor( btVector3( 1, 0, 1 ) );
+
+    // limit rotation to y
+    body.RigidBody->setAngularFactor( btVector3( 0, 1, 0 ) );
+
+    return paddle;
+}
+
+/**
+ * @brief      Creates the skybox. It is queued in the background pass, drawn
+ *             after everything else so only the pixels left uncovered are
+ *             shaded. It is seen from inside, so its front faces are the ones
+ *             culled.
+ *
+ * @param      registry  The registry to create it in.
+ *
+ * @return     The skybox.
+ */
+EntityRegistry::Entity HockeyObjects::createSkybox( EntityRegistry& registry )
+{
+    QMatrix4x4 modelToWorld;
+    modelToWorld.scale( 400.0f );
+
+    EntityRegistry::Entity skybox = registry.create();
+    registry.addTransform( skybox, modelToWorld );
+    EntityRegistry::Model& model = registry.addUVModel( skybox,
+        SKYBOX_MODEL, SKYBOX_TEXTURE );
+    model.DrawPass = RenderQueue::Background;
+    model.CullFace = GL_FRONT;
+
+    return skybox;
+}
+
+/**
+ * @brief      Creates an invisible wall.
+ *
+ * @param      registry  The registry to create it in.
+ * @param[in]  size      The size of the wall.
+ * @param[in]  location  The location of the wall.
+ * @param[in]  group     The collision group of the wall.
+ * @param[in]  mask      The collision groups the wall stops.
+ *
+ * @return     The wall.
+ */
+EntityRegistry::Entity HockeyObjects::createWall( EntityRegistry& registry,
+    const btVector3& size, const btVector3& location, short group, short mask )
+{
+    EntityRegistry::Entity wall = registry.create();
+    EntityRegistry::Body& body = registry.addBoxBody( wall, size,
+        btTransform( btQuaternion( 0, 0, 0, 1 ), location ) );
+    body.Group = group;
+    body.Mask = mask;
+
+    return wall;
+}
+
+/**
+ * @brief      Creates a stack of extra pucks to stress the physics, in layers
+ *             of ten by ten above a point. They are plain cylinders, colliding
+ *             with each other, the table and the paddles.
+ *
+ * @param      registry  The registry to create them in.
+ * @param[in]  count     The number of pucks.
+ * @param[in]  center    The middle of the bottom layer.
+ *
+ * @return     How far the layers reach from the middle along x and z.
+ */
+btVector3 HockeyObjects::createStressPucks( EntityRegistry& registry,
+    int count, const btVector3& center )
+{
+    const QString model = PUCK_MODEL;
+    const int side = 10;
+
+    btVector3 reach( 0, 0, 0 );
+    for( int i = 0; i < count; i++ )
+    {
+        EntityRegistry::Entity puck = registry.create();
+        const QVector3D extents =
+            registry.addColorModel( puck, model ).Box.extents();
+
+        // A puck's width apart, with room to fall between the layers
+        const btVector3 spacing( 2.5f * extents.x(), 3.0f * extents.y(),
+            2.5f * extents.z() );
+        reach = btVector3( 0.5f * side * spacing.x(), 0,
+            0.5f * side * spacing.z() );
+
+        const int column = i % side;
+        const int row = ( i / side ) % side;
+        const int layer = i / ( side * side );
+        const btVector3 offset( ( column + 0.5f ) * spacing.x() - reach.x(),
+            layer * spacing.y(), ( row + 0.5f ) * spacing.z() - reach.z() );
+
+        EntityRegistry::Body& body = registry.addShapeBody( puck,
+            new btCylinderShape( btVector3( extents.x(), extents.y(),
+                extents.z() ) ),
+            btTransform( btQuaternion( 0, 0, 0, 1 ), center + offset ), 0.5 );
+        registry.addTransform( puck, body.State.current() );
+        body.Group = COL_STRESS;
+        body.Mask = STRESS_COLLIDES_WITH;
+    }
+
+    return reach;
+}
+
+/**
+ * @brief      Creates a stack of pucks in a closed pit on its own, without
+ *             the table, for benchmarking the physics. The pit is just wide
+ *             enough for the stack, so every puck stays in the pile.
+ *
+ * @param      registry  The registry to create it in.
+ * @param[in]  count     The number of pucks.
+ */
+void HockeyObjects::createStressScene( EntityRegistry& registry, int count )
+{
+    const btVector3 reach = createStressPucks( registry, count,
+        btVector3( 0, 2, 0 ) );
+    const btScalar height = 500;
+
+    createWall( registry, btVector3( reach.x() + 1, 1, reach.z() + 1 ),
+        btVector3( 0, -1, 0 ), COL_TABLE, TABLE_COLLIDES_WITH );
+    createWall( registry, btVector3( 1, height, reach.z() ),
+        btVector3( -reach.x() - 1, height, 0 ), COL_TABLE,
+        TABLE_COLLIDES_WITH );
+    createWall( registry, btVector3( 1, height, reach.z() ),
+        btVector3( reach.x() + 1, height, 0 ), COL_TABLE,
+        TABLE_COLLIDES_WITH );
+    createWall( registry, btVector3( reach.x(), height, 1 ),
+        btVector3( 0, height, -reach.z() - 1 ), COL_TABLE,
+        TABLE_COLLIDES_WITH );
+    createWall( registry, btVector3( reach.x(), height, 1 ),
+        btVector3( 0, height, reach.z() + 1 ), COL_TABLE,
+        TABLE_COLLIDES_WITH );
+}
+
+/**
+ * @brief      Gets where the puck starts, and is put back after a goal.
+ *
+ * @return     The starting location and rotation of the puck.
+ */
+btTransform HockeyObjects::puckStart()
+{
+    return btTransform( btQuaternion( 0, 0, 0, 1 ), btVector3( 0, 30.5, 0 ) );
+}
@@ -0,0 +1,69 @@
+#ifndef HOCKEY_OBJECTS_H
+#define HOCKEY_OBJECTS_H
+
+#include <QString>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "3D/assetLoader.h"
+#include "Entity/entityRegistry.h"
+
+/**
+ * @brief      Builds the entities of an air hockey game out of components.
+ */
+namespace HockeyObjects
+{
+    /* Collision information */
+    const short COL_NOTHING = 0;
+    // Drawn
+    const short COL_TABLE = 1 << 0;
+    const short COL_PUCK = 1 << 1;
+    const short COL_PADDLE = 1 << 2;
+    // Walls
+    const short COL_MIDDLE = 1 << 3;
+    const short COL_GOAL = 1 << 4;
+    // Stress test
+    const short COL_STRESS = 1 << 5;
+
+    // Drawn
+    const short TABLE_COLLIDES_WITH = ( COL_PUCK | COL_PADDLE | COL_STRESS );
+    const short PUCK_COLLIDES_WITH = ( COL_TABLE | COL_PADDLE | COL_GOAL );
+    const short PADDLE_COLLIDES_WITH = ( COL_TABLE | COL_PUCK | COL_MIDDLE |
+        COL_STRESS );
+    // Walls
+    const short MIDDLE_COLLIDES_WITH = COL_PADDLE;
+    const short GOAL_COLLIDES_WITH = COL_PUCK;
+    // Stress test
+    const short STRESS_COLLIDES_WITH = ( COL_TABLE | COL_PADDLE | COL_STRESS );
+
+    // Every entity of a game, see createRink
+    struct Rink
+    {
+        EntityRegistry::Entity Table, Puck, Paddle, Paddle2, Skybox;
+
+        // Invisible walls for collisions
+        EntityRegistry::Entity Goal, Goal2, Middle;
+    };
+
+    void queueAssets( AssetLoader& loader );
+
+    Rink createRink( EntityRegistry& registry );
+
+    EntityRegistry::Entity createTable( EntityRegistry& registry );
+    EntityRegistry::Entity createPuck( EntityRegistry& registry );
+    EntityRegistry::Entity createPaddle( EntityRegistry& registry,
+        const QString& color );
+    EntityRegistry::Entity createSkybox( EntityRegistry& registry );
+    EntityRegistry::Entity createWall( EntityRegistry& registry,
+        const btVector3& size, const btVector3& location, short group,
+        short mask );
+
+    // Stress test
+    btVector3 createStressPucks( EntityRegistry& registry, int count,
+        const btVector3& center );
+    void createStressScene( EntityRegistry& registry, int count );
+
+    btTransform puckStart();
+};
+
+#endif  //  HOCKEY_OBJECTS_H
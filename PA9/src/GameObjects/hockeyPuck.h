@@ -1,12 +0,0 @@
-#ifndef HOCKEY_PUCK_H
-#define HOCKEY_PUCK_H
-
-#include "Entity/colorPhysicsEntity.h"
-
-class HockeyPuck   :   public ColorPhysicsEntity
-{
-public:
-    HockeyPuck();
-};
-
-#endif  //  HOCKEY_PUCK_H
\ No newline at end of file
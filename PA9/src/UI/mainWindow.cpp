@@ -9,15 +9,20 @@
  * @details   Creates an OGLWidget with an OpenGL surface to draw on as the
  * central widget. A menu bar will also be created for user interaction with the
  * central widget.
+ *
+ * @param[in]  settings  How the game runs.
  */
-MainWindow::MainWindow()
+MainWindow::MainWindow( const OGLWidget::Settings& settings )
+    :   settings( settings )
 {
     // Load Fonts
     QFontDatabase::addApplicationFont( ":/fonts/NHL.ttf" );
 
     setMinimumSize( 800, 600 );
 
-    oglWidget = new OGLWidget();
+    // The game is only created once its assets are loaded, see loadGame
+    oglWidget = NULL;
+    assetLoader = NULL;
     mainMenuWidget = new MainMenuWidget();
     teamSelectWidget = new TeamSelectWidget(); 
 
@@ -48,7 +53,7 @@ void MainWindow::swapToTeamSelect()
         teamSelectWidget = new TeamSelectWidget();
 
     connect( teamSelectWidget, SIGNAL( selectedTeams( QString, QString ) ),
-        this, SLOT( swapToGame( QString, QString ) ) );
+        this, SLOT( loadGame( QString, QString ) ) );
 
     setCentralWidget( teamSelectWidget );
     if( mainMenuWidget != NULL )
@@ -59,12 +64,34 @@ void MainWindow::swapToTeamSelect()
 }
 
 /**
- * @brief      Slot to swap to the Game window.
+ * @brief      Slot to decode the game's assets in the background, showing the
+ *             progress on the team select screen. Swaps to the game once done.
  *
  * @param[in]  team1  Player 1's selected team.
  * @param[in]  team2  Player 2's selected team.
  */
-void MainWindow::swapToGame( QString team1, QString team2 )
+void MainWindow::loadGame( QString team1, QString team2 )
+{
+    if( assetLoader != NULL )
+        return;
+
+    selectedTeam1 = team1;
+    selectedTeam2 = team2;
+
+    assetLoader = new AssetLoader( this );
+    HockeyObjects::queueAssets( *assetLoader );
+
+    connect( assetLoader, SIGNAL( progress( int, int ) ),
+        teamSelectWidget, SLOT( setProgress( int, int ) ) );
+    connect( assetLoader, SIGNAL( finished() ), this, SLOT( swapToGame() ) );
+
+    assetLoader->start();
+}
+
+/**
+ * @brief      Slot to swap to the Game window, once its assets are loaded.
+ */
+void MainWindow::swapToGame()
 {
     QSurfaceFormat format;
     format.setDepthBufferSize( 24 );
@@ -73,8 +100,9 @@ void MainWindow::swapToGame( QString team1, QString team2 )
     format.setProfile( QSurfaceFormat::NoProfile );
     format.setVersion( 2,1 );
 
-    oglWidget = new OGLWidget( team1, team2 );
+    oglWidget = new OGLWidget( selectedTeam1, selectedTeam2, settings );
     oglWidget->setFormat( format );
+    connect( oglWidget, SIGNAL( loaded() ), this, SLOT( finishLoading() ) );
 
     connect( actionPauseProgram, SIGNAL( triggered() ), 
         oglWidget , SLOT( pause() ) );
@@ -106,6 +134,16 @@ void MainWindow::swapToGame( QString team1, QString team2 )
     }
 }
 
+/**
+ * @brief      Releases the loader's handles once the game holds its own and has
+ *             uploaded them to the GPU.
+ */
+void MainWindow::finishLoading()
+{
+    delete assetLoader;
+    assetLoader = NULL;
+}
+
 /**
  * @brief      Slot to restart the entire game.
  */
@@ -128,6 +166,8 @@ void MainWindow::restartGame()
         delete oglWidget;
         oglWidget = NULL;
     }
+    delete assetLoader;
+    assetLoader = NULL;
 }
 
 //
@@ -9,6 +9,7 @@
 #include <QKeySequence>
 #include <QSignalMapper>
 
+#include "3D/assetLoader.h"
 #include "mainMenuWidget.h"
 #include "teamSelectWidget.h"
 #include "oglWidget.h"
@@ -18,11 +19,13 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    MainWindow();
+    MainWindow( const OGLWidget::Settings& settings = OGLWidget::Settings() );
 
 public slots:
     void swapToTeamSelect();
-    void swapToGame( QString team1, QString team2 );
+    void loadGame( QString team1, QString team2 );
+    void swapToGame();
+    void finishLoading();
     void restartGame();
 
 private:
@@ -34,6 +37,9 @@ private:
     OGLWidget* oglWidget;
     MainMenuWidget* mainMenuWidget;
     TeamSelectWidget* teamSelectWidget;
+    AssetLoader* assetLoader;
+    OGLWidget::Settings settings;
+    QString selectedTeam1, selectedTeam2;
 
     QMenuBar* menuBar;
     QMenu* menuFile;
@@ -1,4 +1,5 @@
 #include "oglWidget.h"
+
 //
 // CONSTRUCTORS ////////////////////////////////////////////////////////////////
 // 
@@ -7,6 +8,9 @@
  * @brief      Default constructor for OGLWidget.
  */
 OGLWidget::OGLWidget()
+    :   m_goalBody( NULL ), m_goal2Body( NULL ), m_puckBody( NULL ),
+        m_puckTouching( false ), m_physicsThread( NULL ),
+        m_renderThread( NULL )
 {
     // Update the widget after a frameswap
     connect( this, SIGNAL( frameSwapped() ),
@@ -17,6 +21,12 @@ OGLWidget::OGLWidget()
 
     isPaused = false;
 
+    m_profileInput = profiler.addSection( "Input" );
+    m_profilePhysics = profiler.addSection( "Physics" );
+    m_profileContacts = profiler.addSection( "Contacts" );
+    m_profileUpdate = profiler.addSection( "Update" );
+    m_profileDraw = profiler.addSection( "Draw" );
+
     m_imgTeam1 = new QPixmap( m_pathToTeam1 );
     m_p1Team = new QLabel( this );
     m_p1Team->setPixmap( *m_imgTeam1 );
@@ -32,21 +42,7 @@ OGLWidget::OGLWidget()
     // Default camera view
     setPerspective( 0 );
 
-    renderables["Table"] = new HockeyTable();
-    renderables["Puck"] = new HockeyPuck();
-    renderables["Paddle"] = new HockeyPaddle( "Red" );
-    renderables["Paddle2"] = new HockeyPaddle( "Blue" );
-    renderables["Skybox"] = new Skybox();
-
-    // Note: Actual height of the table is around 30.5
-    // So all of these walls are underneath the table but are really tall
-    const btVector3 goalSize = btVector3(0.5,35,4.5);
-    // red goal
-    walls["Goal"] = new Wall(goalSize, btVector3(-30.5, 0, 1));
-    // blue goal
-    walls["Goal2"] = new Wall(goalSize, btVector3( 33.5, 0, 1));
-    // invisible wall in the middle is offset just a little bit to be in table's center
-    walls["Middle"] = new Wall(btVector3(0.5,35,20), btVector3(1,0,0));
+    createEntities();
 
     // create sound player
 	player = new QMediaPlayer(); 
@@ -56,10 +52,14 @@ OGLWidget::OGLWidget()
 /**
  * @brief      Overloaded constructor, sets custom team logos.
  *
- * @param[in]  team1  Name of logo for team 1.
- * @param[in]  team2  Name of logo for team 2.
+ * @param[in]  team1     Name of logo for team 1.
+ * @param[in]  team2     Name of logo for team 2.
+ * @param[in]  settings  How the game runs.
  */
-OGLWidget::OGLWidget( QString team1, QString team2 )
+OGLWidget::OGLWidget( QString team1, QString team2, const Settings& settings )
+    :   m_goalBody( NULL ), m_goal2Body( NULL ), m_puckBody( NULL ),
+        m_puckTouching( false ), m_settings( settings ),
+        m_physicsThread( NULL ), m_renderThread( NULL )
 {
     m_pathToTeam1 = "images/Team Logos/" + team1 + ".png";
     m_pathToTeam2 = "images/Team Logos/" + team2 + ".png";
@@ -73,6 +73,12 @@ OGLWidget::OGLWidget( QString team1, QString team2 )
 
     isPaused = false;
 
+    m_profileInput = profiler.addSection( "Input" );
+    m_profilePhysics = profiler.addSection( "Physics" );
+    m_profileContacts = profiler.addSection( "Contacts" );
+    m_profileUpdate = profiler.addSection( "Update" );
+    m_profileDraw = profiler.addSection( "Draw" );
+
     m_imgTeam1 = new QPixmap( m_pathToTeam1 );
     m_p1Team = new QLabel( this );
     m_p1Team->setPixmap( *m_imgTeam1 );
@@ -88,32 +94,32 @@ OGLWidget::OGLWidget( QString team1, QString team2 )
     // Default camera view
     setPerspective( 1 );
 
-    renderables["Table"] = new HockeyTable();
-    renderables["Puck"] = new HockeyPuck();
-    renderables["Paddle"] = new HockeyPaddle( "Red" );
-    renderables["Paddle2"] = new HockeyPaddle( "Blue" );
-    renderables["Skybox"] = new Skybox();
-
-    // Note: Actual height of the table is around 30.5
-    // So all of these walls are underneath the table but are really tall
-    const btVector3 goalSize = btVector3(0.5,35,4.5);
-    // red goal
-    walls["Goal"] = new Wall(goalSize, btVector3(-30.5, 0, 1));
-    // blue goal
-    walls["Goal2"] = new Wall(goalSize, btVector3( 33.5, 0, 1));
-    // invisible wall in the middle is offset just a little bit to be in table's center
-    walls["Middle"] = new Wall(btVector3(0.5,35,20), btVector3(1,0,0));
+    createEntities();
 
     // create sound player
     player = new QMediaPlayer(); 
 }
 
+/**
+ * @brief      Constructor for Settings. The game runs on the GUI thread, with
+ *             a serial world and no extra pucks.
+ */
+OGLWidget::Settings::Settings()
+    :   ThreadedPhysics( false ), ThreadedRender( false ),
+        PhysicsBackend( PhysicsWorld::Serial ), PhysicsThreads( 0 ),
+        StressPucks( 0 )
+{
+}
+
 /**
  * @brief      Destructor class to unallocate OpenGL information.
  */
 OGLWidget::~OGLWidget()
 {
+    delete m_physicsThread;
+
     makeCurrent();
+    delete m_renderThread;
     teardownGL();
     teardownBullet();
 }
@@ -131,37 +137,40 @@ void OGLWidget::initializeGL()
     initializeOpenGLFunctions();
     printContextInfo();
     initializeBullet();
+    profiler.initializeGL();
+    renderQueue.initializeGL();
 
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
+    Systems::addBodies( registry, m_dynamicsWorld );
+
+    // The models are uploaded by whichever thread draws them, as their VAOs
+    // cannot be shared between contexts
+    if( m_settings.ThreadedRender )
     {
-        (*iter)->initializeGL();
+        m_blitter.create();
+        m_renderThread = new RenderThread( context(), registry );
+        connect( m_renderThread, SIGNAL( uploaded() ),
+            this, SIGNAL( loaded() ) );
+        m_renderThread->start();
+    }
+    else
+    {
+        registry.initializeGL();
+        emit loaded();
     }
 
-    // renderables
-    m_dynamicsWorld->addRigidBody(
-        ((HockeyTable*)renderables["Table"])->RigidBody, COL_TABLE, m_TableCollidesWith
-    );
-    m_dynamicsWorld->addRigidBody(
-        ((HockeyPuck*)renderables["Puck"])->RigidBody, COL_PUCK, m_PuckCollidesWith
-    );
-    m_dynamicsWorld->addRigidBody(
-        ((HockeyPaddle*)renderables["Paddle"])->RigidBody, COL_PADDLE, m_PaddleCollidesWith
-    );
-    m_dynamicsWorld->addRigidBody(
-        ((HockeyPaddle*)renderables["Paddle2"])->RigidBody, COL_PADDLE, m_PaddleCollidesWith
-    );
+    // The contact tests run on the physics thread and must not look bodies up
+    // in the registry while the GUI thread writes to it
+    m_goalBody = registry.body( m_goal )->RigidBody;
+    m_goal2Body = registry.body( m_goal2 )->RigidBody;
+    m_puckBody = registry.body( m_puck )->RigidBody;
 
-    // walls
-    m_dynamicsWorld->addRigidBody(
-        walls["Goal"]->RigidBody, COL_GOAL, m_GoalCollidesWith
-    );
-    m_dynamicsWorld->addRigidBody(
-        walls["Goal2"]->RigidBody, COL_GOAL, m_GoalCollidesWith
-    );
-    m_dynamicsWorld->addRigidBody(
-        walls["Middle"]->RigidBody, COL_MIDDLE, m_MiddleCollidesWith
-    );
+    // The world is the physics thread's from here on
+    if( m_settings.ThreadedPhysics )
+    {
+        m_physicsThread = new PhysicsThread( m_dynamicsWorld, registry,
+            m_timestep, SIMULATION_SPEED, [this]{ testContacts(); } );
+        m_physicsThread->start();
+    }
 }
 
 /**
@@ -185,7 +194,10 @@ void OGLWidget::resizeGL( int width, int height )
 }
 
 /**
- * @brief      OpenGL function to draw elements to the surface.
+ * @brief      OpenGL function to draw elements to the surface. Models outside
+ *             the view are skipped, the rest are queued and drawn in the order
+ *             that changes the least state. With threaded rendering the render
+ *             thread does that instead, and its latest frame is shown.
  */
 void OGLWidget::paintGL()
 {
@@ -199,11 +211,39 @@ void OGLWidget::paintGL()
     // Clear the screen
     glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
+    profiler.beginGPU();
+    profiler.begin( m_profileDraw );
+    if( m_renderThread != NULL )
+    {
+        RenderThread::Frame& frame = m_renderThread->nextFrame();
+        frame.Camera = camera;
+        frame.Projection = projection;
+        frame.Size = size() * devicePixelRatio();
+        Systems::gatherTransforms( registry, frame.Transforms );
+        m_renderThread->submit();
+
+        // Shown a frame behind, the thread draws this one meanwhile
+        const GLuint texture = m_renderThread->texture();
+        if( texture != 0 )
+        {
+            glDisable( GL_DEPTH_TEST );
+            glDisable( GL_CULL_FACE );
+
+            m_blitter.bind();
+            m_blitter.blit( texture, QMatrix4x4(),
+                QOpenGLTextureBlitter::OriginBottomLeft );
+            m_blitter.release();
+            m_renderThread->fenceTexture();
+        }
+    }
+    else
     {
-        (*iter)->paintGL( camera, projection );
+        renderQueue.begin( camera, projection );
+        Systems::submitModels( registry, renderQueue );
+        renderQueue.flush();
     }
+    profiler.end( m_profileDraw );
+    profiler.endGPU();
 
     // 2D Elements
     QFont NHLFont( "NHL", 47 );
@@ -220,6 +260,8 @@ void OGLWidget::paintGL()
         + " - " + QString::number( m_p2Score ) );
 
     painter.endNativePainting();
+
+    profiler.paintOverlay( painter, QWidget::rect() );
 }
 
 /**
@@ -227,11 +269,11 @@ void OGLWidget::paintGL()
  */
 void OGLWidget::teardownGL()
 {
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
-    {
-        (*iter)->teardownGL();
-    }
+    profiler.teardownGL();
+    registry.teardownGL();
+
+    if( m_blitter.isCreated() )
+        m_blitter.destroy();
 }
 
 //
@@ -243,9 +285,16 @@ void OGLWidget::teardownGL()
  */
 void OGLWidget::update()
 {
+    // Consumed even while paused, so unpausing does not catch up on the pause
+    float dt = updateTimer.deltaTime();
+
+    profiler.nextFrame();
+    profiler.begin( m_profileInput );
+
     Input::update();
 
     flyThroughCamera();
+    controlProfiler();
 
     btVector3 linearVelocity(0,0,0);
 
@@ -268,9 +317,7 @@ void OGLWidget::update()
 
 if( isPaused == false )
 {
-    ((HockeyPaddle*)renderables["Paddle2"])->RigidBody->setLinearVelocity(
-        linearVelocity
-    );
+    setVelocity( m_paddle2, linearVelocity );
 
     btVector3 linearVelocity2(0,0,0);
 
@@ -291,45 +338,54 @@ if( isPaused == false )
         linearVelocity2[2] = -5;
     }
 
-    ((HockeyPaddle*)renderables["Paddle"])->RigidBody->setLinearVelocity(
-        linearVelocity2
-    );
+    setVelocity( m_paddle, linearVelocity2 );
+    profiler.end( m_profileInput );
 
-    for( QMap<QString, Renderable*>::iterator iter = renderables.begin(); 
-        iter != renderables.end(); iter++ )
+    if( m_physicsThread == NULL )
     {
-        (*iter)->update();
+        const int ticks = m_timestep.advance( dt * SIMULATION_SPEED );
+        for( int tick = 0; tick < ticks; tick++ )
+        {
+            profiler.begin( m_profilePhysics );
+            m_dynamicsWorld->stepSimulation( m_timestep.step(), 0 );
+            profiler.end( m_profilePhysics );
+
+            profiler.begin( m_profileUpdate );
+            Systems::recordBodies( registry );
+            profiler.end( m_profileUpdate );
+
+            Profiler::Scope scope( profiler, m_profileContacts );
+            testContacts();
+        }
+
+        Systems::interpolateBodies( registry, m_timestep.alpha() );
     }
+    else
+    {
+        // The thread stepped the world meanwhile, catch up on what it did
+        Profiler::Scope scope( profiler, m_profileUpdate );
 
-    m_dynamicsWorld->stepSimulation( 1, 10 );
-
-    // p1 
-    GoalCallback goalCallback(this);
-    m_dynamicsWorld->contactTest(
-        walls["Goal"]->RigidBody,
-        goalCallback
-    );
+        int event;
+        while( m_physicsThread->receive( event ) )
+            handleEvent( event );
 
-    Goal2Callback goal2Callback(this);
-    m_dynamicsWorld->contactTest(
-        walls["Goal2"]->RigidBody,
-        goal2Callback
-    );
+        Systems::interpolateBodies( registry,
+            m_physicsThread->read( registry ) );
+    }
 
-    PuckCallback puckCallback(this);
-    m_dynamicsWorld->contactTest(
-    	((HockeyPuck*)renderables["Puck"])->RigidBody,
-    	puckCallback
-    );
+    Systems::loopSounds( registry );
 
     /* Example of contactPairTest
     m_dynamicsWorld->contactPairTest( 
-        ((HockeyPaddle*)renderables["Paddle2"])->RigidBody,
-        ((HockeyPuck*)renderables["Puck"])->RigidBody,
+        registry.body( m_paddle2 )->RigidBody,
+        registry.body( m_puck )->RigidBody,
         callback
     );
     */
 }
+    // Still open when paused
+    profiler.end( m_profileInput );
+
     QOpenGLWidget::update();
 }
 
@@ -339,6 +395,9 @@ if( isPaused == false )
 void OGLWidget::pause()
 {
     isPaused = !isPaused;
+
+    if( m_physicsThread != NULL )
+        m_physicsThread->setPaused( isPaused );
 }
 
 /**
@@ -434,16 +493,54 @@ void OGLWidget::mouseReleaseEvent( QMouseEvent* event )
 //
 
 /**
- * @brief      Helper function to initialize bullet data.
+ * @brief      Toggles the profiler overlay with F3 and saves the recorded
+ *             frames to profile.csv and profile.json with F4.
+ */
+void OGLWidget::controlProfiler()
+{
+    if( Input::keyTriggered( Qt::Key_F3 ) )
+        profiler.OverlayVisible = !profiler.OverlayVisible;
+
+    if( Input::keyTriggered( Qt::Key_F4 ) )
+    {
+        if( profiler.exportCSV( "profile.csv" ) &&
+            profiler.exportTrace( "profile.json" ) )
+            qDebug() << "Saved profile.csv and profile.json";
+        else
+            qDebug() << "Could not save the profile";
+    }
+}
+
+/**
+ * @brief      Creates the entities of the game, see HockeyObjects::createRink,
+ *             and the extra pucks of the settings. Their models have been
+ *             decoded already, see HockeyObjects::queueAssets.
+ */
+void OGLWidget::createEntities()
+{
+    const HockeyObjects::Rink rink = HockeyObjects::createRink( registry );
+    m_table = rink.Table;
+    m_puck = rink.Puck;
+    m_paddle = rink.Paddle;
+    m_paddle2 = rink.Paddle2;
+    m_skybox = rink.Skybox;
+    m_goal = rink.Goal;
+    m_goal2 = rink.Goal2;
+    m_middle = rink.Middle;
+
+    HockeyObjects::createStressPucks( registry, m_settings.StressPucks,
+        btVector3( 0, 35, 0 ) );
+}
+
+/**
+ * @brief      Helper function to initialize bullet data, with the backend of
+ *             the settings.
  */
 void OGLWidget::initializeBullet()
 {
-    m_broadphase = new btDbvtBroadphase();
-    m_collisionConfig = new btDefaultCollisionConfiguration();
-    m_dispatcher = new btCollisionDispatcher( m_collisionConfig );
-    m_solver = new btSequentialImpulseConstraintSolver();
-    m_dynamicsWorld = new btDiscreteDynamicsWorld( m_dispatcher, m_broadphase,
-        m_solver, m_collisionConfig );
+    m_physicsWorld = new PhysicsWorld( m_settings.PhysicsBackend,
+        m_settings.PhysicsThreads );
+    m_dynamicsWorld = m_physicsWorld->world();
 
     m_dynamicsWorld->setGravity( btVector3( 0, -9.8, 0 ) );
 }
@@ -453,11 +550,9 @@ void OGLWidget::initializeBullet()
  */
 void OGLWidget::teardownBullet()
 {
-    delete m_dynamicsWorld;
-    delete m_solver;
-    delete m_dispatcher;
-    delete m_collisionConfig;
-    delete m_broadphase;
+    Systems::removeBodies( registry, m_dynamicsWorld );
+
+    delete m_physicsWorld;
 }
 
 /**
@@ -533,7 +628,121 @@ void OGLWidget::printContextInfo()
 }
 
 /**
- * @brief      Resets the game state after a goal.
+ * @brief      Sets a body's linear velocity, through the physics thread if
+ *             it owns the world.
+ *
+ * @param[in]  entity    The entity of the body.
+ * @param[in]  velocity  The new linear velocity.
+ */
+void OGLWidget::setVelocity( EntityRegistry::Entity entity,
+    const btVector3& velocity )
+{
+    btRigidBody* body = registry.body( entity )->RigidBody;
+    if( m_physicsThread == NULL )
+    {
+        body->setLinearVelocity( velocity );
+        return;
+    }
+
+    PhysicsThread::Command command;
+    command.Body = body;
+    command.LinearVelocity = velocity;
+    m_physicsThread->send( command );
+}
+
+/**
+ * @brief      Checks for goals and puck hits after a step. Runs on whichever
+ *             thread steps the world.
+ */
+void OGLWidget::testContacts()
+{
+    // p1
+    ContactCallback goalCallback;
+    m_dynamicsWorld->contactTest( m_goalBody, goalCallback );
+
+    ContactCallback goal2Callback;
+    m_dynamicsWorld->contactTest( m_goal2Body, goal2Callback );
+
+    ContactCallback puckCallback;
+    m_dynamicsWorld->contactTest( m_puckBody, puckCallback );
+
+    if( goalCallback.Hit )
+    {
+        resetPuck();
+        raise( Player1Goal );
+    }
+    if( goal2Callback.Hit )
+    {
+        resetPuck();
+        raise( Player2Goal );
+    }
+    // Only when the puck starts touching something, not on every tick it
+    // stays in contact
+    if( puckCallback.Hit && !m_puckTouching )
+        raise( PuckContact );
+    m_puckTouching = puckCallback.Hit;
+}
+
+/**
+ * @brief      Puts the puck back in the middle of the table after a goal.
+ *             Runs on whichever thread steps the world.
+ */
+void OGLWidget::resetPuck()
+{
+    m_puckBody->getMotionState()->setWorldTransform(
+        HockeyObjects::puckStart() );
+    m_puckBody->setWorldTransform( HockeyObjects::puckStart() );
+    m_puckBody->setLinearVelocity( btVector3( 0, 0, 0 ) );
+
+    // Drawn in the middle right away rather than sliding back from the goal.
+    // The registry is only safe to touch when this is the GUI thread
+    if( m_physicsThread != NULL )
+        m_physicsThread->snap( m_puckBody );
+    else
+        registry.body( m_puck )->State.reset( HockeyObjects::puckStart() );
+}
+
+/**
+ * @brief      Hands an event raised by a contact test to the GUI thread, right
+ *             away when it is the one stepping the world.
+ *
+ * @param[in]  event  The event.
+ */
+void OGLWidget::raise( GameEvent event )
+{
+    if( m_physicsThread != NULL )
+        m_physicsThread->post( event );
+    else
+        handleEvent( event );
+}
+
+/**
+ * @brief      Scores goals and plays the sounds of events. GUI thread only.
+ *
+ * @param[in]  event  The GameEvent.
+ */
+void OGLWidget::handleEvent( int event )
+{
+    switch( event )
+    {
+        case Player1Goal:
+        m_p1Score++;
+        processGoal();
+        break;
+        case Player2Goal:
+        m_p2Score++;
+        processGoal();
+        break;
+        case PuckContact:
+        puckContactSound();
+        break;
+        default:
+        break;
+    }
+}
+
+/**
+ * @brief      Plays the goal sound.
  */
 void OGLWidget::processGoal()
 {
@@ -543,15 +752,6 @@ void OGLWidget::processGoal()
     player->setMedia(url);
     player->setVolume(800);	 
     player->play();
-
-    // reset puck
-    btTransform startingState = btTransform( btQuaternion( 0, 0, 0, 1 ), 
-        btVector3( 0, 30.5, 0 ) );
-    btDefaultMotionState* motionState = new btDefaultMotionState( startingState );
-    ((HockeyPuck*)renderables["Puck"])->RigidBody->setMotionState( motionState );
-    ((HockeyPuck*)renderables["Puck"])->RigidBody->setLinearVelocity(
-        btVector3(0,0,0)
-    );
 }
 
 /**
@@ -4,6 +4,7 @@
 #include <QApplication>
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions>
+#include <QOpenGLTextureBlitter>
 
 #include <QPainter>
 #include <QFont>
@@ -15,7 +16,6 @@
 #include <QKeyEvent>
 #include <QMouseEvent>
 
-#include <QMap>
 #include <QMatrix4x4>
 #include <QMediaPlayer>
 #include <QFileInfo>
@@ -26,13 +26,17 @@
 #include <btBulletDynamicsCommon.h>
 
 #include "Controls/input.h"
+#include "Controls/physicsThread.h"
+#include "Controls/physicsWorld.h"
 #include "Controls/camera3d.h"
-#include "3D/renderable.h"
-#include "GameObjects/hockeyTable.h"
-#include "GameObjects/hockeyPuck.h"
-#include "GameObjects/hockeyPaddle.h"
-#include "GameObjects/skybox.h"
-#include "GameObjects/wall.h"
+#include "Controls/fixedTimestep.h"
+#include "Controls/profiler.h"
+#include "Controls/time.h"
+#include "3D/renderQueue.h"
+#include "Entity/entityRegistry.h"
+#include "Entity/systems.h"
+#include "GameObjects/hockeyObjects.h"
+#include "UI/renderThread.h"
 
 class OGLWidget    :    public QOpenGLWidget,
                         protected QOpenGLFunctions
@@ -40,8 +44,27 @@ class OGLWidget    :    public QOpenGLWidget,
     Q_OBJECT
 
 public:
+    // How the game runs, set from the command line
+    struct Settings
+    {
+        Settings();
+
+        // Step the physics and draw the scene on threads of their own
+        bool ThreadedPhysics;
+        bool ThreadedRender;
+
+        // Backend of the dynamics world, and its threads when multithreaded,
+        // 0 for every core
+        PhysicsWorld::Backend PhysicsBackend;
+        int PhysicsThreads;
+
+        // Extra pucks dropped on the table to stress the physics
+        int StressPucks;
+    };
+
     OGLWidget();
-    OGLWidget( QString team1, QString team2 );
+    OGLWidget( QString team1, QString team2,
+        const Settings& settings = Settings() );
     ~OGLWidget();
 
     virtual void initializeGL();
@@ -49,6 +72,10 @@ public:
     virtual void paintGL();
     virtual void teardownGL();
 
+signals:
+    // The models are uploaded, whichever thread draws them
+    void loaded();
+
 public slots:
     void setPerspective( int perspective );
 
@@ -63,35 +90,11 @@ protected:
     void mouseReleaseEvent( QMouseEvent* event );
 
 private:
-    struct GoalCallback : public btCollisionWorld::ContactResultCallback
+    // Notes whether a body touched anything, however many points it touched
+    struct ContactCallback : public btCollisionWorld::ContactResultCallback
     {
-        GoalCallback(OGLWidget* scopePtr) : context(scopePtr)
-        {            
-        }
-
-        btScalar addSingleResult(btManifoldPoint& cp,
-            const btCollisionObjectWrapper* colObj0Wrap,
-            int partId0,
-            int index0,
-            const btCollisionObjectWrapper* colObj1Wrap,
-            int partId1,
-            int index1)
+        ContactCallback() : Hit( false )
         {
-            // silence unused variable noise
-            (void)partId0;(void)partId1;(void)index0;(void)index1;(void)colObj0Wrap;(void)colObj1Wrap;(void)cp;
-            context->processGoal();
-            context->m_p1Score++;
-            // return doesn't actually do anything
-            return 1.0f;
-        }
-
-        OGLWidget* context;
-    };
-
-    struct Goal2Callback : public btCollisionWorld::ContactResultCallback
-    {
-        Goal2Callback(OGLWidget* scopePtr) : context(scopePtr)
-        {            
         }
 
         btScalar addSingleResult(btManifoldPoint& cp,
@@ -104,85 +107,89 @@ private:
         {
             // silence unused variable noise
             (void)partId0;(void)partId1;(void)index0;(void)index1;(void)colObj0Wrap;(void)colObj1Wrap;(void)cp;
-            context->processGoal();
-            context->m_p2Score++;
+            Hit = true;
             // return doesn't actually do anything
             return 1.0f;
         }
 
-        OGLWidget* context;
+        bool Hit;
     };
 
-       struct PuckCallback : public btCollisionWorld::ContactResultCallback
+    // Raised by the contact tests, on whichever thread steps the world
+    enum GameEvent
     {
-        PuckCallback(OGLWidget* scopePtr) : context(scopePtr)
-        {            
-        }
-
-        btScalar addSingleResult(btManifoldPoint& cp,
-            const btCollisionObjectWrapper* colObj0Wrap,
-            int partId0,
-            int index0,
-            const btCollisionObjectWrapper* colObj1Wrap,
-            int partId1,
-            int index1)
-        {
-            (void)partId0;(void)partId1;(void)index0;(void)index1;(void)colObj0Wrap;(void)colObj1Wrap;(void)cp;
-            context->puckContactSound();
-            return 1.0f;
-        }
-
-        OGLWidget* context;
+        Player1Goal,
+        Player2Goal,
+        PuckContact
     };
-    
 
+    void createEntities();
     void initializeBullet();
     void teardownBullet();
     void flyThroughCamera();
     void controlObject();
     void printContextInfo();
+    void setVelocity( EntityRegistry::Entity entity,
+        const btVector3& velocity );
+    void testContacts();
+    void resetPuck();
+    void raise( GameEvent event );
+    void handleEvent( int event );
     void processGoal();
     void puckContactSound();
+    void controlProfiler();
 
 
-    // OpenGL Objects
-    QMap<QString, Renderable*> renderables;
+    // Every object of the game, drawn or not
+    EntityRegistry registry;
+    EntityRegistry::Entity m_table, m_puck, m_paddle, m_paddle2, m_skybox;
 
     // Invisible walls for collisions
-    QMap<QString, Wall*> walls;
+    EntityRegistry::Entity m_goal, m_goal2, m_middle;
+
+    // Bodies of the contact tests, looked up before the physics thread starts
+    btRigidBody* m_goalBody;
+    btRigidBody* m_goal2Body;
+    btRigidBody* m_puckBody;
+
+    // Whether the puck touched anything on the last step, written only by
+    // the thread stepping the world
+    bool m_puckTouching;
 
     // 3D data
     QMatrix4x4 projection;
     Camera3D camera;
 
-    // Bullet data
-    btBroadphaseInterface* m_broadphase;
-    btDefaultCollisionConfiguration* m_collisionConfig;
-    btCollisionDispatcher* m_dispatcher;
-    btSequentialImpulseConstraintSolver* m_solver;
+    // Bullet data, the world is owned by m_physicsWorld
+    Settings m_settings;
+    PhysicsWorld* m_physicsWorld;
     btDiscreteDynamicsWorld* m_dynamicsWorld;
 
+    // The table was tuned with ten 1/60 s steps per frame, so the simulation
+    // runs ten times faster than real time to keep the same pace
+    const float SIMULATION_SPEED = 10.0f;
+    Time updateTimer;
+    FixedTimestep m_timestep = FixedTimestep( 60.0f, 20 );
+
+    // Steps the world on its own thread when threaded physics is on, NULL
+    // when the world is stepped here
+    PhysicsThread* m_physicsThread;
+
+    // Draws the scene on its own thread when threaded rendering is on, NULL
+    // when it is drawn here. Its frames are blitted under the HUD
+    RenderThread* m_renderThread;
+    QOpenGLTextureBlitter m_blitter;
+
     // media player
     QMediaPlayer *player;
 
-    /* Collision information */
-    const short COL_NOTHING = 0;
-    // Renderables
-    const short COL_TABLE = 1 << 0;
-    const short COL_PUCK = 1 << 1;
-    const short COL_PADDLE = 1 << 2;
-
-    // Walls
-    const short COL_MIDDLE = 1 << 3;
-    const short COL_GOAL = 1 << 4;
-
-    // Renderables
-    const short m_TableCollidesWith = ( COL_PUCK | COL_PADDLE );
-    const short m_PuckCollidesWith = ( COL_TABLE | COL_PADDLE | COL_GOAL );
-    const short m_PaddleCollidesWith = ( COL_TABLE | COL_PUCK | COL_MIDDLE ); 
-    // Walls
-    const short m_MiddleCollidesWith = COL_PADDLE;
-    const short m_GoalCollidesWith = (COL_PUCK);
+    // Frame profiler, F3 toggles the overlay and F4 saves the timings
+    Profiler profiler;
+    int m_profileInput, m_profilePhysics, m_profileContacts, m_profileUpdate,
+        m_profileDraw;
+
+    // Sorts the draws of a frame to change the least state
+    RenderQueue renderQueue;
 
     bool isPaused;
 
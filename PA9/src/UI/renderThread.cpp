@@ -0,0 +1,240 @@
+#include "renderThread.h"
+
+#include <QCoreApplication>
+
+#include <algorithm>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Constructor for RenderThread. Creates the thread's context on
+ *             the GUI thread and hands it over, the thread does not run until
+ *             started.
+ *
+ * @param      shareContext  The widget's context, to share the drawn textures
+ *                           with.
+ * @param      registry      The registry of the models to draw, not yet
+ *                           uploaded anywhere.
+ */
+RenderThread::RenderThread( QOpenGLContext* shareContext,
+    EntityRegistry& registry )
+    :   m_registry( registry ), m_stop( false ), m_textureFence( NULL ),
+        m_fenceSync( NULL ), m_clientWaitSync( NULL ), m_deleteSync( NULL )
+{
+    // Sync objects are core from 3.2, a 2.1 context may have them as ARB_sync
+    const QSurfaceFormat format = shareContext->format();
+    if( format.version() >= qMakePair( 3, 2 ) ||
+        shareContext->hasExtension( "GL_ARB_sync" ) )
+    {
+        m_fenceSync = (PFNGLFENCESYNCPROC)
+            shareContext->getProcAddress( "glFenceSync" );
+        m_clientWaitSync = (PFNGLCLIENTWAITSYNCPROC)
+            shareContext->getProcAddress( "glClientWaitSync" );
+        m_deleteSync = (PFNGLDELETESYNCPROC)
+            shareContext->getProcAddress( "glDeleteSync" );
+
+        if( m_fenceSync == NULL || m_clientWaitSync == NULL ||
+            m_deleteSync == NULL )
+            m_fenceSync = NULL;
+    }
+
+    m_context = new QOpenGLContext();
+    m_context->setFormat( shareContext->format() );
+    m_context->setShareContext( shareContext );
+    m_context->create();
+
+    // Surfaces have to be created on the GUI thread
+    m_surface = new QOffscreenSurface();
+    m_surface->setFormat( m_context->format() );
+    m_surface->create();
+
+    m_context->moveToThread( this );
+}
+
+/**
+ * @brief      Destructor for RenderThread. Stops the thread, which frees what
+ *             it drew with. The widget's context must be current.
+ */
+RenderThread::~RenderThread()
+{
+    stop();
+    waitForTexture();
+
+    delete m_context;
+    delete m_surface;
+}
+
+//
+// PUBLIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gets the frame to fill in before submitting it. GUI thread only.
+ *
+ * @return     The next frame.
+ */
+RenderThread::Frame& RenderThread::nextFrame()
+{
+    return m_frames.back();
+}
+
+/**
+ * @brief      Hands the filled in frame to the thread to draw. Frames it did
+ *             not get to in time are skipped. GUI thread only.
+ */
+void RenderThread::submit()
+{
+    m_frames.publish();
+    m_pending.release();
+}
+
+/**
+ * @brief      Takes the latest finished frame. GUI thread only.
+ *
+ * @return     The texture of the frame, valid in the widget's context until
+ *             the next call, or 0 if no frame is finished yet.
+ */
+GLuint RenderThread::texture()
+{
+    // The old front may go back to the thread now
+    waitForTexture();
+    m_targets.update();
+
+    QOpenGLFramebufferObject* target = m_targets.front();
+    return target != NULL ? target->texture() : 0;
+}
+
+/**
+ * @brief      Marks the end of the widget's commands using the texture, so it
+ *             is not drawn over before they have run. Called after the blit
+ *             with the widget's context current. GUI thread only.
+ */
+void RenderThread::fenceTexture()
+{
+    if( m_fenceSync == NULL )
+    {
+        QOpenGLContext::currentContext()->functions()->glFinish();
+        return;
+    }
+
+    if( m_textureFence != NULL )
+        m_deleteSync( m_textureFence );
+    m_textureFence = m_fenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+}
+
+/**
+ * @brief      Stops the thread and waits for it to free what it drew with.
+ *             The models are no longer uploaded afterwards.
+ */
+void RenderThread::stop()
+{
+    m_stop.store( true );
+    m_pending.release();
+    wait();
+}
+
+//
+// PROTECTED FUNCTIONS /////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Uploads the models, then draws the latest frame every time one
+ *             is submitted until stopped.
+ */
+void RenderThread::run()
+{
+    m_context->makeCurrent( m_surface );
+    initializeOpenGLFunctions();
+    m_registry.initializeGL();
+    m_queue.initializeGL();
+    emit uploaded();
+
+    while( true )
+    {
+        // Frames submitted meanwhile were replaced by the latest one
+        m_pending.acquire();
+        m_pending.tryAcquire( m_pending.available() );
+
+        if( m_stop.load() )
+            break;
+
+        if( m_frames.update() )
+            render( m_frames.front() );
+    }
+
+    m_registry.teardownGL();
+    for( size_t i = 0; i < m_allTargets.size(); i++ )
+        delete m_allTargets[i];
+    m_allTargets.clear();
+
+    m_context->doneCurrent();
+    m_context->moveToThread( QCoreApplication::instance()->thread() );
+}
+
+//
+// PRIVATE HELPER FUNCTIONS ////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Draws a frame into the back target and publishes it once the
+ *             GPU is done with it.
+ *
+ * @param      frame  The frame.
+ */
+void RenderThread::render( Frame& frame )
+{
+    QOpenGLFramebufferObject*& target = m_targets.back();
+    if( target == NULL || target->size() != frame.Size )
+    {
+        if( target != NULL )
+        {
+            m_allTargets.erase( std::find( m_allTargets.begin(),
+                m_allTargets.end(), target ) );
+            delete target;
+        }
+
+        target = new QOpenGLFramebufferObject( frame.Size,
+            QOpenGLFramebufferObject::Depth );
+        m_allTargets.push_back( target );
+    }
+
+    target->bind();
+    glViewport( 0, 0, frame.Size.width(), frame.Size.height() );
+
+    // Set the default OpenGL states
+    glEnable( GL_DEPTH_TEST );
+    glDepthFunc( GL_LEQUAL );
+    glDepthMask( GL_TRUE );
+    glEnable( GL_CULL_FACE );
+    glClearColor( 0.0f, 0.0f, 0.2f, 1.0f );
+
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+    m_queue.begin( frame.Camera, frame.Projection );
+    Systems::submitModels( m_registry.Models, frame.Transforms, m_queue );
+    m_queue.flush();
+
+    target->release();
+
+    // The widget's context samples the texture as soon as it is published
+    glFinish();
+    m_targets.publish();
+}
+
+/**
+ * @brief      Waits for the widget's context to finish the commands fenced by
+ *             fenceTexture. By the next frame they have usually run already.
+ *             GUI thread only.
+ */
+void RenderThread::waitForTexture()
+{
+    if( m_textureFence == NULL )
+        return;
+
+    m_clientWaitSync( m_textureFence, GL_SYNC_FLUSH_COMMANDS_BIT,
+        GL_TIMEOUT_IGNORED );
+    m_deleteSync( m_textureFence );
+    m_textureFence = NULL;
+}
@@ -0,0 +1,105 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QSemaphore>
+#include <QThread>
+
+#include <QMatrix4x4>
+#include <QSize>
+
+#include <atomic>
+#include <vector>
+
+#include "Controls/camera3d.h"
+#include "Controls/tripleBuffer.h"
+#include "3D/renderQueue.h"
+#include "Entity/entityRegistry.h"
+#include "Entity/systems.h"
+
+/**
+ * @brief      Draws the scene on its own thread, into a texture the widget
+ *             composites.
+ * @details    The thread owns a second context sharing objects with the
+ * widget's one, and uploads the registry's models into it, so everything
+ * about the models' GL state is the thread's. Every frame the GUI thread
+ * fills in a Frame, the camera, projection and where each model is, and
+ * submits it. The thread culls, sorts and draws the latest frame into a
+ * framebuffer object, waits for it to finish and publishes the texture, which
+ * the widget then only has to blit under its HUD. The widget fences its blit in
+ * turn, so a texture only goes back to the thread once the widget's context is
+ * done sampling it. Handing over copies both
+ * ways through triple buffers lets the GUI thread run input, physics and the
+ * next frame while the last one is still being rasterized.
+ *
+ * Models must not be added or removed while the thread runs.
+ */
+class RenderThread  :   public QThread,
+                        protected QOpenGLFunctions
+{
+    Q_OBJECT
+
+public:
+    // Everything the thread needs of the scene to draw a frame
+    struct Frame
+    {
+        Camera3D Camera;
+        QMatrix4x4 Projection;
+
+        // In device pixels
+        QSize Size;
+
+        // Model to world matrix of each model, in the order of the registry's
+        // models
+        std::vector<QMatrix4x4> Transforms;
+    };
+
+    RenderThread( QOpenGLContext* shareContext, EntityRegistry& registry );
+    ~RenderThread();
+
+    // GUI thread
+    Frame& nextFrame();
+    void submit();
+    GLuint texture();
+    void fenceTexture();
+    void stop();
+
+signals:
+    // The models are in the thread's context, emitted once from the thread
+    void uploaded();
+
+protected:
+    void run();
+
+private:
+    void render( Frame& frame );
+    void waitForTexture();
+
+    QOpenGLContext* m_context;
+    QOffscreenSurface* m_surface;
+    EntityRegistry& m_registry;
+    RenderQueue m_queue;
+
+    // Frames from the GUI thread, and the targets drawn back to it
+    TripleBuffer<Frame> m_frames;
+    TripleBuffer<QOpenGLFramebufferObject*> m_targets;
+
+    // Every target alive, to delete them wherever they are when stopping
+    std::vector<QOpenGLFramebufferObject*> m_allTargets;
+
+    // Signalled once the widget's context has finished with the front target.
+    // The functions are NULL without ARB_sync, glFinish is used instead
+    GLsync m_textureFence;
+    PFNGLFENCESYNCPROC m_fenceSync;
+    PFNGLCLIENTWAITSYNCPROC m_clientWaitSync;
+    PFNGLDELETESYNCPROC m_deleteSync;
+
+    // Released once per submitted frame, and to wake the thread to stop
+    QSemaphore m_pending;
+    std::atomic<bool> m_stop;
+};
+
+#endif  //  RENDER_THREAD_H
@@ -67,6 +67,12 @@ TeamSelectWidget::TeamSelectWidget()
     }
 }
 
+    m_lbProgress = new QLabel();
+    m_lbProgress->setAlignment( Qt::AlignCenter );
+    m_lbProgress->setFont( QFont( "NHL", 30 ) );
+    m_lbProgress->hide();
+    m_layout->addWidget( m_lbProgress, 5, 0, 1, 6 );
+
     m_signalMapper = new QSignalMapper( this );
 
     connect( m_btnLogos[0], SIGNAL ( released() ),
@@ -178,6 +184,7 @@ TeamSelectWidget::~TeamSelectWidget()
         delete m_imgLogos[i];
         delete m_btnLogos[i];
     }
+    delete m_lbProgress;
     delete m_layout;
     delete m_signalMapper;
 }
@@ -206,6 +213,23 @@ void TeamSelectWidget::setTeams( QString team )
     }
 }
 
+/**
+ * @brief      Shows the progress of the game's asset loading under the logos,
+ *             which can no longer be picked.
+ *
+ * @param[in]  loaded  The number of assets loaded so far.
+ * @param[in]  total   The number of assets being loaded.
+ */
+void TeamSelectWidget::setProgress( int loaded, int total )
+{
+    for( int i = 0; i < 30; i++ )
+        m_btnLogos[i]->setEnabled( false );
+
+    m_lbProgress->setText(
+        QString( "Loading %1 / %2" ).arg( loaded ).arg( total ) );
+    m_lbProgress->show();
+}
+
 /**
  * @brief      Overloaded resizeEvent function.
  * @details    Scales the logos based on the screen size.
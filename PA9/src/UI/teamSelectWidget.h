@@ -6,6 +6,7 @@
 #include <QGridLayout>
 #include <QPushButton>
 #include <QIcon>
+#include <QLabel>
 #include <QSignalMapper>
 
 class TeamSelectWidget    :   public QOpenGLWidget
@@ -25,10 +26,12 @@ signals:
 
 public slots:
     void setTeams( QString team );
+    void setProgress( int loaded, int total );
 
 private:
     QPushButton* m_btnLogos[30];
     QIcon* m_imgLogos[30];
+    QLabel* m_lbProgress;
 
     QGridLayout* m_layout;
     QSignalMapper* m_signalMapper;
@@ -6,13 +6,71 @@
  */
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include "Controls/benchmark.h"
+#include "Controls/physicsBenchmark.h"
 #include "UI/mainWindow.h"
 
 int main( int argc, char** argv )
 {
     QApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption physicsThreadOption( "physics-thread",
+        "Steps the physics on its own thread, alongside the drawing." );
+    parser.addOption( physicsThreadOption );
+    QCommandLineOption renderThreadOption( "render-thread",
+        "Draws the scene on its own thread, alongside the game." );
+    parser.addOption( renderThreadOption );
+    QCommandLineOption physicsThreadsOption( "physics-threads",
+        "Steps the physics with Bullet's multithreaded world on <threads> "
+        "threads, or 0 for every core. Only Bullet's loops are limited.",
+        "threads" );
+    parser.addOption( physicsThreadsOption );
+    QCommandLineOption stressOption( "stress",
+        "Drops <pucks> extra pucks on the table.", "pucks" );
+    parser.addOption( stressOption );
+    QCommandLineOption benchmarkOption( "benchmark",
+        "Runs <frames> frames without a window and prints their timings.",
+        "frames" );
+    parser.addOption( benchmarkOption );
+    QCommandLineOption physicsBenchmarkOption( "physics-benchmark",
+        "Steps <bodies> pucks without a window on 1 to every core and prints "
+        "their timings.", "bodies" );
+    parser.addOption( physicsBenchmarkOption );
+    QCommandLineOption stepsOption( "steps",
+        "Steps of each physics benchmark run.", "steps", "300" );
+    parser.addOption( stepsOption );
+    parser.process( app );
+
+    if( parser.isSet( physicsBenchmarkOption ) )
+    {
+        PhysicsBenchmark benchmark(
+            parser.value( physicsBenchmarkOption ).toInt(),
+            parser.value( stepsOption ).toInt() );
+        return benchmark.run();
+    }
+
+    OGLWidget::Settings settings;
+    settings.ThreadedPhysics = parser.isSet( physicsThreadOption );
+    settings.ThreadedRender = parser.isSet( renderThreadOption );
+    if( parser.isSet( physicsThreadsOption ) )
+    {
+        settings.PhysicsBackend = PhysicsWorld::Multithreaded;
+        settings.PhysicsThreads = parser.value( physicsThreadsOption ).toInt();
+    }
+    settings.StressPucks = parser.value( stressOption ).toInt();
+
+    if( parser.isSet( benchmarkOption ) )
+    {
+        Benchmark benchmark( parser.value( benchmarkOption ).toInt(),
+            settings.StressPucks, settings.PhysicsBackend,
+            settings.PhysicsThreads );
+        return benchmark.run();
+    }
     
-    MainWindow mainWindow;
+    MainWindow mainWindow( settings );
     mainWindow.resize( QSize( 800, 600 ) );
     mainWindow.setWindowTitle( "PA9 Air Hockey - Ben Nicholes, Denis Morozov, " 
         "Saharath Kleips" );